@@ -0,0 +1,21 @@
+//
+// Main.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "Main.hpp"
+#include "Application.hpp"
+
+constexpr uint8_t BoardImpl::kAddress;
+constexpr std::array<uint8_t, 1> BoardImpl::kRequest;
+constexpr std::array<uint8_t, 5> BoardImpl::kResponse;
+
+int main()
+{
+	BoardImpl::configure();
+	BoardImpl::I2c i2c {50'000};
+	Application<BoardImpl> app {i2c};
+	app.run();
+	return 0;
+}
@@ -0,0 +1,37 @@
+//
+// Main.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef BOARD_POSIX_MAIN_HPP_
+#define BOARD_POSIX_MAIN_HPP_
+
+#include "Board.hpp"
+#include "Version.hpp"
+
+#include <Platform/I2c.hpp>
+#include <Platform/Flash.hpp>
+#include <Platform/LocalTime.hpp>
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+struct BoardImpl : Board<Flash<CONFIG_ROM_PAGE>, Flash<CONFIG_ROM_PAGE>> {
+public:
+	using I2c = ::I2c<1>;
+	using Clock = ::LocalTime;
+	using Memory = ::Flash<CONFIG_ROM_PAGE>;
+
+	static constexpr uint8_t kAddress = 0x0B;
+	static constexpr std::array<uint8_t, 1> kRequest = {0x22};
+	static constexpr std::array<uint8_t, 5> kResponse = {0x04, 'L', 'I', 'O', 'N'};
+
+	static void configure() {
+		Clock::init();
+		Memory::init();
+	}
+};
+
+#endif // BOARD_POSIX_MAIN_HPP_
@@ -11,7 +11,7 @@
 #include <Platform/I2cIrq.hpp>
 #include <Platform/Gpio.hpp>
 #include <Platform/Flash.hpp>
-#include <Platform/LocalTime.hpp>
+#include <Platform/TimerClock.hpp>
 
 #include <chrono>
 
@@ -26,7 +26,7 @@ private:
 
 public:
 	using I2c = ::I2c<1>;
-	using Clock = ::LocalTime;
+	using Clock = ::TimerClock<2>;
 
 	static constexpr uint8_t kAddress = 0x0B;
 	static constexpr std::array<uint8_t, 1> kRequest = {0x22};
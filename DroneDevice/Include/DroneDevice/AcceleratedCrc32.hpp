@@ -0,0 +1,126 @@
+//
+// AcceleratedCrc32.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_ACCELERATEDCRC32_HPP_
+#define DRONEDEVICE_ACCELERATEDCRC32_HPP_
+
+#include <DroneDevice/FastCrc32.hpp>
+#include <cstddef>
+#include <cstdint>
+
+//!
+//! CRC32 calculated with a word-oriented calculation unit, results are identical to FastCrc32.
+//! Unaligned head and tail of the buffer and short buffers are processed by the table algorithm.
+//! \tparam Unit Calculation unit with reset(), state() and feed(words, count) methods.
+//! The unit should process words in the reflected bit order of the CRC32 and
+//! reset its state to the initial value of 0xFFFFFFFF.
+//! \tparam threshold Minimal length of the buffer to be processed by the unit.
+//!
+template<class Unit, size_t threshold = 16>
+class AcceleratedCrc32 {
+	static_assert(threshold >= sizeof(uint32_t), "Incorrect threshold");
+
+public:
+	using Type = uint32_t;
+	static constexpr size_t size{sizeof(uint32_t)};
+
+	AcceleratedCrc32() = delete;
+	AcceleratedCrc32(const AcceleratedCrc32 &) = delete;
+	AcceleratedCrc32 &operator=(const AcceleratedCrc32 &) = delete;
+
+	//!
+	//! Update checksum with buffer data.
+	//! \param checksum Previous checksum value.
+	//! \param buffer Pointer to buffer with at least @b length characters of data.
+	//! \param length Buffer length.
+	//! \return Updated checksum value.
+	//!
+	static uint32_t update(uint32_t aChecksum, const void *aBuffer, size_t aLength)
+	{
+		if (aLength < threshold) {
+			return FastCrc32::update(aChecksum, aBuffer, aLength);
+		}
+
+		const uint8_t *buffer = static_cast<const uint8_t *>(aBuffer);
+		const size_t head = (sizeof(uint32_t) - (reinterpret_cast<uintptr_t>(buffer) & 0x03)) & 0x03;
+
+		aChecksum = FastCrc32::update(aChecksum, buffer, head);
+		buffer += head;
+		aLength -= head;
+
+		const size_t words = aLength >> 2;
+
+		seed(~aChecksum);
+		Unit::feed(reinterpret_cast<const uint32_t *>(reinterpret_cast<uintptr_t>(buffer)), words);
+		aChecksum = ~Unit::state();
+
+		return FastCrc32::update(aChecksum, buffer + (words << 2), aLength & 0x03);
+	}
+
+private:
+	static constexpr uint32_t kPolynomial{0xEDB88320UL};
+	static constexpr uint32_t kInitialState{0xFFFFFFFFUL};
+
+	//!
+	//! Find the word which moves the state of the unit from the initial value to the required one.
+	//! \param state Required state.
+	//! \return Word to be processed after the reset.
+	//!
+	static uint32_t preimage(uint32_t aState)
+	{
+		// Run the shift register backwards, the polynomial sets the most significant bit
+		for (size_t bit = 0; bit < 32; ++bit) {
+			if (aState & 0x80000000UL) {
+				aState = static_cast<uint32_t>(((aState ^ kPolynomial) << 1) | 1);
+			} else {
+				aState = static_cast<uint32_t>(aState << 1);
+			}
+		}
+
+		return aState ^ kInitialState;
+	}
+
+	static void seed(uint32_t aState)
+	{
+		// Consecutive calls continue the calculation without restarting the unit
+		if (Unit::state() == aState) {
+			return;
+		}
+
+		Unit::reset();
+
+		if (aState != kInitialState) {
+			const uint32_t word = preimage(aState);
+			Unit::feed(&word, 1);
+		}
+	}
+};
+
+//!
+//! CRC32 which enables the calculation unit before the first checksum, used as PlatformCrc32.
+//! The unit keeps the state between calls, so checksums must not be calculated from interrupt handlers.
+//! \tparam Crc Implementation with init() and update() methods.
+//!
+template<class Crc>
+class AutoInitCrc32 {
+public:
+	using Type = uint32_t;
+	static constexpr size_t size{sizeof(uint32_t)};
+
+	AutoInitCrc32() = delete;
+	AutoInitCrc32(const AutoInitCrc32 &) = delete;
+	AutoInitCrc32 &operator=(const AutoInitCrc32 &) = delete;
+
+	static uint32_t update(uint32_t aChecksum, const void *aBuffer, size_t aLength)
+	{
+		static const bool enabled = (Crc::init(), true);
+		(void)enabled;
+
+		return Crc::update(aChecksum, aBuffer, aLength);
+	}
+};
+
+#endif // DRONEDEVICE_ACCELERATEDCRC32_HPP_
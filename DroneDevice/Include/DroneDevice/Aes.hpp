@@ -8,218 +8,455 @@
 #ifndef DRONEDEVICE_AES_HPP_
 #define DRONEDEVICE_AES_HPP_
 
-#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 
-class Aes {
+//!
+//! AES-128 block cipher with round keys expanded once during construction.
+//! Rounds are table-driven, the tables are generated at compile time and placed in read-only memory.
+//!
+class AesCipher {
+	struct Tables {
+		uint8_t sbox[256];
+		uint8_t sboxInv[256];
+		// Round tables for the first column, other columns are obtained by rotation
+		uint32_t te[256];
+		uint32_t td[256];
+
+		constexpr Tables() :
+			sbox{},
+			sboxInv{},
+			te{},
+			td{}
+		{
+			// Loop invariant: p * q == 1 in the Galois field
+			uint8_t p = 1;
+			uint8_t q = 1;
+
+			do {
+				// Multiply p by x + 1
+				p = static_cast<uint8_t>(p ^ (p << 1) ^ (p & 0x80 ? 0x1B : 0));
+				// Divide q by x + 1
+				q = static_cast<uint8_t>(q ^ (q << 1));
+				q = static_cast<uint8_t>(q ^ (q << 2));
+				q = static_cast<uint8_t>(q ^ (q << 4));
+				q = static_cast<uint8_t>(q ^ (q & 0x80 ? 0x09 : 0));
+				// Compute the affine transformation
+				sbox[p] = static_cast<uint8_t>(0x63 ^ q ^ rotl8(q, 1) ^ rotl8(q, 2) ^ rotl8(q, 3) ^ rotl8(q, 4));
+			} while (p != 1);
+
+			// 0 is a special case since it has no inverse
+			sbox[0] = 0x63;
+
+			for (size_t i = 0; i < 256; ++i) {
+				sboxInv[sbox[i]] = static_cast<uint8_t>(i);
+			}
+
+			for (size_t i = 0; i < 256; ++i) {
+				const uint8_t s = sbox[i];
+				const uint8_t r = sboxInv[i];
+
+				te[i] = static_cast<uint32_t>(mul(s, 2)) << 24 | static_cast<uint32_t>(s) << 16
+					| static_cast<uint32_t>(s) << 8 | mul(s, 3);
+				td[i] = static_cast<uint32_t>(mul(r, 14)) << 24 | static_cast<uint32_t>(mul(r, 9)) << 16
+					| static_cast<uint32_t>(mul(r, 13)) << 8 | mul(r, 11);
+			}
+		}
+
+		static constexpr uint8_t rotl8(uint8_t x, unsigned int shift)
+		{
+			return static_cast<uint8_t>((x << shift) | (x >> (8 - shift)));
+		}
+
+		static constexpr uint8_t mul(uint8_t a, uint8_t b)
+		{
+			uint8_t result = 0;
+
+			while (b) {
+				if (b & 0x01) {
+					result ^= a;
+				}
+
+				a = static_cast<uint8_t>((a << 1) ^ (a & 0x80 ? 0x1B : 0));
+				b = static_cast<uint8_t>(b >> 1);
+			}
+
+			return result;
+		}
+	};
+
 public:
-	// AES-128 CBC
 	static constexpr size_t kBlockSize{16};
+	static constexpr size_t kKeySize{16};
 
-	Aes(const char *aKey) :
-		// Suppress warnings, pointers will be rewritten during reset
-		prevBlockPtr{nullptr},
-		tempBlockPtr{nullptr}
+	//!
+	//! Construct the cipher from a key in hexadecimal notation.
+	//! \param key String with 32 hexadecimal digits.
+	//!
+	explicit AesCipher(const char *aKey)
 	{
-		initSBox(sbox);
-		initInvSBox(sboxInv, sbox);
-		loadKey(aKey);
-		reset();
+		assert(strlen(aKey) == kKeySize * 2);
+
+		uint8_t key[kKeySize];
+
+		for (size_t i = 0; i < kKeySize; ++i) {
+			key[i] = static_cast<uint8_t>((hexToBin(aKey[i * 2]) << 4) | hexToBin(aKey[i * 2 + 1]));
+		}
+
+		expandKey(key);
 	}
 
-	void reset()
+	//!
+	//! Construct the cipher from a binary key.
+	//! \param key Buffer with 16 bytes of the key.
+	//!
+	explicit AesCipher(const uint8_t *aKey)
 	{
-		memcpy(currentKey, cachedKey, kBlockSize);
-		memset(prevBlock, 0, kBlockSize);
-		memset(tempBlock, 0, kBlockSize);
-		prevBlockPtr = prevBlock;
-		tempBlockPtr = tempBlock;
+		expandKey(aKey);
 	}
 
-	void decrypt(void *aBlock)
+	//!
+	//! Encrypt a single block, input and output buffers may overlap.
+	//!
+	void encryptBlock(const uint8_t *aInput, uint8_t *aOutput) const
 	{
-		assert(aBlock != nullptr);
+		const Tables &t = tables();
+		const uint32_t *rk = encryptionKeys;
+
+		uint32_t s0 = load(aInput) ^ rk[0];
+		uint32_t s1 = load(aInput + 4) ^ rk[1];
+		uint32_t s2 = load(aInput + 8) ^ rk[2];
+		uint32_t s3 = load(aInput + 12) ^ rk[3];
+
+		for (size_t round = 1; round < kRounds; ++round) {
+			rk += 4;
+
+			const uint32_t t0 = t.te[s0 >> 24] ^ ror8(t.te[(s1 >> 16) & 0xFF])
+				^ ror16(t.te[(s2 >> 8) & 0xFF]) ^ ror24(t.te[s3 & 0xFF]) ^ rk[0];
+			const uint32_t t1 = t.te[s1 >> 24] ^ ror8(t.te[(s2 >> 16) & 0xFF])
+				^ ror16(t.te[(s3 >> 8) & 0xFF]) ^ ror24(t.te[s0 & 0xFF]) ^ rk[1];
+			const uint32_t t2 = t.te[s2 >> 24] ^ ror8(t.te[(s3 >> 16) & 0xFF])
+				^ ror16(t.te[(s0 >> 8) & 0xFF]) ^ ror24(t.te[s1 & 0xFF]) ^ rk[2];
+			const uint32_t t3 = t.te[s3 >> 24] ^ ror8(t.te[(s0 >> 16) & 0xFF])
+				^ ror16(t.te[(s1 >> 8) & 0xFF]) ^ ror24(t.te[s2 & 0xFF]) ^ rk[3];
+
+			s0 = t0;
+			s1 = t1;
+			s2 = t2;
+			s3 = t3;
+		}
 
-		uint8_t * const block = static_cast<uint8_t *>(aBlock);
+		// Last round has no column mixing
+		rk += 4;
+		store(aOutput, substitute(t.sbox, s0, s1, s2, s3) ^ rk[0]);
+		store(aOutput + 4, substitute(t.sbox, s1, s2, s3, s0) ^ rk[1]);
+		store(aOutput + 8, substitute(t.sbox, s2, s3, s0, s1) ^ rk[2]);
+		store(aOutput + 12, substitute(t.sbox, s3, s0, s1, s2) ^ rk[3]);
+	}
 
-		memcpy(tempBlockPtr, block, kBlockSize);
-		decryptBlock(block, currentKey);
+	//!
+	//! Decrypt a single block, input and output buffers may overlap.
+	//!
+	void decryptBlock(const uint8_t *aInput, uint8_t *aOutput) const
+	{
+		const Tables &t = tables();
+		const uint32_t *rk = decryptionKeys;
+
+		uint32_t s0 = load(aInput) ^ rk[0];
+		uint32_t s1 = load(aInput + 4) ^ rk[1];
+		uint32_t s2 = load(aInput + 8) ^ rk[2];
+		uint32_t s3 = load(aInput + 12) ^ rk[3];
+
+		for (size_t round = 1; round < kRounds; ++round) {
+			rk += 4;
+
+			const uint32_t t0 = t.td[s0 >> 24] ^ ror8(t.td[(s3 >> 16) & 0xFF])
+				^ ror16(t.td[(s2 >> 8) & 0xFF]) ^ ror24(t.td[s1 & 0xFF]) ^ rk[0];
+			const uint32_t t1 = t.td[s1 >> 24] ^ ror8(t.td[(s0 >> 16) & 0xFF])
+				^ ror16(t.td[(s3 >> 8) & 0xFF]) ^ ror24(t.td[s2 & 0xFF]) ^ rk[1];
+			const uint32_t t2 = t.td[s2 >> 24] ^ ror8(t.td[(s1 >> 16) & 0xFF])
+				^ ror16(t.td[(s0 >> 8) & 0xFF]) ^ ror24(t.td[s3 & 0xFF]) ^ rk[2];
+			const uint32_t t3 = t.td[s3 >> 24] ^ ror8(t.td[(s2 >> 16) & 0xFF])
+				^ ror16(t.td[(s1 >> 8) & 0xFF]) ^ ror24(t.td[s0 & 0xFF]) ^ rk[3];
+
+			s0 = t0;
+			s1 = t1;
+			s2 = t2;
+			s3 = t3;
+		}
+
+		rk += 4;
+		store(aOutput, substitute(t.sboxInv, s0, s3, s2, s1) ^ rk[0]);
+		store(aOutput + 4, substitute(t.sboxInv, s1, s0, s3, s2) ^ rk[1]);
+		store(aOutput + 8, substitute(t.sboxInv, s2, s1, s0, s3) ^ rk[2]);
+		store(aOutput + 12, substitute(t.sboxInv, s3, s2, s1, s0) ^ rk[3]);
+	}
 
+protected:
+	static void xorBlock(uint8_t *aOutput, const uint8_t *aInput, const uint8_t *aMask)
+	{
 		for (size_t i = 0; i < kBlockSize; ++i) {
-			block[i] ^= prevBlockPtr[i];
+			aOutput[i] = aInput[i] ^ aMask[i];
 		}
-
-		std::swap(tempBlockPtr, prevBlockPtr);
 	}
 
 private:
-	static constexpr size_t kBoxSize{256};
 	static constexpr size_t kRounds{10};
+	static constexpr size_t kRoundKeys{(kRounds + 1) * 4};
 
-	uint8_t cachedKey[kBlockSize];
-	uint8_t currentKey[kBlockSize];
-	uint8_t sbox[kBoxSize];
-	uint8_t sboxInv[kBoxSize];
+	uint32_t encryptionKeys[kRoundKeys];
+	uint32_t decryptionKeys[kRoundKeys];
 
-	uint8_t prevBlock[kBlockSize];
-	uint8_t tempBlock[kBlockSize];
-	uint8_t *prevBlockPtr;
-	uint8_t *tempBlockPtr;
+	static const Tables &tables()
+	{
+		static constexpr Tables instance{};
+		return instance;
+	}
 
-	void decryptBlock(uint8_t *aBlock, uint8_t *aKey)
+	void expandKey(const uint8_t *aKey)
 	{
 		static const uint8_t roundConstants[] = {
 				0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
 		};
 
-		uint8_t buf1, buf2, buf3, buf4;
-		size_t round, i;
+		const Tables &t = tables();
 
-		// Compute the last key of encryption before starting the decryption
-		for (round = 0; round < kRounds; ++round) {
-			// Key schedule
-			aKey[0] = sbox[aKey[13]] ^ aKey[0] ^ roundConstants[round];
-			aKey[1] = sbox[aKey[14]] ^ aKey[1];
-			aKey[2] = sbox[aKey[15]] ^ aKey[2];
-			aKey[3] = sbox[aKey[12]] ^ aKey[3];
+		for (size_t i = 0; i < 4; ++i) {
+			encryptionKeys[i] = load(aKey + i * 4);
+		}
+
+		for (size_t i = 4; i < kRoundKeys; ++i) {
+			uint32_t temp = encryptionKeys[i - 1];
 
-			for (i = 4; i < kBlockSize; ++i) {
-				aKey[i] = aKey[i] ^ aKey[i - 4];
+			if (i % 4 == 0) {
+				temp = substitute(t.sbox, temp << 8 | temp >> 24) ^ static_cast<uint32_t>(roundConstants[i / 4 - 1]) << 24;
 			}
-		}
 
-		// First add round key
-		for (i = 0; i < kBlockSize; ++i){
-			aBlock[i] = aBlock[i] ^ aKey[i];
+			encryptionKeys[i] = encryptionKeys[i - 4] ^ temp;
 		}
 
-		// Main loop
-		for (round = 0; round < kRounds; ++round){
-			// Inverse key schedule
-			for (i = 15; i > 3; --i) {
-				aKey[i] = aKey[i] ^ aKey[i - 4];
-			}
+		// Equivalent inverse cipher: reversed round keys with inverse column mixing applied
+		for (size_t round = 0; round <= kRounds; ++round) {
+			for (size_t i = 0; i < 4; ++i) {
+				const uint32_t key = encryptionKeys[(kRounds - round) * 4 + i];
 
-			aKey[0] = sbox[aKey[13]] ^ aKey[0] ^ roundConstants[9 - round];
-			aKey[1] = sbox[aKey[14]] ^ aKey[1];
-			aKey[2] = sbox[aKey[15]] ^ aKey[2];
-			aKey[3] = sbox[aKey[12]] ^ aKey[3];
-
-			// Mixcol - inv mix
-			if (round > 0) {
-				for (i = 0; i < 4; ++i) {
-					buf4 = static_cast<uint8_t>(i << 2);
-					// Precompute for decryption
-					buf1 = galoisMul2(galoisMul2(aBlock[buf4] ^ aBlock[buf4 + 2]));
-					buf2 = galoisMul2(galoisMul2(aBlock[buf4 + 1] ^ aBlock[buf4 + 3]));
-					aBlock[buf4] ^= buf1;
-					aBlock[buf4 + 1] ^= buf2;
-					aBlock[buf4 + 2] ^= buf1;
-					aBlock[buf4 + 3] ^= buf2;
-
-					buf1 = aBlock[buf4] ^ aBlock[buf4 + 1] ^ aBlock[buf4 + 2] ^ aBlock[buf4 + 3];
-					buf2 = aBlock[buf4];
-					buf3 = aBlock[buf4] ^ aBlock[buf4 + 1];
-					buf3 = galoisMul2(buf3);
-					aBlock[buf4] = aBlock[buf4] ^ buf3 ^ buf1;
-					buf3 = aBlock[buf4 + 1] ^ aBlock[buf4 + 2];
-					buf3 = galoisMul2(buf3);
-					aBlock[buf4 + 1] = aBlock[buf4 + 1] ^ buf3 ^ buf1;
-					buf3 = aBlock[buf4 + 2] ^ aBlock[buf4 + 3];
-					buf3 = galoisMul2(buf3);
-					aBlock[buf4 + 2] = aBlock[buf4 + 2] ^ buf3 ^ buf1;
-					buf3 = aBlock[buf4 + 3] ^ buf2;
-					buf3 = galoisMul2(buf3);
-					aBlock[buf4 + 3] = aBlock[buf4 + 3] ^ buf3 ^ buf1;
+				if (round == 0 || round == kRounds) {
+					decryptionKeys[round * 4 + i] = key;
+				} else {
+					decryptionKeys[round * 4 + i] = t.td[t.sbox[key >> 24]] ^ ror8(t.td[t.sbox[(key >> 16) & 0xFF]])
+						^ ror16(t.td[t.sbox[(key >> 8) & 0xFF]]) ^ ror24(t.td[t.sbox[key & 0xFF]]);
 				}
 			}
-
-			// Inv shift rows
-
-			// Row 1
-			buf1   = aBlock[13];
-			aBlock[13] = aBlock[9];
-			aBlock[9]  = aBlock[5];
-			aBlock[5]  = aBlock[1];
-			aBlock[1]  = buf1;
-			// Row 2
-			buf1   = aBlock[10];
-			buf2   = aBlock[14];
-			aBlock[10] = aBlock[2];
-			aBlock[14] = aBlock[6];
-			aBlock[2]  = buf1;
-			aBlock[6]  = buf2;
-			// Row 3
-			buf1   = aBlock[3];
-			aBlock[3]  = aBlock[7];
-			aBlock[7]  = aBlock[11];
-			aBlock[11] = aBlock[15];
-			aBlock[15] = buf1;
-
-			for (i = 0; i < kBlockSize; ++i) {
-				// With shift row i + 5 mod 16
-				aBlock[i] = sboxInv[aBlock[i]] ^ aKey[i];
-			}
 		}
 	}
 
-	void loadKey(const char *aKey)
+	static uint32_t substitute(const uint8_t *aBox, uint32_t aValue)
 	{
-		assert(strlen(aKey) == kBlockSize * 2);
+		return substitute(aBox, aValue, aValue, aValue, aValue);
+	}
 
-		for (size_t i = 0; i < kBlockSize; ++i) {
-			cachedKey[i] = static_cast<uint8_t>((hexToBin(aKey[i * 2]) << 4) | hexToBin(aKey[i * 2 + 1]));
-		}
+	static uint32_t substitute(const uint8_t *aBox, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3)
+	{
+		return static_cast<uint32_t>(aBox[a0 >> 24]) << 24 | static_cast<uint32_t>(aBox[(a1 >> 16) & 0xFF]) << 16
+			| static_cast<uint32_t>(aBox[(a2 >> 8) & 0xFF]) << 8 | aBox[a3 & 0xFF];
 	}
 
-	static uint8_t galoisMul2(uint8_t value)
+	static uint32_t load(const uint8_t *aBuffer)
 	{
-		const int temp = static_cast<int>(static_cast<int8_t>(value));
-		return static_cast<uint8_t>((value << 1) ^ ((temp >> 7) & 0x1B));
+		return static_cast<uint32_t>(aBuffer[0]) << 24 | static_cast<uint32_t>(aBuffer[1]) << 16
+			| static_cast<uint32_t>(aBuffer[2]) << 8 | static_cast<uint32_t>(aBuffer[3]);
+	}
+
+	static void store(uint8_t *aBuffer, uint32_t aValue)
+	{
+		aBuffer[0] = static_cast<uint8_t>(aValue >> 24);
+		aBuffer[1] = static_cast<uint8_t>(aValue >> 16);
+		aBuffer[2] = static_cast<uint8_t>(aValue >> 8);
+		aBuffer[3] = static_cast<uint8_t>(aValue);
+	}
+
+	static uint32_t ror8(uint32_t x)
+	{
+		return (x >> 8) | (x << 24);
+	}
+
+	static uint32_t ror16(uint32_t x)
+	{
+		return (x >> 16) | (x << 16);
+	}
+
+	static uint32_t ror24(uint32_t x)
+	{
+		return (x >> 24) | (x << 8);
 	}
 
 	static uint8_t hexToBin(char c)
 	{
 		if (c >= 'A' && c <= 'F') {
 			return static_cast<uint8_t>(c - 'A' + 10);
+		} else if (c >= 'a' && c <= 'f') {
+			return static_cast<uint8_t>(c - 'a' + 10);
 		} else {
 			return static_cast<uint8_t>(c - '0');
 		}
 	}
+};
+
+//!
+//! AES-128 in CBC mode. Default initialization vector is zero.
+//!
+class Aes : public AesCipher {
+public:
+	explicit Aes(const char *aKey) :
+		AesCipher{aKey}
+	{
+		reset();
+	}
+
+	explicit Aes(const uint8_t *aKey) :
+		AesCipher{aKey}
+	{
+		reset();
+	}
+
+	void reset()
+	{
+		memset(chain, 0, kBlockSize);
+	}
+
+	void reset(const void *aIv)
+	{
+		memcpy(chain, aIv, kBlockSize);
+	}
+
+	void decrypt(void *aBlock)
+	{
+		decrypt(aBlock, kBlockSize);
+	}
+
+	//!
+	//! Decrypt buffer in place, the chaining state is preserved between calls.
+	//! \param buffer Buffer with encrypted data.
+	//! \param length Buffer length, should be a multiple of the block size.
+	//!
+	void decrypt(void *aBuffer, size_t aLength)
+	{
+		assert(aBuffer != nullptr);
+		assert(aLength % kBlockSize == 0);
+
+		uint8_t *block = static_cast<uint8_t *>(aBuffer);
+		uint8_t ciphertext[kBlockSize];
+
+		for (; aLength; aLength -= kBlockSize, block += kBlockSize) {
+			memcpy(ciphertext, block, kBlockSize);
+			decryptBlock(block, block);
+			xorBlock(block, block, chain);
+			memcpy(chain, ciphertext, kBlockSize);
+		}
+	}
+
+	void encrypt(void *aBlock)
+	{
+		encrypt(aBlock, kBlockSize);
+	}
+
+	//!
+	//! Encrypt buffer in place, the chaining state is preserved between calls.
+	//! \param buffer Buffer with plain data.
+	//! \param length Buffer length, should be a multiple of the block size.
+	//!
+	void encrypt(void *aBuffer, size_t aLength)
+	{
+		assert(aBuffer != nullptr);
+		assert(aLength % kBlockSize == 0);
+
+		uint8_t *block = static_cast<uint8_t *>(aBuffer);
+
+		for (; aLength; aLength -= kBlockSize, block += kBlockSize) {
+			xorBlock(block, block, chain);
+			encryptBlock(block, block);
+			memcpy(chain, block, kBlockSize);
+		}
+	}
+
+private:
+	uint8_t chain[kBlockSize];
+};
 
-	static void initSBox(uint8_t *sbox)
+//!
+//! AES-128 in CTR mode with a 128-bit big-endian counter. Encryption and decryption are
+//! the same operation, data may be processed in chunks of arbitrary length.
+//!
+class AesCtr : public AesCipher {
+public:
+	AesCtr(const char *aKey, const void *aCounter) :
+		AesCipher{aKey}
 	{
-		// Loop invariant: p * q == 1 in the Galois field
-		uint8_t p = 1, q = 1;
+		reset(aCounter);
+	}
 
-		do {
-			// Multiply p by x + 1
-			p = static_cast<uint8_t>(p ^ (p << 1) ^ (p & 0x80 ? 0x1B : 0));
-			// Divide q by x + 1
-			q = static_cast<uint8_t>(q ^ (q << 1));
-			q = static_cast<uint8_t>(q ^ (q << 2));
-			q = static_cast<uint8_t>(q ^ (q << 4));
-			q = static_cast<uint8_t>(q ^ (q & 0x80 ? 0x09 : 0));
-			// Compute the affine transformation
-			sbox[p] = 0x63 ^ q ^ ROTL8(q, 1) ^ ROTL8(q, 2) ^ ROTL8(q, 3) ^ ROTL8(q, 4);
-		} while (p != 1);
+	AesCtr(const uint8_t *aKey, const void *aCounter) :
+		AesCipher{aKey}
+	{
+		reset(aCounter);
+	}
 
-		// 0 is a special case since it has no inverse
-		sbox[0] = 0x63;
+	void reset(const void *aCounter)
+	{
+		memcpy(counter, aCounter, kBlockSize);
+		position = kBlockSize;
 	}
 
-	static void initInvSBox(uint8_t *sboxInv, const uint8_t *sbox)
+	//!
+	//! Encrypt or decrypt buffer in place.
+	//! \param buffer Buffer with data.
+	//! \param length Buffer length.
+	//!
+	void process(void *aBuffer, size_t aLength)
 	{
-		for (size_t i = 0; i < kBoxSize; ++i)
-			sboxInv[sbox[i]] = static_cast<uint8_t>(i);
+		assert(aBuffer != nullptr || !aLength);
+
+		uint8_t *buffer = static_cast<uint8_t *>(aBuffer);
+
+		// Use the rest of the key stream from the previous call
+		while (aLength && position < kBlockSize) {
+			*buffer++ ^= stream[position++];
+			--aLength;
+		}
+
+		while (aLength >= kBlockSize) {
+			next();
+			xorBlock(buffer, buffer, stream);
+			buffer += kBlockSize;
+			aLength -= kBlockSize;
+		}
+
+		if (aLength) {
+			next();
+			position = 0;
+
+			while (aLength--) {
+				*buffer++ ^= stream[position++];
+			}
+		}
 	}
 
-	static inline uint8_t ROTL8(uint8_t x, unsigned int shift)
+private:
+	uint8_t counter[kBlockSize];
+	uint8_t stream[kBlockSize];
+	size_t position;
+
+	void next()
 	{
-		return static_cast<uint8_t>((x << shift) | (x >> (8 - shift)));
+		encryptBlock(counter, stream);
+
+		for (size_t i = kBlockSize; i > 0; --i) {
+			if (++counter[i - 1]) {
+				break;
+			}
+		}
 	}
 };
 
@@ -8,14 +8,24 @@
 #ifndef DRONEDEVICE_CONFIGSTORAGE_HPP_
 #define DRONEDEVICE_CONFIGSTORAGE_HPP_
 
+#include <DroneDevice/PlatformCrc32.hpp>
 #include <DroneDevice/TypeHash.hpp>
+#include <DroneDevice/TypeHelpers.hpp>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #include <tuple>
+#include <utility>
 
 template<size_t index, size_t offset, typename Flash, typename Crc, typename Layout, typename... Ts>
 class ConfigRwHandler {
 public:
+	static constexpr size_t end()
+	{
+		return offset;
+	}
+
 	static bool load(Layout &)
 	{
 		return true;
@@ -94,6 +104,11 @@ class ConfigRwHandler<index, offset, Flash, Crc, Layout, T, Ts...> {
 	static_assert(sizeof(CrcType) == sizeof(TypeHash::Type), "Incorrect CRC type");
 
 public:
+	static constexpr size_t end()
+	{
+		return ConfigRwHandler<index + 1, kNextOffset, Flash, Crc, Layout, Ts...>::end();
+	}
+
 	static bool load(Layout &values)
 	{
 		static const auto typeHash = kTypeHash;
@@ -136,8 +151,102 @@ public:
 	}
 };
 
+//!
+//! RAM image of the config memory, used to program the memory asynchronously.
+//! Image is shared by all storages of the same type.
+//!
+template<typename Owner, size_t size>
+class ConfigImage {
+public:
+	ConfigImage() = delete;
+	ConfigImage(const ConfigImage &) = delete;
+	ConfigImage &operator=(const ConfigImage &) = delete;
+
+	static bool acquire()
+	{
+		if (busy()) {
+			return false;
+		} else {
+			busy() = true;
+			return true;
+		}
+	}
+
+	static bool write(uintptr_t aOffset, const void *aBuffer, size_t aLength)
+	{
+		if (aOffset + aLength <= size) {
+			memcpy(data() + aOffset, aBuffer, aLength);
+			return true;
+		} else {
+			return false;
+		}
+	}
+
+	//!
+	//! Erase the memory and program the image using an asynchronous engine.
+	//! \param engine Engine with erase(address, length, callback) and write(address, buffer, length, callback).
+	//! \param callback Completion callback.
+	//! \return False when the request was not queued.
+	//!
+	template<typename Flash, typename Engine>
+	static bool commit(Engine &aEngine, typename Engine::Callback aCallback)
+	{
+		// Callbacks of the engine only refer to static state, so they fit into non-allocating wrappers
+		completion<Engine>() = std::move(aCallback);
+
+		auto onErased = [&aEngine](bool aStatus) {
+			if (!aStatus || !aEngine.write(Flash::address(), data(), size, finish<Engine>)) {
+				finish<Engine>(false);
+			}
+		};
+
+		if (!Flash::isWritable() || !aEngine.erase(Flash::address(), Flash::capacity(), onErased)) {
+			completion<Engine>() = nullptr;
+			busy() = false;
+			return false;
+		}
+
+		return true;
+	}
+
+private:
+	static uint8_t *data()
+	{
+		alignas(uint32_t) static uint8_t image[size];
+		return image;
+	}
+
+	static volatile bool &busy()
+	{
+		static volatile bool pending{false};
+		return pending;
+	}
+
+	template<typename Engine>
+	static typename Engine::Callback &completion()
+	{
+		static typename Engine::Callback callback{};
+		return callback;
+	}
+
+	template<typename Engine>
+	static void finish(bool aResult)
+	{
+		const typename Engine::Callback callback{std::move(completion<Engine>())};
+
+		busy() = false;
+
+		if (callback != nullptr) {
+			callback(aResult);
+		}
+	}
+};
+
 template<typename Flash, typename Crc, typename... Ts>
 class ConfigStorage {
+	using Handler = ConfigRwHandler<0, 0, Flash, Crc, std::tuple<Ts...>, Ts...>;
+	using Image = ConfigImage<ConfigStorage, Handler::end()>;
+
 public:
 	ConfigStorage(bool aLoadData = false)
 	{
@@ -148,7 +257,7 @@ public:
 
 	bool load()
 	{
-		return ConfigRwHandler<0, 0, Flash, Crc, std::tuple<Ts...>, Ts...>::load(shadow);
+		return Handler::load(shadow);
 	}
 
 	bool store()
@@ -157,13 +266,30 @@ public:
 
 		Flash::unlock();
 		if ((status = Flash::erase())) {
-			status = ConfigRwHandler<0, 0, Flash, Crc, std::tuple<Ts...>, Ts...>::store(shadow);
+			status = Handler::store(shadow);
 		}
 		Flash::lock();
 
 		return status;
 	}
 
+	//!
+	//! Store the snapshot of current values without blocking.
+	//! \param engine Asynchronous erase and program engine.
+	//! \param callback Completion callback.
+	//! \return False when the previous request is still pending or the request was not queued.
+	//!
+	template<typename Engine>
+	bool store(Engine &aEngine, typename Engine::Callback aCallback = nullptr)
+	{
+		if (!Image::acquire()) {
+			return false;
+		}
+
+		ConfigRwHandler<0, 0, Image, Crc, std::tuple<Ts...>, Ts...>::store(shadow);
+		return Image::template commit<Flash>(aEngine, aCallback);
+	}
+
 	// TODO Make private
 	std::tuple<Ts...> shadow;
 };
@@ -174,4 +300,323 @@ T &getStorageEntry(Storage &storage)
 	return std::get<T>(storage.shadow);
 }
 
+//!
+//! Record of the keyed layout: header with type hash and payload length,
+//! aligned payload and checksum of both header and payload.
+//!
+template<typename Flash, typename Crc>
+class KeyedConfigRecord {
+public:
+	using CrcType = decltype(Crc::update(0, nullptr, 0));
+
+	struct Header {
+		TypeHash::Type key;
+		uint32_t length;
+	};
+
+	static constexpr TypeHash::Type kEmptyKey = std::numeric_limits<TypeHash::Type>::max();
+
+	static_assert(sizeof(Header) % sizeof(CrcType) == 0, "Incorrect header size");
+
+	template<typename T>
+	using WrapperType = ConfigWrapper<T, sizeof(CrcType)>;
+
+	template<typename T>
+	static constexpr size_t recordSize()
+	{
+		return sizeof(Header) + sizeof(WrapperType<T>) + sizeof(CrcType);
+	}
+
+	//!
+	//! Read the header of the record.
+	//! \param position Record position.
+	//! \param header Header of the record.
+	//! \return True when the header belongs to a programmed record which fits into the memory region.
+	//!
+	static bool header(uintptr_t position, Header &header)
+	{
+		static constexpr size_t kOverhead = sizeof(Header) + sizeof(CrcType);
+
+		if (position > Flash::capacity() || Flash::capacity() - position < kOverhead)
+			return false;
+		if (!Flash::read(position, &header, sizeof(header)) || header.key == kEmptyKey)
+			return false;
+
+		// Damaged length must not move reads of the payload and the checksum beyond the region
+		return header.length <= Flash::capacity() - position - kOverhead;
+	}
+
+	//!
+	//! Calculate position of the following record.
+	//! \param position Record position.
+	//! \param header Header of the record.
+	//! \param next Position of the following record.
+	//! \return False when the header is damaged.
+	//!
+	static bool next(uintptr_t position, const Header &header, uintptr_t &next)
+	{
+		if (header.length % sizeof(CrcType) != 0)
+			return false;
+
+		next = position + sizeof(Header) + header.length + sizeof(CrcType);
+		return next > position;
+	}
+
+	template<typename T>
+	static bool load(uintptr_t position, const Header &header, T &value)
+	{
+		CrcType expectedChecksum;
+		WrapperType<T> valueBuffer;
+
+		if (header.key != TypeHash::hash<T>() || header.length != sizeof(valueBuffer))
+			return false;
+
+		if (!Flash::read(position + sizeof(header), &valueBuffer, sizeof(valueBuffer)))
+			return false;
+		if (!Flash::read(position + sizeof(header) + sizeof(valueBuffer), &expectedChecksum, sizeof(expectedChecksum)))
+			return false;
+
+		CrcType actualChecksum;
+		actualChecksum = Crc::update(0, &header, sizeof(header));
+		actualChecksum = Crc::update(actualChecksum, &valueBuffer, sizeof(valueBuffer));
+
+		if (expectedChecksum != std::numeric_limits<CrcType>::max() && actualChecksum == expectedChecksum) {
+			value = valueBuffer;
+			return true;
+		} else {
+			return false;
+		}
+	}
+
+	template<typename T>
+	static bool store(uintptr_t position, const T &value)
+	{
+		const Header header{TypeHash::hash<T>(), static_cast<uint32_t>(sizeof(WrapperType<T>))};
+		const WrapperType<T> valueBuffer{value};
+		CrcType checksum;
+
+		checksum = Crc::update(0, &header, sizeof(header));
+		checksum = Crc::update(checksum, &valueBuffer, sizeof(valueBuffer));
+
+		if (!Flash::write(position, &header, sizeof(header)))
+			return false;
+		if (!Flash::write(position + sizeof(header), &valueBuffer, sizeof(valueBuffer)))
+			return false;
+
+		return Flash::write(position + sizeof(header) + sizeof(valueBuffer), &checksum, sizeof(checksum));
+	}
+};
+
+template<size_t index, typename Flash, typename Crc, typename Layout, typename... Ts>
+class KeyedConfigRwHandler {
+public:
+	static constexpr size_t size()
+	{
+		return 0;
+	}
+
+	static bool load(Layout &, uint32_t &, uint32_t &, uintptr_t, const typename KeyedConfigRecord<Flash, Crc>::Header &)
+	{
+		return false;
+	}
+
+	static bool store(const Layout &, uintptr_t)
+	{
+		return true;
+	}
+};
+
+template<size_t index, typename Flash, typename Crc, typename Layout, typename T, typename... Ts>
+class KeyedConfigRwHandler<index, Flash, Crc, Layout, T, Ts...> {
+	using Record = KeyedConfigRecord<Flash, Crc>;
+	using Next = KeyedConfigRwHandler<index + 1, Flash, Crc, Layout, Ts...>;
+
+	static constexpr uint32_t kMask = 1UL << index;
+
+public:
+	static constexpr size_t size()
+	{
+		return Record::template recordSize<T>() + Next::size();
+	}
+
+	//!
+	//! Load the record into the matching unresolved entry of the layout.
+	//! \return True when the record was accepted.
+	//!
+	static bool load(Layout &values, uint32_t &resolved, uint32_t &restored, uintptr_t position,
+		const typename Record::Header &header)
+	{
+		if (header.key != TypeHash::hash<T>())
+			return Next::load(values, resolved, restored, position, header);
+		if (resolved & kMask)
+			return false;
+
+		if (Record::load(position, header, std::get<T>(values))) {
+			resolved |= kMask;
+			restored |= kMask;
+			return true;
+		} else {
+			return false;
+		}
+	}
+
+	static bool store(const Layout &values, uintptr_t position)
+	{
+		if (!Record::store(position, std::get<T>(values)))
+			return false;
+
+		return Next::store(values, position + Record::template recordSize<T>());
+	}
+};
+
+//!
+//! Config storage with keyed layout. Each entry is located by the hash of its type,
+//! so entries are restored independently of each other and of the layout order.
+//! Entries are loaded either on first access or in bulk with load().
+//!
+template<typename Flash, typename Crc, typename... Ts>
+class KeyedConfigStorage {
+	using Layout = std::tuple<Ts...>;
+	using Record = KeyedConfigRecord<Flash, Crc>;
+	using Handler = KeyedConfigRwHandler<0, Flash, Crc, Layout, Ts...>;
+	using Image = ConfigImage<KeyedConfigStorage, Handler::size()>;
+
+	static_assert(sizeof...(Ts) <= 32, "Too many entries");
+
+	static constexpr uint32_t kAllEntries = sizeof...(Ts) < 32 ? (1UL << sizeof...(Ts)) - 1 : 0xFFFFFFFFUL;
+
+public:
+	KeyedConfigStorage(bool aLoadData = false) :
+		shadow{},
+		resolved{0},
+		restored{0}
+	{
+		if (aLoadData) {
+			load();
+		}
+	}
+
+	//!
+	//! Load all entries in a single pass over the memory.
+	//! \return True when all entries were restored from the memory.
+	//!
+	bool load()
+	{
+		resolved = 0;
+		restored = 0;
+		return resolve();
+	}
+
+	//!
+	//! Load entries that were not accessed yet and keep already loaded ones.
+	//! \return True when all entries were restored from the memory.
+	//!
+	bool resolve()
+	{
+		typename Record::Header header;
+		uintptr_t position = 0;
+
+		while (resolved != kAllEntries && Record::header(position, header)) {
+			Handler::load(shadow, resolved, restored, position, header);
+
+			if (!Record::next(position, header, position))
+				break;
+		}
+
+		resolved = kAllEntries;
+		return restored == kAllEntries;
+	}
+
+	bool store()
+	{
+		bool status;
+
+		// Entries which were never accessed must be preserved
+		resolve();
+
+		Flash::unlock();
+		if ((status = Flash::erase())) {
+			status = Handler::store(shadow, 0);
+		}
+		Flash::lock();
+
+		return status;
+	}
+
+	//!
+	//! Store the snapshot of current values without blocking.
+	//! \param engine Asynchronous erase and program engine.
+	//! \param callback Completion callback.
+	//! \return False when the previous request is still pending or the request was not queued.
+	//!
+	template<typename Engine>
+	bool store(Engine &aEngine, typename Engine::Callback aCallback = nullptr)
+	{
+		if (!Image::acquire()) {
+			return false;
+		}
+
+		resolve();
+		KeyedConfigRwHandler<0, Image, Crc, Layout, Ts...>::store(shadow, 0);
+		return Image::template commit<Flash>(aEngine, aCallback);
+	}
+
+	template<typename T>
+	T &entry()
+	{
+		static constexpr uint32_t kMask = 1UL << TypeHelpers::IndexOf<T, Ts...>::value;
+
+		if (!(resolved & kMask)) {
+			typename Record::Header header;
+			uintptr_t position = 0;
+
+			while (Record::header(position, header)) {
+				if (header.key == TypeHash::hash<T>()) {
+					if (Record::load(position, header, std::get<T>(shadow)))
+						restored |= kMask;
+					break;
+				}
+
+				if (!Record::next(position, header, position))
+					break;
+			}
+
+			resolved |= kMask;
+		}
+
+		return std::get<T>(shadow);
+	}
+
+	//!
+	//! Check whether the entry was restored from the memory.
+	//! \return True when the entry contains stored value, false when default value is used.
+	//!
+	template<typename T>
+	bool isRestored()
+	{
+		entry<T>();
+		return (restored & (1UL << TypeHelpers::IndexOf<T, Ts...>::value)) != 0;
+	}
+
+private:
+	Layout shadow;
+	uint32_t resolved;
+	uint32_t restored;
+};
+
+template<typename T, typename Flash, typename Crc, typename... Ts>
+T &getStorageEntry(KeyedConfigStorage<Flash, Crc, Ts...> &storage)
+{
+	return storage.template entry<T>();
+}
+
+//!
+//! Config storages protected with the default CRC32 of the platform.
+//!
+template<typename Flash, typename... Ts>
+using PlatformConfigStorage = ConfigStorage<Flash, PlatformCrc32, Ts...>;
+
+template<typename Flash, typename... Ts>
+using PlatformKeyedConfigStorage = KeyedConfigStorage<Flash, PlatformCrc32, Ts...>;
+
 #endif // DRONEDEVICE_CONFIGSTORAGE_HPP_
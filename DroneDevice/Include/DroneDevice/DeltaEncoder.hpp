@@ -0,0 +1,209 @@
+//
+// DeltaEncoder.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_DELTAENCODER_HPP_
+#define DRONEDEVICE_DELTAENCODER_HPP_
+
+#include <DroneDevice/DeltaPatcher.hpp>
+#include <DroneDevice/FastCrc32.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+//!
+//! Generator of patches for DeltaPatcher, intended for host tools and tests.
+//! Like bsdiff, it follows the source image through approximate matches, so code which is only
+//! shifted by an insertion produces Add instructions with sparse differences instead of literals.
+//! \tparam Crc CRC32 implementation used for the header.
+//!
+template<typename Crc = FastCrc32>
+class DeltaEncoder {
+	static constexpr size_t kBlock{8};
+	static constexpr size_t kMinCopy{4};
+
+public:
+	DeltaEncoder() = delete;
+	DeltaEncoder(const DeltaEncoder &) = delete;
+	DeltaEncoder &operator=(const DeltaEncoder &) = delete;
+
+	//!
+	//! Create a patch transforming the source image into the target image.
+	//! \return Patch with the header.
+	//!
+	static std::vector<uint8_t> diff(const std::vector<uint8_t> &aSource, const std::vector<uint8_t> &aTarget)
+	{
+		std::vector<uint8_t> patch(sizeof(DeltaHeader));
+		std::unordered_map<uint64_t, size_t> index;
+
+		DeltaHeader header;
+		memset(&header, 0, sizeof(header));
+		header.magic = DeltaHeader::kMagic;
+		header.sourceSize = static_cast<uint32_t>(aSource.size());
+		header.sourceCrc = Crc::update(0, aSource.data(), aSource.size());
+		header.targetSize = static_cast<uint32_t>(aTarget.size());
+		header.targetCrc = Crc::update(0, aTarget.data(), aTarget.size());
+		memcpy(patch.data(), &header, sizeof(header));
+
+		// First occurrence of each block of the source image
+		for (size_t position = 0; position + kBlock <= aSource.size(); ++position) {
+			index.emplace(block(aSource, position), position);
+		}
+
+		std::vector<uint8_t> literals;
+		size_t cursor = 0; // Position of the patcher in the source image
+		size_t target = 0;
+
+		while (target < aTarget.size()) {
+			size_t source = cursor;
+
+			if (!isAligned(aSource, source, aTarget, target)) {
+				const auto match = target + kBlock <= aTarget.size() ? index.find(block(aTarget, target)) : index.end();
+
+				if (match == index.end()) {
+					literals.push_back(aTarget[target++]);
+					continue;
+				}
+
+				source = match->second;
+			}
+
+			const size_t length = extend(aSource, source, aTarget, target);
+
+			emitInsert(patch, literals);
+			if (source != cursor) {
+				const int64_t distance = static_cast<int64_t>(source) - static_cast<int64_t>(cursor);
+				const uint64_t zigzag = distance < 0 ? (static_cast<uint64_t>(-distance) << 1) - 1
+					: static_cast<uint64_t>(distance) << 1;
+
+				emitVarint(patch, (zigzag << 2) | DeltaHeader::kSeek);
+			}
+			emitAligned(patch, aSource.data() + source, aTarget.data() + target, length);
+
+			cursor = source + length;
+			target += length;
+		}
+
+		emitInsert(patch, literals);
+		return patch;
+	}
+
+private:
+	static uint64_t block(const std::vector<uint8_t> &aData, size_t aPosition)
+	{
+		uint64_t value;
+		memcpy(&value, aData.data() + aPosition, sizeof(value));
+		return value;
+	}
+
+	//!
+	//! Check whether most of the next block matches, small changes do not break the alignment.
+	//!
+	static bool isAligned(const std::vector<uint8_t> &aSource, size_t aSourcePosition,
+		const std::vector<uint8_t> &aTarget, size_t aTargetPosition)
+	{
+		if (aSourcePosition + kBlock > aSource.size() || aTargetPosition + kBlock > aTarget.size()) {
+			return false;
+		}
+
+		size_t matches = 0;
+
+		for (size_t i = 0; i < kBlock; ++i) {
+			if (aSource[aSourcePosition + i] == aTarget[aTargetPosition + i]) {
+				++matches;
+			}
+		}
+
+		return matches >= kBlock - 2;
+	}
+
+	//!
+	//! Extend the approximate match until differences prevail, the match ends with an equal byte.
+	//!
+	static size_t extend(const std::vector<uint8_t> &aSource, size_t aSourcePosition,
+		const std::vector<uint8_t> &aTarget, size_t aTargetPosition)
+	{
+		const size_t limit = std::min(aSource.size() - aSourcePosition, aTarget.size() - aTargetPosition);
+		size_t length = 0;
+		int score = 0;
+
+		for (size_t i = 0; i < limit; ++i) {
+			if (aSource[aSourcePosition + i] == aTarget[aTargetPosition + i]) {
+				score = std::min(score + 1, static_cast<int>(kBlock));
+				length = i + 1;
+			} else if (--score < -static_cast<int>(kBlock)) {
+				break;
+			}
+		}
+
+		return length;
+	}
+
+	static void emitVarint(std::vector<uint8_t> &aPatch, uint64_t aValue)
+	{
+		while (aValue >= 0x80) {
+			aPatch.push_back(static_cast<uint8_t>(aValue | 0x80));
+			aValue >>= 7;
+		}
+		aPatch.push_back(static_cast<uint8_t>(aValue));
+	}
+
+	static void emitInsert(std::vector<uint8_t> &aPatch, std::vector<uint8_t> &aLiterals)
+	{
+		if (!aLiterals.empty()) {
+			emitVarint(aPatch, (static_cast<uint64_t>(aLiterals.size()) << 2) | DeltaHeader::kInsert);
+			aPatch.insert(aPatch.end(), aLiterals.begin(), aLiterals.end());
+			aLiterals.clear();
+		}
+	}
+
+	//!
+	//! Encode an approximate match as Copy instructions for equal runs and Add instructions
+	//! for the rest, short equal runs are merged into Add.
+	//!
+	static void emitAligned(std::vector<uint8_t> &aPatch, const uint8_t *aSource, const uint8_t *aTarget,
+		size_t aLength)
+	{
+		size_t position = 0;
+
+		while (position < aLength) {
+			size_t equal = 0;
+			while (position + equal < aLength && aSource[position + equal] == aTarget[position + equal]) {
+				++equal;
+			}
+
+			if (equal >= kMinCopy || position + equal == aLength) {
+				if (equal) {
+					emitVarint(aPatch, (static_cast<uint64_t>(equal) << 2) | DeltaHeader::kCopy);
+					position += equal;
+				}
+				continue;
+			}
+
+			// Differences end at the next equal run long enough for Copy
+			size_t end = position;
+			size_t run = 0;
+
+			while (end < aLength && run < kMinCopy) {
+				run = aSource[end] == aTarget[end] ? run + 1 : 0;
+				++end;
+			}
+			if (run == kMinCopy) {
+				end -= run;
+			}
+
+			emitVarint(aPatch, (static_cast<uint64_t>(end - position) << 2) | DeltaHeader::kAdd);
+			for (size_t i = position; i < end; ++i) {
+				aPatch.push_back(static_cast<uint8_t>(aTarget[i] - aSource[i]));
+			}
+			position = end;
+		}
+	}
+};
+
+#endif // DRONEDEVICE_DELTAENCODER_HPP_
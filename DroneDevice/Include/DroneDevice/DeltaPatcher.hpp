@@ -0,0 +1,378 @@
+//
+// DeltaPatcher.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_DELTAPATCHER_HPP_
+#define DRONEDEVICE_DELTAPATCHER_HPP_
+
+#include <DroneDevice/FastCrc32.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+//!
+//! Header of a patch, followed by instructions. Each instruction starts with a varint,
+//! two low bits of which select the operation and the rest is the argument:
+//! Copy and Add take bytes from the current position in the source image, Add also sums them
+//! with the following difference bytes, Insert takes the following bytes, Seek moves
+//! the position in the source image by a zigzag-encoded distance. The patch ends as soon as
+//! @b targetSize bytes are produced.
+//!
+struct DeltaHeader {
+	static constexpr uint32_t kMagic{0x57464C44}; // DLFW
+
+	enum Operation : uint8_t {
+		kCopy,
+		kAdd,
+		kInsert,
+		kSeek
+	};
+
+	uint32_t magic;
+	uint32_t sourceSize;
+	uint32_t sourceCrc; //!< CRC32 of the image the patch applies to
+	uint32_t targetSize;
+	uint32_t targetCrc; //!< CRC32 of the resulting image
+	uint32_t reserved;
+};
+
+static_assert(sizeof(DeltaHeader) == 24, "Incorrect header layout");
+
+//!
+//! Streaming patch applier. Bytes of the current image are read from the source region, the new
+//! image is collected in the buffer and passed to the sink by aligned blocks, the last block is
+//! padded with the erased value. The CRC of the source image is calculated in step with the produced
+//! image, so the work is spread over the patch instead of stalling the first chunk, a mismatch fails
+//! the update as soon as the whole source image is read. The resulting image is checked in finalize().
+//! \tparam Source Memory region with the current image.
+//! \tparam Crc CRC32 implementation.
+//!
+template<typename Source, typename Crc = FastCrc32>
+class DeltaPatcher {
+	static constexpr size_t kAlignment{sizeof(uint64_t)};
+
+public:
+	//!
+	//! Receiver of the resulting image.
+	//! \param position Offset of the block in the image.
+	//! \return True when the block is stored.
+	//!
+	using Sink = std::function<bool (size_t, const void *, size_t)>;
+
+	//!
+	//! Construct the patcher.
+	//! \param buffer Buffer for output blocks, aligned for the sink.
+	//! \param bufferSize Size of the buffer, should be a multiple of 8.
+	//! \param sink Receiver of the resulting image.
+	//!
+	DeltaPatcher(uint8_t *aBuffer, size_t aBufferSize, Sink aSink) :
+		buffer{aBuffer},
+		bufferSize{aBufferSize},
+		sink{aSink}
+	{
+		assert(aBufferSize && aBufferSize % kAlignment == 0);
+		reset();
+	}
+
+	DeltaPatcher(const DeltaPatcher &) = delete;
+	DeltaPatcher &operator=(const DeltaPatcher &) = delete;
+
+	void reset()
+	{
+		state = State::Header;
+		received = 0;
+		source = 0;
+		produced = 0;
+		flushed = 0;
+		crc = 0;
+		verified = 0;
+		sourceCrc = 0;
+		resetVarint();
+	}
+
+	//!
+	//! Apply the next chunk of the patch.
+	//! \return False when the patch is malformed, does not match the source image or the sink failed.
+	//!
+	bool update(const void *aData, size_t aLength)
+	{
+		const uint8_t *input = static_cast<const uint8_t *>(aData);
+		const uint8_t * const end = input + aLength;
+
+		while (input != end) {
+			switch (state) {
+				case State::Header: {
+					const size_t length = std::min(sizeof(header) - received, static_cast<size_t>(end - input));
+
+					memcpy(reinterpret_cast<uint8_t *>(&header) + received, input, length);
+					received += length;
+					input += length;
+
+					if (received == sizeof(header)) {
+						state = checkHeader() ? nextInstruction() : State::Error;
+					}
+					break;
+				}
+
+				case State::Instruction: {
+					const uint8_t value = *input++;
+
+					if (shift == 28 && value > 0x0F) {
+						// Value does not fit into 32 bits
+						state = State::Error;
+						break;
+					}
+
+					varint |= static_cast<uint32_t>(value & 0x7F) << shift;
+					shift += 7;
+
+					if (!(value & 0x80)) {
+						state = decode();
+						resetVarint();
+					}
+					break;
+				}
+
+				case State::Add: {
+					// Source bytes are read into the buffer and the differences are added in place
+					const size_t length = std::min({remaining, static_cast<size_t>(end - input), bufferSize - fill()});
+					uint8_t * const block = buffer + fill();
+
+					if (!Source::read(source, block, length)) {
+						state = State::Error;
+						break;
+					}
+					for (size_t i = 0; i < length; ++i) {
+						block[i] = static_cast<uint8_t>(block[i] + input[i]);
+					}
+
+					input += length;
+					source += length;
+					state = advance(length);
+					break;
+				}
+
+				case State::Insert: {
+					const size_t length = std::min({remaining, static_cast<size_t>(end - input), bufferSize - fill()});
+
+					memcpy(buffer + fill(), input, length);
+					input += length;
+					state = advance(length);
+					break;
+				}
+
+				default:
+					// Data after the end of the patch or after an error
+					state = State::Error;
+					return false;
+			}
+		}
+
+		if (state != State::Error && state != State::Header && !verifySource()) {
+			state = State::Error;
+		}
+
+		return state != State::Error;
+	}
+
+	//!
+	//! Flush the rest of the image and check the CRC.
+	//! \return True when the whole patch is applied and the image matches the header.
+	//!
+	bool finalize()
+	{
+		if (state != State::Done || !verifySource()) {
+			state = State::Error;
+			return false;
+		}
+
+		if (fill()) {
+			const size_t length = (fill() + kAlignment - 1) / kAlignment * kAlignment;
+
+			crc = Crc::update(crc, buffer, fill());
+			std::fill(buffer + fill(), buffer + length, 0xFF);
+
+			if (!sink(flushed, buffer, length)) {
+				state = State::Error;
+				return false;
+			}
+
+			flushed = produced;
+		}
+
+		return crc == header.targetCrc;
+	}
+
+	bool isComplete() const
+	{
+		return state == State::Done;
+	}
+
+	//!
+	//! Length of the image passed to the sink.
+	//!
+	size_t getFlushed() const
+	{
+		return flushed;
+	}
+
+	//!
+	//! CRC32 of the image passed to the sink.
+	//!
+	uint32_t getChecksum() const
+	{
+		return crc;
+	}
+
+private:
+	enum class State {
+		Header,
+		Instruction,
+		Add,
+		Insert,
+		Done,
+		Error
+	};
+
+	uint8_t * const buffer;
+	const size_t bufferSize;
+	Sink sink;
+
+	DeltaHeader header;
+	State state;
+	size_t received;
+	size_t source;
+	size_t produced;
+	size_t flushed;
+	size_t remaining;
+	uint32_t varint;
+	unsigned int shift;
+	uint32_t crc;
+	size_t verified;
+	uint32_t sourceCrc;
+
+	size_t fill() const
+	{
+		return produced - flushed;
+	}
+
+	void resetVarint()
+	{
+		varint = 0;
+		shift = 0;
+	}
+
+	bool checkHeader() const
+	{
+		return header.magic == DeltaHeader::kMagic && header.sourceSize <= Source::capacity();
+	}
+
+	//!
+	//! Advance the CRC of the source image in proportion to the produced image.
+	//! \return False when the source image can not be read or does not match the header.
+	//!
+	bool verifySource()
+	{
+		const size_t end = produced == header.targetSize ? header.sourceSize
+			: static_cast<size_t>(static_cast<uint64_t>(header.sourceSize) * produced / header.targetSize);
+
+		// The output buffer is in use, the source image is read by small blocks
+		uint8_t block[64];
+
+		while (verified < end) {
+			const size_t length = std::min(sizeof(block), end - verified);
+
+			if (!Source::read(verified, block, length)) {
+				return false;
+			}
+			sourceCrc = Crc::update(sourceCrc, block, length);
+			verified += length;
+		}
+
+		return verified < header.sourceSize || sourceCrc == header.sourceCrc;
+	}
+
+	State nextInstruction() const
+	{
+		return produced == header.targetSize ? State::Done : State::Instruction;
+	}
+
+	State decode()
+	{
+		const uint32_t argument = varint >> 2;
+
+		switch (varint & 3) {
+			case DeltaHeader::kSeek: {
+				const int32_t distance = static_cast<int32_t>(argument >> 1) ^ -static_cast<int32_t>(argument & 1);
+				const int64_t position = static_cast<int64_t>(source) + distance;
+
+				if (position < 0 || position > static_cast<int64_t>(header.sourceSize)) {
+					return State::Error;
+				}
+
+				source = static_cast<size_t>(position);
+				return State::Instruction;
+			}
+
+			case DeltaHeader::kInsert:
+				remaining = argument;
+				return argument && argument <= header.targetSize - produced ? State::Insert : State::Error;
+
+			default:
+				remaining = argument;
+
+				if (!argument || argument > header.targetSize - produced || argument > header.sourceSize - source) {
+					return State::Error;
+				}
+
+				return (varint & 3) == DeltaHeader::kAdd ? State::Add : copy();
+		}
+	}
+
+	State copy()
+	{
+		// Copy takes no input, it is executed at once
+		while (remaining) {
+			const size_t length = std::min(remaining, bufferSize - fill());
+
+			if (!Source::read(source, buffer + fill(), length)) {
+				return State::Error;
+			}
+
+			source += length;
+
+			const State next = advance(length);
+
+			if (next == State::Error) {
+				return next;
+			}
+		}
+
+		return nextInstruction();
+	}
+
+	State advance(size_t aLength)
+	{
+		produced += aLength;
+		remaining -= aLength;
+
+		if (fill() == bufferSize) {
+			crc = Crc::update(crc, buffer, bufferSize);
+
+			if (!sink(flushed, buffer, bufferSize)) {
+				return State::Error;
+			}
+
+			flushed = produced;
+		}
+
+		return remaining ? state : nextInstruction();
+	}
+};
+
+#endif // DRONEDEVICE_DELTAPATCHER_HPP_
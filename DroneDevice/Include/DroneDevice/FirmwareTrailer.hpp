@@ -0,0 +1,113 @@
+//
+// FirmwareTrailer.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_FIRMWARETRAILER_HPP_
+#define DRONEDEVICE_FIRMWARETRAILER_HPP_
+
+#include <DroneDevice/FastCrc32.hpp>
+#include <DroneDevice/Sha256.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+//!
+//! Description of a firmware image placed at the end of the firmware region. The trailer is
+//! written after the image, so an interrupted update leaves the region without a valid trailer.
+//! Builds with FIRMWARE_TRAILER get the trailer from cmake/AppendFirmwareTrailer.cmake.
+//!
+struct FirmwareTrailer {
+	static constexpr uint32_t kMagic{0x4C525446}; // FTRL
+
+	uint32_t magic;
+	uint32_t size; //!< Image length in bytes
+	uint32_t buildId;
+	uint32_t crc; //!< CRC32 of the image
+	uint8_t digest[32]; //!< SHA-256 of the image
+	uint32_t reserved[3];
+	uint32_t checksum; //!< CRC32 of the preceding fields of the trailer
+
+	//!
+	//! Check the trailer itself without reading the image.
+	//! \param capacity Maximum image length.
+	//!
+	bool isValid(size_t aCapacity) const
+	{
+		return magic == kMagic && size <= aCapacity && checksum == calculateChecksum();
+	}
+
+	//!
+	//! Check the image with the CRC32, the time is proportional to the image length.
+	//! \tparam Crc CRC32 implementation, hardware units may be used.
+	//! \param image Start of the image.
+	//!
+	template<typename Crc = FastCrc32>
+	bool verify(const void *aImage) const
+	{
+		return Crc::update(0, aImage, size) == crc;
+	}
+
+	//!
+	//! Check the image with the SHA-256 digest, slower than verify() but detects intentional changes.
+	//! \param image Start of the image.
+	//!
+	bool verifyDigest(const void *aImage) const
+	{
+		Sha256 sha;
+
+		sha.update(static_cast<const uint8_t *>(aImage), size);
+		const auto result = sha.finalize();
+
+		return memcmp(result.data(), digest, sizeof(digest)) == 0;
+	}
+
+	uint32_t calculateChecksum() const
+	{
+		return FastCrc32::update(0, this, offsetof(FirmwareTrailer, checksum));
+	}
+};
+
+static_assert(sizeof(FirmwareTrailer) == 64, "Incorrect trailer layout");
+
+//!
+//! Streaming calculation of the trailer while the image is being written.
+//! The updater must invalidate the verification result cached by the bootloader before the first
+//! write of a new image, see Dfu::beginFirmwareUpdate(), otherwise a warm restart during the update
+//! accepts the partially written image with the trailer of the previous one.
+//! \tparam Crc CRC32 implementation, hardware units may be used.
+//!
+template<typename Crc = FastCrc32>
+class FirmwareTrailerBuilder {
+public:
+	void update(const void *aData, size_t aLength)
+	{
+		crc = Crc::update(crc, aData, aLength);
+		sha.update(static_cast<const uint8_t *>(aData), aLength);
+		size += static_cast<uint32_t>(aLength);
+	}
+
+	FirmwareTrailer finalize(uint32_t aBuildId)
+	{
+		FirmwareTrailer trailer;
+		const auto result = sha.finalize();
+
+		memset(&trailer, 0xFF, sizeof(trailer));
+		trailer.magic = FirmwareTrailer::kMagic;
+		trailer.size = size;
+		trailer.buildId = aBuildId;
+		trailer.crc = crc;
+		memcpy(trailer.digest, result.data(), sizeof(trailer.digest));
+		trailer.checksum = trailer.calculateChecksum();
+
+		return trailer;
+	}
+
+private:
+	Sha256 sha;
+	uint32_t crc{0};
+	uint32_t size{0};
+};
+
+#endif // DRONEDEVICE_FIRMWARETRAILER_HPP_
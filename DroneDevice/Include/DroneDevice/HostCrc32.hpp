@@ -0,0 +1,214 @@
+//
+// HostCrc32.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_HOSTCRC32_HPP_
+#define DRONEDEVICE_HOSTCRC32_HPP_
+
+#include <DroneDevice/SliceCrc32.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DRONEDEVICE_CLMUL_CRC32
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define DRONEDEVICE_ARM_CRC32
+#include <arm_acle.h>
+#endif
+
+#ifdef DRONEDEVICE_CLMUL_CRC32
+
+//!
+//! CRC32 with carry-less multiplication folding, results are identical to FastCrc32.
+//! Availability of the instructions is checked at run time, the slice-by-8 algorithm
+//! is used for short buffers, tails and processors without PCLMULQDQ.
+//!
+class ClmulCrc32 {
+public:
+	using Type = uint32_t;
+	static constexpr size_t size{sizeof(uint32_t)};
+
+	ClmulCrc32() = delete;
+	ClmulCrc32(const ClmulCrc32 &) = delete;
+	ClmulCrc32 &operator=(const ClmulCrc32 &) = delete;
+
+	static bool isSupported()
+	{
+		static const bool supported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+		return supported;
+	}
+
+	//!
+	//! Update checksum with buffer data.
+	//! \param checksum Previous checksum value.
+	//! \param buffer Pointer to buffer with at least @b length characters of data.
+	//! \param length Buffer length.
+	//! \return Updated checksum value.
+	//!
+	static uint32_t update(uint32_t aChecksum, const void *aBuffer, size_t aLength)
+	{
+		const uint8_t *buffer = static_cast<const uint8_t *>(aBuffer);
+
+		if (aLength >= kMinLength && isSupported()) {
+			const size_t length = aLength & ~static_cast<size_t>(kBlockSize - 1);
+
+			aChecksum = ~fold(~aChecksum, buffer, length);
+			buffer += length;
+			aLength -= length;
+		}
+
+		return SliceCrc32::update(aChecksum, buffer, aLength);
+	}
+
+private:
+	static constexpr size_t kBlockSize{16};
+	static constexpr size_t kMinLength{64};
+
+	//!
+	//! Fold the buffer with constants for the reflected CRC32 polynomial and reduce the result.
+	//! \param state Shift register state without final inversion.
+	//! \param buffer Buffer with at least 64 bytes of data.
+	//! \param length Buffer length, should be a multiple of 16.
+	//! \return Updated shift register state.
+	//!
+	__attribute__((target("pclmul,sse4.1")))
+	static uint32_t fold(uint32_t aState, const uint8_t *aBuffer, size_t aLength)
+	{
+		const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596LL, 0x0154442BD4LL);
+		const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009ELL, 0x01751997D0LL);
+		const __m128i k5k0 = _mm_set_epi64x(0, 0x0163CD6124LL);
+		const __m128i poly = _mm_set_epi64x(0x01F7011641LL, 0x01DB710641LL);
+		const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+		__m128i x1 = load(aBuffer + 0x00);
+		__m128i x2 = load(aBuffer + 0x10);
+		__m128i x3 = load(aBuffer + 0x20);
+		__m128i x4 = load(aBuffer + 0x30);
+
+		x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(aState)));
+		aBuffer += 64;
+		aLength -= 64;
+
+		// Fold four lanes in parallel
+		while (aLength >= 64) {
+			x1 = foldBlock(x1, k1k2, load(aBuffer + 0x00));
+			x2 = foldBlock(x2, k1k2, load(aBuffer + 0x10));
+			x3 = foldBlock(x3, k1k2, load(aBuffer + 0x20));
+			x4 = foldBlock(x4, k1k2, load(aBuffer + 0x30));
+
+			aBuffer += 64;
+			aLength -= 64;
+		}
+
+		// Fold lanes into a single one
+		x1 = foldBlock(x1, k3k4, x2);
+		x1 = foldBlock(x1, k3k4, x3);
+		x1 = foldBlock(x1, k3k4, x4);
+
+		while (aLength >= kBlockSize) {
+			x1 = foldBlock(x1, k3k4, load(aBuffer));
+
+			aBuffer += kBlockSize;
+			aLength -= kBlockSize;
+		}
+
+		// Fold 128 bits to 64 bits
+		x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+		x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+		x2 = _mm_srli_si128(x1, 4);
+		x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k5k0, 0x00);
+		x1 = _mm_xor_si128(x1, x2);
+
+		// Barrett reduction to 32 bits
+		x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), poly, 0x10);
+		x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), poly, 0x00);
+		x1 = _mm_xor_si128(x1, x2);
+
+		return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+	}
+
+	__attribute__((target("pclmul,sse4.1")))
+	static __m128i foldBlock(__m128i aValue, __m128i aConstants, __m128i aData)
+	{
+		const __m128i low = _mm_clmulepi64_si128(aValue, aConstants, 0x00);
+		const __m128i high = _mm_clmulepi64_si128(aValue, aConstants, 0x11);
+
+		return _mm_xor_si128(_mm_xor_si128(high, low), aData);
+	}
+
+	__attribute__((target("sse4.1")))
+	static __m128i load(const uint8_t *aBuffer)
+	{
+		return _mm_loadu_si128(reinterpret_cast<const __m128i *>(aBuffer));
+	}
+};
+
+#endif // DRONEDEVICE_CLMUL_CRC32
+
+#ifdef DRONEDEVICE_ARM_CRC32
+
+//!
+//! CRC32 with ARMv8 CRC instructions, results are identical to FastCrc32.
+//!
+class ArmCrc32 {
+public:
+	using Type = uint32_t;
+	static constexpr size_t size{sizeof(uint32_t)};
+
+	ArmCrc32() = delete;
+	ArmCrc32(const ArmCrc32 &) = delete;
+	ArmCrc32 &operator=(const ArmCrc32 &) = delete;
+
+	//!
+	//! Update checksum with buffer data.
+	//! \param checksum Previous checksum value.
+	//! \param buffer Pointer to buffer with at least @b length characters of data.
+	//! \param length Buffer length.
+	//! \return Updated checksum value.
+	//!
+	static uint32_t update(uint32_t aChecksum, const void *aBuffer, size_t aLength)
+	{
+		const uint8_t *buffer = static_cast<const uint8_t *>(aBuffer);
+
+		aChecksum = ~aChecksum;
+
+		while (aLength >= sizeof(uint64_t)) {
+			uint64_t word;
+
+			memcpy(&word, buffer, sizeof(word));
+			aChecksum = __crc32d(aChecksum, word);
+
+			buffer += sizeof(uint64_t);
+			aLength -= sizeof(uint64_t);
+		}
+
+		while (aLength--) {
+			aChecksum = __crc32b(aChecksum, *buffer++);
+		}
+
+		return ~aChecksum;
+	}
+};
+
+#endif // DRONEDEVICE_ARM_CRC32
+
+//!
+//! The fastest CRC32 implementation available on the build host,
+//! intended for ground tools verifying large logs and firmware images.
+//!
+#if defined(DRONEDEVICE_CLMUL_CRC32)
+using HostCrc32 = ClmulCrc32;
+#elif defined(DRONEDEVICE_ARM_CRC32)
+using HostCrc32 = ArmCrc32;
+#else
+using HostCrc32 = SliceCrc32;
+#endif
+
+#endif // DRONEDEVICE_HOSTCRC32_HPP_
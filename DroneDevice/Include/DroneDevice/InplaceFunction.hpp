@@ -0,0 +1,164 @@
+//
+// InplaceFunction.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_INPLACEFUNCTION_HPP_
+#define DRONEDEVICE_INPLACEFUNCTION_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<typename Signature, size_t capacity = 4 * sizeof(void *)>
+class InplaceFunction;
+
+//!
+//! Function wrapper similar to std::function with the callable object stored inside the wrapper.
+//! Heap is never used, callables larger than the storage are rejected at compile time.
+//! \tparam capacity Size of the storage for the callable object.
+//!
+template<typename R, typename... Args, size_t capacity>
+class InplaceFunction<R (Args...), capacity> {
+	struct Operations {
+		R (*invoke)(void *, Args &&...);
+		void (*copy)(void *, const void *);
+		void (*move)(void *, void *);
+		void (*destroy)(void *);
+	};
+
+public:
+	InplaceFunction() = default;
+
+	InplaceFunction(std::nullptr_t)
+	{
+	}
+
+	template<typename F, typename = typename std::enable_if<
+		!std::is_same<typename std::decay<F>::type, InplaceFunction>::value>::type>
+	InplaceFunction(F &&aFunction)
+	{
+		using Type = typename std::decay<F>::type;
+
+		static_assert(sizeof(Type) <= capacity, "Callable object is too large");
+		static_assert(alignof(Type) <= alignof(Storage), "Callable object has unsupported alignment");
+
+		static const Operations operations = {
+			[](void *aObject, Args &&...aArgs) -> R {
+				return (*static_cast<Type *>(aObject))(std::forward<Args>(aArgs)...);
+			},
+			[](void *aDestination, const void *aSource) {
+				new (aDestination) Type{*static_cast<const Type *>(aSource)};
+			},
+			[](void *aDestination, void *aSource) {
+				new (aDestination) Type{std::move(*static_cast<Type *>(aSource))};
+			},
+			[](void *aObject) {
+				static_cast<Type *>(aObject)->~Type();
+			}
+		};
+
+		new (&storage) Type{std::forward<F>(aFunction)};
+		ops = &operations;
+	}
+
+	InplaceFunction(const InplaceFunction &aOther) :
+		ops{aOther.ops}
+	{
+		if (ops != nullptr) {
+			ops->copy(&storage, &aOther.storage);
+		}
+	}
+
+	//!
+	//! Move the callable object, the source is left empty.
+	//!
+	InplaceFunction(InplaceFunction &&aOther) :
+		ops{aOther.ops}
+	{
+		if (ops != nullptr) {
+			ops->move(&storage, &aOther.storage);
+			aOther.reset();
+		}
+	}
+
+	~InplaceFunction()
+	{
+		reset();
+	}
+
+	InplaceFunction &operator=(const InplaceFunction &aOther)
+	{
+		if (this != &aOther) {
+			reset();
+
+			if (aOther.ops != nullptr) {
+				aOther.ops->copy(&storage, &aOther.storage);
+				ops = aOther.ops;
+			}
+		}
+
+		return *this;
+	}
+
+	InplaceFunction &operator=(InplaceFunction &&aOther)
+	{
+		if (this != &aOther) {
+			reset();
+
+			if (aOther.ops != nullptr) {
+				aOther.ops->move(&storage, &aOther.storage);
+				ops = aOther.ops;
+				aOther.reset();
+			}
+		}
+
+		return *this;
+	}
+
+	InplaceFunction &operator=(std::nullptr_t)
+	{
+		reset();
+		return *this;
+	}
+
+	explicit operator bool() const
+	{
+		return ops != nullptr;
+	}
+
+	bool operator==(std::nullptr_t) const
+	{
+		return ops == nullptr;
+	}
+
+	bool operator!=(std::nullptr_t) const
+	{
+		return ops != nullptr;
+	}
+
+	R operator()(Args... aArgs) const
+	{
+		assert(ops != nullptr);
+		return ops->invoke(&storage, std::forward<Args>(aArgs)...);
+	}
+
+private:
+	using Storage = typename std::aligned_storage<capacity, alignof(std::max_align_t)>::type;
+
+	mutable Storage storage;
+	const Operations *ops{nullptr};
+
+	void reset()
+	{
+		if (ops != nullptr) {
+			ops->destroy(&storage);
+			ops = nullptr;
+		}
+	}
+};
+
+#endif // DRONEDEVICE_INPLACEFUNCTION_HPP_
@@ -0,0 +1,33 @@
+//
+// CompressedFile.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_INTERNALDEVICE_COMPRESSEDFILE_HPP_
+#define DRONEDEVICE_INTERNALDEVICE_COMPRESSEDFILE_HPP_
+
+#include <DroneDevice/InternalDevice/StreamFile.hpp>
+#include <DroneDevice/LzDecoder.hpp>
+#include <DroneDevice/PlatformCrc32.hpp>
+
+namespace Device {
+
+//!
+//! File which receives a compressed stream and programs decompressed data into a memory region.
+//! Written chunks are decompressed on the fly, the window of the decoder is provided by the caller,
+//! for example Dfu::arena. The size and the checksum of the file describe decompressed data,
+//! the write is finalized only when the CRC from the stream header matches decompressed data.
+//! The window is passed to the constructor, its size should be a power of two.
+//! \tparam Region Memory region with relative addressing.
+//! \tparam Crc CRC32 implementation used for decompressed data.
+//!
+template<typename Region, class Crc = PlatformCrc32>
+class CompressedFile : public StreamFile<Region, LzDecoder<Crc>> {
+public:
+	using StreamFile<Region, LzDecoder<Crc>>::StreamFile;
+};
+
+} // namespace Device
+
+#endif // DRONEDEVICE_INTERNALDEVICE_COMPRESSEDFILE_HPP_
@@ -0,0 +1,338 @@
+//
+// FlashFile.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_INTERNALDEVICE_FLASHFILE_HPP_
+#define DRONEDEVICE_INTERNALDEVICE_FLASHFILE_HPP_
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <DroneDevice/AbstractDevice.hpp>
+#include <DroneDevice/InplaceFunction.hpp>
+#include <DroneDevice/InternalDevice/AbstractFile.hpp>
+#include <DroneDevice/PlatformCrc32.hpp>
+
+namespace Device {
+
+//!
+//! File stored in a memory region. Written data is combined in aligned buffers
+//! and programmed with whole buffers, the checksum is updated while streaming.
+//! \tparam Flash Memory interface with absolute addressing.
+//! \tparam offset Absolute address of the region.
+//! \tparam capacity Size of the region.
+//! \tparam bufferSize Size of each of two write buffers, should be a multiple of the programming unit.
+//!
+template<typename Flash, uintptr_t offset, size_t capacity, size_t bufferSize = 256, bool readonly = false,
+	class Checksum = PlatformCrc32>
+class FlashFile : public AbstractFile {
+	static constexpr size_t kAlignment = sizeof(uint64_t);
+
+	static_assert(bufferSize % kAlignment == 0, "Incorrect buffer size");
+	static_assert(capacity % kAlignment == 0, "Incorrect capacity");
+
+public:
+	using Callback = InplaceFunction<void (bool)>;
+
+	//!
+	//! Construct the file over already programmed data.
+	//! \param size Size of the data in the region.
+	//!
+	FlashFile(size_t aSize = 0) :
+		size{std::min(aSize, capacity)},
+		flushed{size},
+		fill{0},
+		active{0},
+		checksum{kFileInitialChecksum},
+		checksumValid{aSize == 0},
+		finalized{true},
+		failed{false},
+		pending{false, false}
+	{
+	}
+
+	//!
+	//! Program the memory using an asynchronous engine, the file does not block
+	//! on erase and programming except when both buffers are in flight.
+	//! Callbacks of the engine must be called from an interrupt or from another thread: the file waits
+	//! for a free slot in the queue of the engine, for the buffer which is still in flight and for all
+	//! pending jobs before reading programmed data. Each wait lasts until the engine finishes its earlier jobs,
+	//! so an engine which completes jobs only from the context of the file deadlocks.
+	//! \param engine Engine with erase(address, length, callback) and write(address, buffer, length, callback).
+	//!
+	template<typename Engine>
+	void setEngine(Engine &aEngine)
+	{
+		eraseAsync = [&aEngine](uintptr_t aAddress, size_t aLength, Callback aCallback) {
+			return aEngine.erase(aAddress, aLength, aCallback);
+		};
+		writeAsync = [&aEngine](uintptr_t aAddress, const void *aBuffer, size_t aLength, Callback aCallback) {
+			return aEngine.write(aAddress, aBuffer, aLength, aCallback);
+		};
+	}
+
+	//!
+	//! Pointer to the memory-mapped content of the file.
+	//!
+	const void *data() const
+	{
+		return reinterpret_cast<const void *>(offset);
+	}
+
+	uint32_t getChecksum() const override
+	{
+		if (!checksumValid) {
+			// Data was programmed before startup, calculate checksum once
+			uint8_t buffer[64];
+
+			checksum = kFileInitialChecksum;
+
+			for (size_t position = 0; position < size; position += sizeof(buffer)) {
+				const size_t length = std::min(sizeof(buffer), size - position);
+
+				Flash::read(offset + position, buffer, length);
+				checksum = Checksum::update(checksum, buffer, length);
+			}
+
+			checksumValid = true;
+		}
+
+		// Data in the write buffer is not included into the checksum yet
+		return fill ? Checksum::update(checksum, buffers[active], fill) : checksum;
+	}
+
+	FileFlags getFlags() const override
+	{
+		return readonly ? kFileReadable : (kFileReadable | kFileWritable);
+	}
+
+	uint32_t getSize() const override
+	{
+		return static_cast<uint32_t>(size);
+	}
+
+	bool readChunk(uint32_t aOffset, void *aBuffer, size_t aLength) const override
+	{
+		const size_t position = static_cast<size_t>(aOffset);
+
+		if (position >= size || !aLength) {
+			return false;
+		}
+
+		const size_t chunkLength = std::min(size - position, aLength);
+		uint8_t * const buffer = static_cast<uint8_t *>(aBuffer);
+
+		// Programmed part is read directly from the memory
+		if (position < flushed) {
+			const size_t length = std::min(flushed - position, chunkLength);
+
+			waitForPending();
+
+			if (!Flash::read(offset + position, buffer, length)) {
+				return false;
+			}
+		}
+
+		// Remaining part is still in the write buffer
+		if (position + chunkLength > flushed) {
+			const size_t begin = std::max(position, flushed);
+
+			memcpy(buffer + (begin - position), buffers[active] + (begin - flushed), position + chunkLength - begin);
+		}
+
+		return true;
+	}
+
+	bool writeChunk(uint32_t aOffset, const void *aBuffer, size_t aLength) override
+	{
+		return writeChunkImpl<readonly>(static_cast<size_t>(aOffset), static_cast<const uint8_t *>(aBuffer), aLength);
+	}
+
+	bool restartWrite() override
+	{
+		return restartWriteImpl<readonly>();
+	}
+
+	bool finalizeWrite(uint32_t aTotal) override
+	{
+		return finalizeWriteImpl<readonly>(static_cast<size_t>(aTotal));
+	}
+
+	bool isFinalized() const override
+	{
+		return finalized;
+	}
+
+protected:
+	size_t size;
+	size_t flushed;
+	size_t fill;
+	size_t active;
+	mutable uint32_t checksum;
+	mutable bool checksumValid;
+	bool finalized;
+	volatile bool failed;
+	volatile bool pending[2];
+	alignas(kAlignment) uint8_t buffers[2][bufferSize];
+
+	std::function<bool (uintptr_t, size_t, Callback)> eraseAsync;
+	std::function<bool (uintptr_t, const void *, size_t, Callback)> writeAsync;
+
+private:
+	void waitForPending() const
+	{
+		while (pending[0] || pending[1]);
+	}
+
+	bool flush()
+	{
+		if (!fill) {
+			return !failed;
+		}
+
+		// Pad the last unit with erased value
+		const size_t length = (fill + kAlignment - 1) / kAlignment * kAlignment;
+		std::fill(buffers[active] + fill, buffers[active] + length, 0xFF);
+
+		checksum = Checksum::update(checksum, buffers[active], fill);
+
+		const uintptr_t address = offset + flushed;
+		bool result;
+
+		if (writeAsync != nullptr) {
+			const size_t index = active;
+
+			pending[index] = true;
+
+			// Wait for a free slot in the queue of the engine
+			while (!writeAsync(address, buffers[index], length, [this, index](bool aStatus) {
+				if (!aStatus) {
+					failed = true;
+				}
+				pending[index] = false;
+			}));
+
+			// Switch to the second buffer, it may be still in flight
+			active ^= 1;
+			while (pending[active]);
+
+			result = !failed;
+		} else {
+			result = Flash::write(address, buffers[active], length);
+		}
+
+		flushed += fill;
+		fill = 0;
+		return result;
+	}
+
+	template<bool selector>
+	typename std::enable_if_t<!selector, bool> writeChunkImpl(size_t aOffset, const uint8_t *aBuffer, size_t aLength)
+	{
+		if (finalized || !aLength || aOffset > size || aOffset + aLength > capacity) {
+			return false;
+		}
+
+		const size_t skipped = size - aOffset;
+
+		if (skipped < aLength) {
+			const uint8_t *buffer = aBuffer + skipped;
+			size_t remaining = aLength - skipped;
+
+			while (remaining) {
+				const size_t length = std::min(bufferSize - fill, remaining);
+
+				memcpy(buffers[active] + fill, buffer, length);
+				fill += length;
+				size += length;
+				buffer += length;
+				remaining -= length;
+
+				if (fill == bufferSize && !flush()) {
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	template<bool selector>
+	typename std::enable_if_t<selector, bool> writeChunkImpl(size_t, const uint8_t *, size_t)
+	{
+		return false;
+	}
+
+	template<bool selector>
+	typename std::enable_if_t<!selector, bool> restartWriteImpl()
+	{
+		waitForPending();
+
+		size = 0;
+		flushed = 0;
+		fill = 0;
+		checksum = kFileInitialChecksum;
+		checksumValid = true;
+		failed = false;
+		finalized = false;
+
+		if (eraseAsync != nullptr) {
+			// Following writes are queued after the erase
+			return eraseAsync(offset, capacity, [this](bool aStatus) {
+				if (!aStatus) {
+					failed = true;
+				}
+			});
+		} else {
+			Flash::unlock();
+
+			if (Flash::erase(offset, capacity)) {
+				return true;
+			} else {
+				Flash::lock();
+				return false;
+			}
+		}
+	}
+
+	template<bool selector>
+	typename std::enable_if_t<selector, bool> restartWriteImpl()
+	{
+		return false;
+	}
+
+	template<bool selector>
+	typename std::enable_if_t<!selector, bool> finalizeWriteImpl(size_t aTotal)
+	{
+		if (aTotal == kFileReservedPosition) {
+			aTotal = 0;
+		}
+
+		if (finalized || aTotal != size) {
+			return false;
+		}
+
+		const bool result = flush();
+
+		waitForPending();
+
+		if (writeAsync == nullptr) {
+			Flash::lock();
+		}
+
+		finalized = result && !failed;
+		return finalized;
+	}
+
+	template<bool selector>
+	typename std::enable_if_t<selector, bool> finalizeWriteImpl(size_t)
+	{
+		return false;
+	}
+};
+
+} // namespace Device
+
+#endif // DRONEDEVICE_INTERNALDEVICE_FLASHFILE_HPP_
@@ -11,6 +11,7 @@
 #include <DroneDevice/AbstractDevice.hpp>
 #include <DroneDevice/InternalDevice/AbstractField.hpp>
 #include <DroneDevice/InternalDevice/AbstractFile.hpp>
+#include <DroneDevice/PlatformCrc32.hpp>
 #include <DroneDevice/Stubs/MockUid.hpp>
 #include <DroneDevice/TypeHelpers.hpp>
 
@@ -229,14 +230,14 @@ public:
 		}
 	}
 
-	template<typename T, typename U = MockUid>
+	template<typename T = PlatformCrc32, typename U = MockUid>
 	void makeDeviceHash()
 	{
 		// Generate device hash from the Unique Identifier of the processor
 		makeHashFromUid<T, U>(0);
 	}
 
-	template<typename T, typename U = MockUid>
+	template<typename T = PlatformCrc32, typename U = MockUid>
 	void makeDeviceHashFromName()
 	{
 		// Generate device hash from device name and UID
@@ -245,7 +246,7 @@ public:
 		makeHashFromUid<T, U>(seed);
 	}
 
-	template<typename T, typename U = MockUid>
+	template<typename T = PlatformCrc32, typename U = MockUid>
 	void makeDeviceHashFromDevice()
 	{
 		// Generate device hash from device fields, name and UID
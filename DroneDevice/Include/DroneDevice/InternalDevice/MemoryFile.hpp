@@ -10,12 +10,12 @@
 
 #include <algorithm>
 #include <DroneDevice/AbstractDevice.hpp>
-#include <DroneDevice/FastCrc32.hpp>
 #include <DroneDevice/InternalDevice/AbstractFile.hpp>
+#include <DroneDevice/PlatformCrc32.hpp>
 
 namespace Device {
 
-template<size_t capacity, bool readonly = false, class Checksum = FastCrc32>
+template<size_t capacity, bool readonly = false, class Checksum = PlatformCrc32>
 class MemoryFile : public AbstractFile {
 public:
 	MemoryFile() :
@@ -0,0 +1,34 @@
+//
+// PatchFile.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_INTERNALDEVICE_PATCHFILE_HPP_
+#define DRONEDEVICE_INTERNALDEVICE_PATCHFILE_HPP_
+
+#include <DroneDevice/DeltaPatcher.hpp>
+#include <DroneDevice/InternalDevice/StreamFile.hpp>
+#include <DroneDevice/PlatformCrc32.hpp>
+
+namespace Device {
+
+//!
+//! File which receives a patch against the current image and programs the new image into
+//! a staging region. The size and the checksum of the file describe the new image, the write
+//! is finalized only when the patch matched the current image and the CRC of the new image
+//! matches the patch header. The buffer for output blocks, for example Dfu::arena, is passed
+//! to the constructor, its size should be a multiple of 8.
+//! \tparam Source Memory region with the current image, for example FirmwareRegion.
+//! \tparam Target Staging memory region.
+//! \tparam Crc CRC32 implementation.
+//!
+template<typename Source, typename Target, class Crc = PlatformCrc32>
+class PatchFile : public StreamFile<Target, DeltaPatcher<Source, Crc>> {
+public:
+	using StreamFile<Target, DeltaPatcher<Source, Crc>>::StreamFile;
+};
+
+} // namespace Device
+
+#endif // DRONEDEVICE_INTERNALDEVICE_PATCHFILE_HPP_
@@ -0,0 +1,137 @@
+//
+// StreamFile.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_INTERNALDEVICE_STREAMFILE_HPP_
+#define DRONEDEVICE_INTERNALDEVICE_STREAMFILE_HPP_
+
+#include <algorithm>
+#include <DroneDevice/AbstractDevice.hpp>
+#include <DroneDevice/InternalDevice/AbstractFile.hpp>
+
+namespace Device {
+
+//!
+//! File which passes the written stream through a decoder and programs the decoder output into
+//! a memory region. Offsets of written chunks are positions in the stream, the size and the checksum
+//! of the file describe the output. The write is finalized only when the decoder accepts the stream.
+//! \tparam Region Memory region with relative addressing.
+//! \tparam Decoder Decoder constructed with a buffer, its size and a sink, with reset(), update(),
+//! finalize(), getFlushed() and getChecksum() methods.
+//!
+template<typename Region, typename Decoder>
+class StreamFile : public AbstractFile {
+public:
+	//!
+	//! Construct the file.
+	//! \param buffer Working buffer of the decoder, aligned for the programming unit.
+	//! \param bufferSize Size of the buffer.
+	//!
+	StreamFile(uint8_t *aBuffer, size_t aBufferSize) :
+		decoder{aBuffer, aBufferSize, [](size_t aPosition, const void *aData, size_t aLength) {
+			return aPosition + aLength <= Region::capacity() && Region::write(aPosition, aData, aLength);
+		}},
+		received{0},
+		finalized{true}
+	{
+	}
+
+	uint32_t getChecksum() const override
+	{
+		return decoder.getChecksum();
+	}
+
+	FileFlags getFlags() const override
+	{
+		return kFileReadable | kFileWritable;
+	}
+
+	uint32_t getSize() const override
+	{
+		return static_cast<uint32_t>(decoder.getFlushed());
+	}
+
+	bool readChunk(uint32_t aOffset, void *aBuffer, size_t aLength) const override
+	{
+		const size_t position = static_cast<size_t>(aOffset);
+		const size_t size = decoder.getFlushed();
+
+		if (position >= size || !aLength) {
+			return false;
+		}
+
+		return Region::read(position, aBuffer, std::min(size - position, aLength));
+	}
+
+	bool writeChunk(uint32_t aOffset, const void *aBuffer, size_t aLength) override
+	{
+		const size_t position = static_cast<size_t>(aOffset);
+
+		// Chunks are accepted in order
+		if (finalized || !aLength || position > received) {
+			return false;
+		}
+
+		const size_t skipped = received - position;
+
+		if (skipped < aLength) {
+			const size_t pending = aLength - skipped;
+
+			if (!decoder.update(static_cast<const uint8_t *>(aBuffer) + skipped, pending)) {
+				return false;
+			}
+			received += pending;
+		}
+
+		return true;
+	}
+
+	bool restartWrite() override
+	{
+		decoder.reset();
+		received = 0;
+		finalized = false;
+
+		Region::unlock();
+
+		if (Region::erase()) {
+			return true;
+		} else {
+			Region::lock();
+			return false;
+		}
+	}
+
+	bool finalizeWrite(uint32_t aTotal) override
+	{
+		if (aTotal == kFileReservedPosition) {
+			aTotal = 0;
+		}
+
+		if (finalized || static_cast<size_t>(aTotal) != received) {
+			return false;
+		}
+
+		const bool result = decoder.finalize();
+
+		Region::lock();
+		finalized = result;
+		return result;
+	}
+
+	bool isFinalized() const override
+	{
+		return finalized;
+	}
+
+protected:
+	Decoder decoder;
+	size_t received;
+	bool finalized;
+};
+
+} // namespace Device
+
+#endif // DRONEDEVICE_INTERNALDEVICE_STREAMFILE_HPP_
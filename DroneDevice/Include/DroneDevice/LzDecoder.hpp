@@ -0,0 +1,330 @@
+//
+// LzDecoder.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_LZDECODER_HPP_
+#define DRONEDEVICE_LZDECODER_HPP_
+
+#include <DroneDevice/FastCrc32.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+//!
+//! Header of a compressed stream, followed by LZ4-style sequences. Each sequence is a token with
+//! the literal length in the high nibble and the match length minus kMinMatch in the low nibble,
+//! nibbles equal to 15 are extended with bytes until a byte other than 255. The token is followed
+//! by literals, a 16-bit little-endian match offset and match length extension. The stream ends
+//! as soon as @b size bytes are produced, so the last sequence usually has no match.
+//!
+struct LzHeader {
+	static constexpr uint32_t kMagic{0x57465A4C}; // LZFW
+	static constexpr size_t kMinMatch{4};
+
+	uint32_t magic;
+	uint32_t size; //!< Length of the decompressed data
+	uint32_t crc; //!< CRC32 of the decompressed data
+	uint8_t windowBits; //!< Maximum match offset is 2 ^ windowBits
+	uint8_t reserved[3];
+};
+
+static_assert(sizeof(LzHeader) == 16, "Incorrect header layout");
+
+//!
+//! Streaming decompressor with a fixed window. Compressed data is fed in chunks of any length,
+//! decompressed data is collected in the window and passed to the sink by halves of the window,
+//! so the sink always receives aligned blocks, except for the last one, which is padded with
+//! the erased value. The window also serves as the history for matches, no other memory is used.
+//! \tparam Crc CRC32 implementation used for the decompressed data.
+//!
+template<typename Crc = FastCrc32>
+class LzDecoder {
+	static constexpr size_t kAlignment{sizeof(uint64_t)};
+
+public:
+	//!
+	//! Receiver of decompressed blocks.
+	//! \param position Offset of the block in decompressed data.
+	//! \return True when the block is stored.
+	//!
+	using Sink = std::function<bool (size_t, const void *, size_t)>;
+
+	//!
+	//! Construct the decoder.
+	//! \param window Buffer for the window, should be aligned for the sink.
+	//! \param windowSize Size of the window, should be a power of two, streams with larger windows are rejected.
+	//! \param sink Receiver of decompressed blocks.
+	//!
+	LzDecoder(uint8_t *aWindow, size_t aWindowSize, Sink aSink) :
+		window{aWindow},
+		mask{aWindowSize - 1},
+		half{aWindowSize / 2},
+		sink{aSink}
+	{
+		assert(aWindowSize >= 2 * kAlignment && (aWindowSize & mask) == 0);
+		reset();
+	}
+
+	LzDecoder(const LzDecoder &) = delete;
+	LzDecoder &operator=(const LzDecoder &) = delete;
+
+	void reset()
+	{
+		state = State::Header;
+		received = 0;
+		produced = 0;
+		flushed = 0;
+		crc = 0;
+	}
+
+	//!
+	//! Decompress the next chunk of the stream.
+	//! \return False when the stream is malformed or the sink failed, following calls fail too.
+	//!
+	bool update(const void *aData, size_t aLength)
+	{
+		const uint8_t *input = static_cast<const uint8_t *>(aData);
+		const uint8_t * const end = input + aLength;
+
+		while (input != end) {
+			switch (state) {
+				case State::Header: {
+					const size_t length = std::min(sizeof(header) - received, static_cast<size_t>(end - input));
+
+					memcpy(reinterpret_cast<uint8_t *>(&header) + received, input, length);
+					received += length;
+					input += length;
+
+					if (received == sizeof(header)) {
+						if (header.magic != LzHeader::kMagic || header.windowBits >= 32
+								|| (1UL << header.windowBits) > mask + 1) {
+							state = State::Error;
+						} else {
+							state = header.size ? State::Token : State::Done;
+						}
+					}
+					break;
+				}
+
+				case State::Token: {
+					const uint8_t token = *input++;
+
+					literals = token >> 4;
+					match = (token & 0x0F) + LzHeader::kMinMatch;
+
+					if (literals == 0x0F) {
+						state = State::LiteralLength;
+					} else if (literals) {
+						state = checkLiterals();
+					} else {
+						state = State::OffsetLow;
+					}
+					break;
+				}
+
+				case State::LiteralLength: {
+					const uint8_t value = *input++;
+
+					literals += value;
+
+					if (literals > header.size - produced) {
+						state = State::Error;
+					} else if (value != 0xFF) {
+						state = State::Literals;
+					}
+					break;
+				}
+
+				case State::Literals: {
+					// Copy up to the end of the current half, the half is flushed before it is overwritten
+					const size_t length = std::min({static_cast<size_t>(literals), static_cast<size_t>(end - input),
+						half - (produced & (half - 1))});
+
+					memcpy(window + (produced & mask), input, length);
+					input += length;
+					produced += length;
+					literals -= static_cast<uint32_t>(length);
+
+					if (!flushCompleted()) {
+						state = State::Error;
+					} else if (!literals) {
+						state = produced == header.size ? State::Done : State::OffsetLow;
+					}
+					break;
+				}
+
+				case State::OffsetLow:
+					offset = *input++;
+					state = State::OffsetHigh;
+					break;
+
+				case State::OffsetHigh:
+					offset |= static_cast<size_t>(*input++) << 8;
+
+					if (match == LzHeader::kMinMatch + 0x0F) {
+						state = State::MatchLength;
+					} else {
+						state = copyMatch();
+					}
+					break;
+
+				case State::MatchLength: {
+					const uint8_t value = *input++;
+
+					match += value;
+
+					if (match > header.size - produced) {
+						state = State::Error;
+					} else if (value != 0xFF) {
+						state = copyMatch();
+					}
+					break;
+				}
+
+				default:
+					// Data after the end of the stream or after an error
+					state = State::Error;
+					return false;
+			}
+		}
+
+		return state != State::Error;
+	}
+
+	//!
+	//! Flush the rest of decompressed data and check the CRC.
+	//! \return True when the whole stream is received and decompressed data matches the header.
+	//!
+	bool finalize()
+	{
+		if (state != State::Done) {
+			state = State::Error;
+			return false;
+		}
+
+		const size_t remaining = produced - flushed;
+
+		if (remaining) {
+			// Halves are multiples of the alignment, so the padding does not leave the current half
+			uint8_t * const block = window + (flushed & mask);
+			const size_t length = (remaining + kAlignment - 1) / kAlignment * kAlignment;
+
+			crc = Crc::update(crc, block, remaining);
+			std::fill(block + remaining, block + length, 0xFF);
+
+			if (!sink(flushed, block, length)) {
+				state = State::Error;
+				return false;
+			}
+
+			flushed = produced;
+		}
+
+		return crc == header.crc;
+	}
+
+	bool isComplete() const
+	{
+		return state == State::Done;
+	}
+
+	//!
+	//! Length of decompressed data passed to the sink.
+	//!
+	size_t getFlushed() const
+	{
+		return flushed;
+	}
+
+	//!
+	//! CRC32 of decompressed data passed to the sink.
+	//!
+	uint32_t getChecksum() const
+	{
+		return crc;
+	}
+
+private:
+	enum class State {
+		Header,
+		Token,
+		LiteralLength,
+		Literals,
+		OffsetLow,
+		OffsetHigh,
+		MatchLength,
+		Done,
+		Error
+	};
+
+	uint8_t * const window;
+	const size_t mask;
+	const size_t half;
+	Sink sink;
+
+	LzHeader header;
+	State state;
+	size_t received;
+	size_t produced;
+	size_t flushed;
+	size_t offset;
+	uint32_t literals;
+	uint32_t match;
+	uint32_t crc;
+
+	State checkLiterals() const
+	{
+		return literals > header.size - produced ? State::Error : State::Literals;
+	}
+
+	bool flushCompleted()
+	{
+		if (produced - flushed < half) {
+			return true;
+		}
+
+		const uint8_t * const block = window + (flushed & mask);
+
+		crc = Crc::update(crc, block, half);
+
+		if (!sink(flushed, block, half)) {
+			return false;
+		}
+
+		flushed += half;
+		return true;
+	}
+
+	State copyMatch()
+	{
+		if (!offset || offset > produced || offset > mask + 1 || match > header.size - produced) {
+			return State::Error;
+		}
+
+		while (match) {
+			// Source and destination may overlap, bytes are copied one by one
+			const size_t length = std::min(static_cast<size_t>(match), half - (produced & (half - 1)));
+			const size_t source = produced - offset;
+
+			for (size_t i = 0; i < length; ++i) {
+				window[(produced + i) & mask] = window[(source + i) & mask];
+			}
+
+			produced += length;
+			match -= static_cast<uint32_t>(length);
+
+			if (!flushCompleted()) {
+				return State::Error;
+			}
+		}
+
+		return produced == header.size ? State::Done : State::Token;
+	}
+};
+
+#endif // DRONEDEVICE_LZDECODER_HPP_
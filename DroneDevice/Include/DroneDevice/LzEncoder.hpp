@@ -0,0 +1,124 @@
+//
+// LzEncoder.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_LZENCODER_HPP_
+#define DRONEDEVICE_LZENCODER_HPP_
+
+#include <DroneDevice/FastCrc32.hpp>
+#include <DroneDevice/LzDecoder.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+//!
+//! Compressor for streams of LzDecoder, intended for host tools and tests.
+//! Matches are searched with a single-entry hash table, which gives ratios close to LZ4.
+//! \tparam Crc CRC32 implementation used for the header.
+//!
+template<typename Crc = FastCrc32>
+class LzEncoder {
+	static constexpr unsigned int kHashBits{14};
+
+public:
+	LzEncoder() = delete;
+	LzEncoder(const LzEncoder &) = delete;
+	LzEncoder &operator=(const LzEncoder &) = delete;
+
+	//!
+	//! Compress the data.
+	//! \param windowBits Logarithm of the window size, should not exceed the window of the decoder
+	//! and 15 because of 16-bit offsets.
+	//! \return Stream with the header.
+	//!
+	static std::vector<uint8_t> compress(const void *aData, size_t aLength, unsigned int aWindowBits = 11)
+	{
+		assert(aWindowBits <= 15);
+
+		const uint8_t * const data = static_cast<const uint8_t *>(aData);
+		const size_t window = static_cast<size_t>(1) << aWindowBits;
+		std::vector<uint8_t> stream(sizeof(LzHeader));
+		std::vector<size_t> table(static_cast<size_t>(1) << kHashBits, SIZE_MAX);
+
+		LzHeader header;
+		memset(&header, 0, sizeof(header));
+		header.magic = LzHeader::kMagic;
+		header.size = static_cast<uint32_t>(aLength);
+		header.crc = Crc::update(0, data, aLength);
+		header.windowBits = static_cast<uint8_t>(aWindowBits);
+		memcpy(stream.data(), &header, sizeof(header));
+
+		size_t anchor = 0;
+		size_t position = 0;
+
+		while (position + LzHeader::kMinMatch <= aLength) {
+			uint32_t value;
+			memcpy(&value, data + position, sizeof(value));
+
+			const uint32_t hash = static_cast<uint32_t>(value * 2654435761U) >> (32 - kHashBits);
+			const size_t candidate = table[hash];
+
+			table[hash] = position;
+
+			if (candidate == SIZE_MAX || position - candidate > window
+					|| memcmp(data + candidate, data + position, LzHeader::kMinMatch) != 0) {
+				++position;
+				continue;
+			}
+
+			size_t length = LzHeader::kMinMatch;
+			while (position + length < aLength && data[candidate + length] == data[position + length]) {
+				++length;
+			}
+
+			emit(stream, data + anchor, position - anchor, position - candidate, length);
+			position += length;
+			anchor = position;
+		}
+
+		if (anchor < aLength) {
+			emit(stream, data + anchor, aLength - anchor, 0, 0);
+		}
+
+		return stream;
+	}
+
+private:
+	static void emitLength(std::vector<uint8_t> &aStream, size_t aValue)
+	{
+		while (aValue >= 0xFF) {
+			aStream.push_back(0xFF);
+			aValue -= 0xFF;
+		}
+		aStream.push_back(static_cast<uint8_t>(aValue));
+	}
+
+	static void emit(std::vector<uint8_t> &aStream, const uint8_t *aLiterals, size_t aCount, size_t aOffset,
+		size_t aMatch)
+	{
+		const size_t matchCode = aMatch ? aMatch - LzHeader::kMinMatch : 0;
+
+		aStream.push_back(static_cast<uint8_t>((std::min<size_t>(aCount, 0x0F) << 4) | std::min<size_t>(matchCode, 0x0F)));
+
+		if (aCount >= 0x0F) {
+			emitLength(aStream, aCount - 0x0F);
+		}
+		aStream.insert(aStream.end(), aLiterals, aLiterals + aCount);
+
+		if (aMatch) {
+			aStream.push_back(static_cast<uint8_t>(aOffset));
+			aStream.push_back(static_cast<uint8_t>(aOffset >> 8));
+
+			if (matchCode >= 0x0F) {
+				emitLength(aStream, matchCode - 0x0F);
+			}
+		}
+	}
+};
+
+#endif // DRONEDEVICE_LZENCODER_HPP_
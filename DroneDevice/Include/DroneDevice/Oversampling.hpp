@@ -0,0 +1,77 @@
+//
+// Oversampling.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_OVERSAMPLING_HPP_
+#define DRONEDEVICE_OVERSAMPLING_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+//!
+//! Averaging of interleaved ADC samples in place. The buffer contains sequences of samples
+//! of all channels, each group of @b ratio consecutive sequences is replaced with a single
+//! sequence of rounded averages, results are placed at the beginning of the buffer.
+//! \tparam channels Number of channels in a sequence.
+//! \tparam ratio Number of sequences averaged into one, should be a power of two.
+//!
+template<size_t channels, size_t ratio>
+class Oversampling {
+	static_assert(channels > 0, "Incorrect channel count");
+	static_assert(ratio > 0 && (ratio & (ratio - 1)) == 0, "Ratio should be a power of two");
+	static_assert(ratio <= 65536, "Sum of samples may overflow");
+
+public:
+	Oversampling() = delete;
+	Oversampling(const Oversampling &) = delete;
+	Oversampling &operator=(const Oversampling &) = delete;
+
+	//!
+	//! Average samples in the buffer.
+	//! \param buffer Buffer with interleaved samples.
+	//! \param length Number of samples, should be a multiple of @b channels * @b ratio.
+	//! \return Number of averaged samples at the beginning of the buffer.
+	//!
+	static size_t reduce(uint16_t *aBuffer, size_t aLength)
+	{
+		assert(aLength % (channels * ratio) == 0);
+
+		if (ratio == 1) {
+			return aLength;
+		}
+
+		const uint16_t *input = aBuffer;
+		uint16_t *output = aBuffer;
+
+		for (size_t group = 0; group < aLength / (channels * ratio); ++group) {
+			uint32_t sums[channels] = {};
+
+			for (size_t sequence = 0; sequence < ratio; ++sequence) {
+				for (size_t channel = 0; channel < channels; ++channel) {
+					sums[channel] += *input++;
+				}
+			}
+
+			// Output never overtakes input, so the samples are overwritten after they are read
+			for (size_t channel = 0; channel < channels; ++channel) {
+				*output++ = static_cast<uint16_t>((sums[channel] + kRounding) >> kShift);
+			}
+		}
+
+		return aLength / ratio;
+	}
+
+private:
+	static constexpr unsigned int log2(size_t aValue)
+	{
+		return aValue > 1 ? 1 + log2(aValue >> 1) : 0;
+	}
+
+	static constexpr unsigned int kShift{log2(ratio)};
+	static constexpr uint32_t kRounding{ratio >> 1};
+};
+
+#endif // DRONEDEVICE_OVERSAMPLING_HPP_
@@ -0,0 +1,27 @@
+//
+// PlatformCrc32.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_PLATFORMCRC32_HPP_
+#define DRONEDEVICE_PLATFORMCRC32_HPP_
+
+#if defined(__has_include)
+#if __has_include(<Platform/HwCrc32.hpp>)
+#define DRONEDEVICE_PLATFORM_CRC32
+#include <Platform/HwCrc32.hpp>
+#endif
+#endif
+
+//!
+//! Default CRC32 of the library. Platforms with a CRC calculation unit define PlatformCrc32
+//! next to HwCrc32, the table algorithm is used on other platforms and on the build host.
+//!
+#ifndef DRONEDEVICE_PLATFORM_CRC32
+#include <DroneDevice/FastCrc32.hpp>
+
+using PlatformCrc32 = FastCrc32;
+#endif
+
+#endif // DRONEDEVICE_PLATFORMCRC32_HPP_
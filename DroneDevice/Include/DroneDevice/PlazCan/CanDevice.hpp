@@ -59,6 +59,17 @@ struct Status {
 	}
 };
 
+//!
+//! Detailed usage of the memory pool of libcanard.
+//!
+struct PoolTelemetry {
+	CanardPoolAllocatorStatistics statistics;
+	CanardPoolAllocatorUsage usage;
+	uint32_t failures; //!< Failed allocations of all purposes
+	std::chrono::microseconds firstFailure; //!< Time of the first failed allocation, zero when there were none
+	std::chrono::microseconds lastFailure; //!< Time of the last failed allocation, zero when there were none
+};
+
 class CanDevice {
 public:
 	virtual ~CanDevice() = default;
@@ -68,7 +79,6 @@ public:
 	virtual bool onAcceptanceRequest(uint16_t aDataTypeId, CanardTransferType aTransferType,
 		Device::DeviceId aSourceNodeId, Device::DeviceId aDestinationNodeId) = 0;
 	virtual void onMessageReceived(const CanardRxTransfer *aTransfer) = 0;
-	virtual std::chrono::microseconds onTimeoutOccurred() = 0;
 };
 } // namespace PlazCan
 
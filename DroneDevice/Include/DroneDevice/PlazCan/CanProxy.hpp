@@ -31,6 +31,7 @@ class CanProxy: public Device::AbstractDevice, public CanDevice {
 	using PlatformType = typename HandlerType::PlatformType;
 	using MutexType = typename PlatformType::MutexType;
 	using TimeType = typename PlatformType::TimeType;
+	using TimerType = typename HandlerType::Timer;
 
 public:
 	CanProxy() :
@@ -39,7 +40,8 @@ public:
 		mutex{},
 		nextRequestTime{microseconds::max()},
 		retries{0},
-		info{}
+		info{},
+		timer{[this]() { onTimerExpired(); }}
 	{
 	}
 
@@ -49,7 +51,8 @@ public:
 		mutex{},
 		nextRequestTime{TimeType::microseconds()},
 		retries{kMaxRetries},
-		info{TimeType::microseconds(), aAddress, aStatus}
+		info{TimeType::microseconds(), aAddress, aStatus},
+		timer{[this]() { onTimerExpired(); }}
 	{
 	}
 
@@ -60,6 +63,10 @@ public:
 		purgeRequestDescriptors();
 		delete feature;
 
+		if (master != nullptr) {
+			master->getTimers().cancel(timer);
+		}
+
 		// TODO Rewrite
 		master = aProxy.master;
 		feature = aProxy.feature;
@@ -69,6 +76,10 @@ public:
 		state = State::REQUEST_NODE_INFO;
 		numbers = Numbers{};
 
+		if (master != nullptr) {
+			wakeUp();
+		}
+
 		return *this;
 	}
 
@@ -124,7 +135,7 @@ public:
 				if (request != nullptr) {
 					const GetFieldInfoRequest payload{static_cast<uint8_t>(aField)};
 
-					requests.pushBack(request);
+					pushRequestDescriptor(request);
 					master->sendCanServiceRequest(info.address, DataType::Service::GET_FIELD_INFO,
 						&numbers.getFieldInfo, &payload, sizeof(payload));
 				} else {
@@ -161,7 +172,7 @@ public:
 				if (request != nullptr) {
 					const FieldReadRequest payload{static_cast<uint8_t>(aField)};
 
-					requests.pushBack(request);
+					pushRequestDescriptor(request);
 					master->sendCanServiceRequest(info.address, DataType::Service::FIELD_READ,
 						&numbers.fieldRead, &payload, sizeof(payload));
 				} else {
@@ -201,7 +212,7 @@ public:
 					const FieldWriteRequest<Device::kFieldMaxSize> payload{static_cast<uint8_t>(aField), aBuffer,
 						fieldSize};
 
-					requests.pushBack(request);
+					pushRequestDescriptor(request);
 					master->sendCanServiceRequest(info.address, DataType::Service::FIELD_WRITE,
 						&numbers.fieldWrite, &payload, sizeof(FieldWriteRequest<0>) + fieldSize);
 				} else {
@@ -240,7 +251,7 @@ public:
 			if (request != nullptr) {
 				const GetFileInfoRequest payload{static_cast<uint8_t>(aFile), static_cast<uint8_t>(aFlags)};
 
-				requests.pushBack(request);
+				pushRequestDescriptor(request);
 				master->sendCanServiceRequest(info.address, DataType::Service::GET_FILE_INFO,
 					&numbers.getFileInfo, &payload, sizeof(payload));
 			} else {
@@ -271,7 +282,7 @@ public:
 			if (request != nullptr) {
 				const FileReadRequest payload{static_cast<uint8_t>(aFile), aOffset, static_cast<uint8_t>(aSize)};
 
-				requests.pushBack(request);
+				pushRequestDescriptor(request);
 				master->sendCanServiceRequest(info.address, DataType::Service::FILE_READ,
 					&numbers.fileRead, &payload, sizeof(payload));
 			} else {
@@ -303,7 +314,7 @@ public:
 				const FileWriteRequest<Device::kFileMaxChunkLength> payload{
 					static_cast<uint8_t>(aFile), aOffset, aBuffer, aSize};
 
-				requests.pushBack(request);
+				pushRequestDescriptor(request);
 				master->sendCanServiceRequest(info.address, DataType::Service::FILE_WRITE,
 					&numbers.fileWrite, &payload, sizeof(FileWriteRequest<0>) + aSize);
 			} else {
@@ -395,6 +406,8 @@ public:
 			return;
 		}
 
+		const bool initializing = isUninitialized();
+
 		if (aTransfer->transfer_type == CanardTransferTypeResponse
 			&& aTransfer->destination_node_id == master->getBusAddress()) {
 			processServiceResponse(aTransfer);
@@ -404,70 +417,14 @@ public:
 
 		if (feature != nullptr) {
 			feature->onMessageReceived(aTransfer);
-		}
-	}
-
-	microseconds onTimeoutOccurred() override
-	{
-		assert(isValid());
-
-		// Remove timed out descriptors
-		const auto currentTime = TimeType::microseconds();
-		auto nextWakeTime = purgeTimedOutDescriptors(currentTime);
-
-		// Handle node disabling
-		if (currentTime >= info.timestamp + Master::kOfflineTimeout && info.status.mode != Mode::OFFLINE) {
-			info.status.mode = Mode::OFFLINE;
-
-			if (feature != nullptr) {
-				feature->onNodeStatusReceived(info.status, info.uptime);
-			}
-		}
-
-		// Handle device initialization logic
-		if ((state != State::IDLE && state != State::ERROR) && this == master->getNextUninitializedNode()
-			&& currentTime >= nextRequestTime) {
-			switch (state) {
-				case State::REQUEST_NODE_INFO: {
-					if (retries > 0) {
-						--retries;
-						sendGetNodeInfo();
-					} else {
-						state = State::ERROR;
-					}
-					break;
-				}
-				case State::REQUEST_FIELDS: {
-					if (retries > 0) {
-						--retries;
-						sendGetFieldInfo(info.fields);
-					} else {
-						// Initialization is incomplete, just forward the device
-						state = State::IDLE;
-						master->onDeviceReady(this);
-					}
-					break;
-				}
-				default:
-					break;
-			}
 
-			nextRequestTime = currentTime + Master::kRequestTimeout;
-			if (nextRequestTime < nextWakeTime) {
-				nextWakeTime = nextRequestTime;
-			}
+			// Deadlines of the feature may change after any message
+			wakeUp();
 		}
 
-		// Handle special node features
-		if (feature != nullptr) {
-			const auto nextFeatureTime = feature->onTimeoutOccurred();
-
-			if (nextFeatureTime < nextWakeTime) {
-				nextWakeTime = nextFeatureTime;
-			}
+		if (initializing && !isUninitialized()) {
+			master->wakeUninitializedNode();
 		}
-
-		return nextWakeTime;
 	}
 
 	// Custom functions
@@ -510,6 +467,18 @@ public:
 	{
 		delete feature;
 		feature = aFeature;
+
+		if (master != nullptr) {
+			wakeUp();
+		}
+	}
+
+	//!
+	//! Process timeouts of the proxy during the next poll of the timers.
+	//!
+	void wakeUp()
+	{
+		master->getTimers().arm(timer, TimeType::microseconds());
 	}
 
 	void sendCanMessage(uint16_t aDataTypeId, uint8_t *aTransferId, const void *aData, size_t aLength)
@@ -584,6 +553,9 @@ private:
 	Device::RequestPool<ProxyRequestDescriptor, maxRequestCount> pool{};
 	List<ProxyRequestDescriptor *, maxRequestCount> requests{};
 
+	//! Single timer for all timeouts of the node, armed at the earliest of them
+	TimerType timer;
+
 	ProxyRequestDescriptor *findRequestDescriptor(uint16_t aDataTypeId, uint8_t aTransferId)
 	{
 		mutex.lock();
@@ -601,6 +573,107 @@ private:
 		return iter != nullptr ? **iter : nullptr;
 	}
 
+	void onTimerExpired()
+	{
+		assert(isValid());
+
+		const auto currentTime = TimeType::microseconds();
+		const bool initializing = isUninitialized();
+
+		// Remove timed out descriptors
+		auto nextWakeTime = purgeTimedOutDescriptors(currentTime);
+
+		// Handle node removal, the proxy is reset by the master
+		const microseconds purgeTimeout = master->getPurgeTimeout();
+
+		if (purgeTimeout.count() != 0) {
+			const auto purgeTime = info.timestamp + purgeTimeout;
+
+			if (currentTime > purgeTime) {
+				master->purge(this);
+				return;
+			}
+
+			if (purgeTime < nextWakeTime) {
+				nextWakeTime = purgeTime;
+			}
+		}
+
+		// Handle node disabling
+		if (info.status.mode != Mode::OFFLINE) {
+			const auto offlineTime = info.timestamp + Master::kOfflineTimeout;
+
+			if (currentTime >= offlineTime) {
+				info.status.mode = Mode::OFFLINE;
+
+				if (feature != nullptr) {
+					feature->onNodeStatusReceived(info.status, info.uptime);
+				}
+			} else if (offlineTime < nextWakeTime) {
+				nextWakeTime = offlineTime;
+			}
+		}
+
+		// Handle device initialization logic, nodes waiting for their turn are woken up by the master
+		if (initializing && this == master->getNextUninitializedNode()) {
+			if (currentTime >= nextRequestTime) {
+				switch (state) {
+					case State::REQUEST_NODE_INFO: {
+						if (retries > 0) {
+							--retries;
+							sendGetNodeInfo();
+						} else {
+							state = State::ERROR;
+						}
+						break;
+					}
+					case State::REQUEST_FIELDS: {
+						if (retries > 0) {
+							--retries;
+							sendGetFieldInfo(info.fields);
+						} else {
+							// Initialization is incomplete, just forward the device
+							state = State::IDLE;
+							master->onDeviceReady(this);
+						}
+						break;
+					}
+					default:
+						break;
+				}
+
+				nextRequestTime = currentTime + Master::kRequestTimeout;
+			}
+
+			if (isUninitialized()) {
+				if (nextRequestTime < nextWakeTime) {
+					nextWakeTime = nextRequestTime;
+				}
+			} else {
+				master->wakeUninitializedNode();
+			}
+		}
+
+		// Handle special node features
+		if (feature != nullptr) {
+			const auto nextFeatureTime = feature->onTimeoutOccurred();
+
+			if (nextFeatureTime < nextWakeTime) {
+				nextWakeTime = nextFeatureTime;
+			}
+		}
+
+		if (nextWakeTime != microseconds::max()) {
+			master->getTimers().armEarlier(timer, nextWakeTime);
+		}
+	}
+
+	void pushRequestDescriptor(ProxyRequestDescriptor *aDescriptor)
+	{
+		requests.pushBack(aDescriptor);
+		master->getTimers().armEarlier(timer, aDescriptor->deadline);
+	}
+
 	void invokeObserverCallback(const ProxyRequestDescriptor *aDescriptor, CallbackResult aResult)
 	{
 		if (aDescriptor->observer == nullptr) {
@@ -744,7 +817,7 @@ private:
 		if (request != nullptr) {
 			const GetFieldInfoRequest payload{static_cast<uint8_t>(aField)};
 
-			requests.pushBack(request);
+			pushRequestDescriptor(request);
 			master->sendCanServiceRequest(info.address, DataType::Service::GET_FIELD_INFO,
 				&numbers.getFieldInfo, &payload, sizeof(payload));
 		}
@@ -1230,6 +1303,13 @@ private:
 			info.uptime = seconds{packet.uptime_sec};
 			info.timestamp = TimeType::microseconds();
 
+			// Timer may be idle when the node has been offline
+			const microseconds purgeTimeout = master->getPurgeTimeout();
+			const auto statusTimeout = purgeTimeout.count() != 0 && purgeTimeout < Master::kOfflineTimeout ?
+				purgeTimeout : microseconds{Master::kOfflineTimeout};
+
+			master->getTimers().armEarlier(timer, info.timestamp + statusTimeout);
+
 			if (feature != nullptr) {
 				feature->onNodeStatusReceived(info.status, info.uptime);
 			}
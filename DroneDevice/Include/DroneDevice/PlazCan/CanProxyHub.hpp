@@ -102,12 +102,6 @@ public:
 		Component::onMessageReceived(aTransfer);
 	}
 
-	microseconds onTimeoutOccurred() override
-	{
-		purgeOfflineNodes();
-		return Component::onTimeoutOccurred();
-	}
-
 	// TODO Access, make proxy a friend?
 	void onDeviceReady(ProxyType *aProxy)
 	{
@@ -124,31 +118,50 @@ public:
 		return iter != proxies.end() ? &(*iter) : nullptr;
 	}
 
+	typename HandlerType::TimerWheelType &getTimers()
+	{
+		return handler.getTimers();
+	}
+
+	//!
+	//! Let the next node in the initialization queue send its requests, called when
+	//! the current node finishes the initialization or is removed.
+	//!
+	void wakeUninitializedNode()
+	{
+		auto * const proxy = getNextUninitializedNode();
+
+		if (proxy != nullptr) {
+			proxy->wakeUp();
+		}
+	}
+
 	void purge(const UidType &aUid)
 	{
 		for (auto &entry : proxies) {
 			if (entry.getUID() == aUid) {
-				if (observer != nullptr) {
-					observer->onDeviceDetached(entry.getUID());
-				}
-
-				handler.detach(&entry);
-				entry = ProxyType{};
+				purge(&entry);
 				break;
 			}
 		}
 	}
 
+	void purge(ProxyType *aProxy)
+	{
+		if (observer != nullptr) {
+			observer->onDeviceDetached(aProxy->getUID());
+		}
+
+		handler.detach(aProxy);
+		*aProxy = ProxyType{};
+		wakeUninitializedNode();
+	}
+
 	void purge()
 	{
 		for (auto &entry : proxies) {
 			if (entry.isValid()) {
-				if (observer != nullptr) {
-					observer->onDeviceDetached(entry.getUID());
-				}
-
-				handler.detach(&entry);
-				entry = ProxyType{};
+				purge(&entry);
 			}
 		}
 	}
@@ -160,12 +173,7 @@ public:
 
 			for (auto &entry : proxies) {
 				if (entry.isValid() && entry.getLastStatusTime() < minStatusTime) {
-					if (observer != nullptr) {
-						observer->onDeviceDetached(entry.getUID());
-					}
-
-					handler.detach(&entry);
-					entry = ProxyType{};
+					purge(&entry);
 				}
 			}
 		}
@@ -177,9 +185,24 @@ public:
 		allocation.first = aAddress;
 	}
 
+	milliseconds getPurgeTimeout() const
+	{
+		return timeout;
+	}
+
+	//!
+	//! Set the time after the last status message when the node is removed,
+	//! zero timeout disables the removal. Proxies remove themselves when their timers expire.
+	//!
 	void setPurgeTimeout(milliseconds aTimeout)
 	{
 		timeout = aTimeout;
+
+		for (auto &entry : proxies) {
+			if (entry.isValid()) {
+				entry.wakeUp();
+			}
+		}
 	}
 
 	void sendCanMessage(uint16_t aDataTypeId, uint8_t *aTransferId, const void *aData, size_t aLength)
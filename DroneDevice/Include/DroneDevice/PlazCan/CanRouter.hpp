@@ -0,0 +1,400 @@
+//
+// CanRouter.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_PLAZCAN_CANROUTER_HPP_
+#define DRONEDEVICE_PLAZCAN_CANROUTER_HPP_
+
+#include <DroneDevice/Can.hpp>
+#include <algorithm>
+#include <array>
+#include <functional>
+
+namespace PlazCan {
+
+//!
+//! Interface of a CAN controller used by CanRouter.
+//!
+class CanInterface {
+public:
+	virtual ~CanInterface() = default;
+	virtual CanStatistics getStatistics() const = 0;
+	virtual size_t read(CanMessage *aBuffer, size_t aLength) = 0;
+	virtual size_t write(const CanMessage *aBuffer, size_t aLength) = 0;
+};
+
+//!
+//! Adapter for platform drivers of CAN controllers.
+//!
+template<typename Bus>
+class CanInterfaceAdapter : public CanInterface {
+public:
+	explicit CanInterfaceAdapter(Bus &aBus) :
+		bus{aBus}
+	{
+	}
+
+	CanStatistics getStatistics() const override
+	{
+		return bus.getStatistics();
+	}
+
+	size_t read(CanMessage *aBuffer, size_t aLength) override
+	{
+		return bus.read(aBuffer, aLength);
+	}
+
+	size_t write(const CanMessage *aBuffer, size_t aLength) override
+	{
+		return bus.write(aBuffer, aLength);
+	}
+
+	Bus &bus;
+};
+
+struct CanRouterStatistics {
+	uint64_t rx; //!< Frames delivered to the protocol stack
+	uint64_t tx; //!< Frames accepted by the controller
+	uint64_t duplicates; //!< Frames of transfers which were received earlier from another interface
+	uint64_t bridged; //!< Frames forwarded from other interfaces
+	uint64_t dropped; //!< Frames rejected by the controller because of a full queue
+};
+
+//!
+//! Router for nodes with several CAN interfaces, it is used as the bus of UavCanHandler.
+//! Frames received from redundant interfaces are delivered once: each transfer is accepted from the interface
+//! which delivered its first frame, frames of the same transfer from other interfaces are discarded.
+//! Transmitted frames are written to all or to selected interfaces, each controller keeps its own queue,
+//! so a failed interface does not block other interfaces. Routes forward selected data types between buses.
+//! Interfaces are attached at run time, all methods must be called from the same context.
+//!
+template<size_t maxInterfaces = 2, size_t sessionCount = 64, size_t maxRoutes = 8>
+class CanRouter {
+	static_assert(maxInterfaces >= 1 && maxInterfaces <= 32, "Incorrect interface count");
+	static_assert(sessionCount >= 4 && (sessionCount & (sessionCount - 1)) == 0, "Session count must be a power of two");
+
+	static constexpr size_t kBatchSize{8};
+	static constexpr size_t kProbeCount{4};
+	static constexpr uint64_t kSessionTimeout{2000000}; //!< Transfer timeout of libcanard in microseconds
+
+	static constexpr uint32_t kIdMask{0x1FFFFFFFUL};
+	static constexpr uint32_t kServiceFlag{0x00000080UL};
+
+	static constexpr uint8_t kStartOfTransfer{0x80};
+	static constexpr uint8_t kTransferIdMask{0x1F};
+
+	struct Session {
+		uint32_t id;
+		uint64_t time;
+		uint8_t transferId;
+		uint8_t interface;
+		bool used;
+	};
+
+	struct Route {
+		CanFilter filter;
+		uint32_t sources;
+		uint32_t targets;
+	};
+
+	CanRouter(const CanRouter &) = delete;
+	CanRouter &operator=(const CanRouter &) = delete;
+
+public:
+	using Receiver = std::function<void (const CanMessage *, size_t)>;
+
+	static constexpr uint32_t kAllInterfaces{maxInterfaces == 32 ? 0xFFFFFFFFUL : (1UL << maxInterfaces) - 1};
+
+	CanRouter(Receiver aReceiver = nullptr) :
+		interfaces{},
+		stats{},
+		sessions{},
+		routes{},
+		receiver{aReceiver},
+		routeCount{0},
+		transmitMask{kAllInterfaces}
+	{
+	}
+
+	//!
+	//! Attach an interface.
+	//! \return Index of the interface or -1 when there are no free slots.
+	//!
+	int attach(CanInterface &aInterface)
+	{
+		auto iter = std::find(interfaces.begin(), interfaces.end(), nullptr);
+
+		if (iter == interfaces.end()) {
+			return -1;
+		}
+
+		const auto index = static_cast<size_t>(iter - interfaces.begin());
+
+		*iter = &aInterface;
+		stats[index] = CanRouterStatistics{};
+		return static_cast<int>(index);
+	}
+
+	void detach(const CanInterface &aInterface)
+	{
+		auto iter = std::find(interfaces.begin(), interfaces.end(), &aInterface);
+
+		if (iter != interfaces.end()) {
+			const auto index = static_cast<uint8_t>(iter - interfaces.begin());
+
+			*iter = nullptr;
+
+			// Transfers owned by the removed interface continue on other interfaces
+			for (auto &session : sessions) {
+				if (session.used && session.interface == index) {
+					session.used = false;
+				}
+			}
+		}
+	}
+
+	void setCallback(Receiver aReceiver)
+	{
+		receiver = aReceiver;
+	}
+
+	//!
+	//! Select interfaces for transmission of frames written without an explicit mask.
+	//! \param mask Bit mask of interface indices.
+	//!
+	void setTransmitMask(uint32_t aMask)
+	{
+		transmitMask = aMask;
+	}
+
+	//!
+	//! Forward frames of a message type between interfaces.
+	//! \param dataTypeId Identifier of the message type.
+	//! \param sources Bit mask of interfaces where frames are received.
+	//! \param targets Bit mask of interfaces where frames are transmitted, the receiving interface is excluded.
+	//! \return True when the route was added.
+	//!
+	bool addMessageRoute(uint16_t aDataTypeId, uint32_t aSources, uint32_t aTargets)
+	{
+		return addRoute(CanFilter{static_cast<uint32_t>(aDataTypeId) << 8, 0x00FFFF80UL}, aSources, aTargets);
+	}
+
+	//!
+	//! Forward requests and responses of a service type between interfaces.
+	//! \param dataTypeId Identifier of the service type.
+	//! \param sources Bit mask of interfaces where frames are received.
+	//! \param targets Bit mask of interfaces where frames are transmitted, the receiving interface is excluded.
+	//! \return True when the route was added.
+	//!
+	bool addServiceRoute(uint8_t aDataTypeId, uint32_t aSources, uint32_t aTargets)
+	{
+		return addRoute(CanFilter{(static_cast<uint32_t>(aDataTypeId) << 16) | kServiceFlag, 0x00FF0080UL},
+			aSources, aTargets);
+	}
+
+	void clearRoutes()
+	{
+		routeCount = 0;
+	}
+
+	//!
+	//! Read frames from the interface, should be called when the interface has received frames.
+	//! Accepted frames are passed to the receiver directly from the read buffer.
+	//! \param index Index of the interface.
+	//!
+	void receive(size_t aIndex)
+	{
+		if (aIndex >= maxInterfaces || interfaces[aIndex] == nullptr) {
+			return;
+		}
+
+		CanMessage buffer[kBatchSize];
+		size_t count;
+
+		while ((count = interfaces[aIndex]->read(buffer, kBatchSize)) != 0) {
+			size_t first = 0;
+
+			for (size_t i = 0; i < count; ++i) {
+				if (!accept(buffer[i], static_cast<uint8_t>(aIndex))) {
+					++stats[aIndex].duplicates;
+					deliver(buffer + first, i - first, aIndex);
+					first = i + 1;
+				} else if (routeCount) {
+					forward(buffer[i], aIndex);
+				}
+			}
+
+			deliver(buffer + first, count - first, aIndex);
+		}
+	}
+
+	//!
+	//! Aggregated statistics of all interfaces in the format of a single controller.
+	//!
+	CanStatistics getStatistics() const
+	{
+		CanStatistics result{};
+
+		for (size_t i = 0; i < maxInterfaces; ++i) {
+			if (interfaces[i] != nullptr) {
+				const auto controller = interfaces[i]->getStatistics();
+
+				result.rx += stats[i].rx;
+				result.tx += controller.tx;
+				result.errors += controller.errors + stats[i].dropped;
+			}
+		}
+
+		return result;
+	}
+
+	CanRouterStatistics getInterfaceStatistics(size_t aIndex) const
+	{
+		return aIndex < maxInterfaces ? stats[aIndex] : CanRouterStatistics{};
+	}
+
+	size_t write(const CanMessage *aBuffer, size_t aLength)
+	{
+		return write(aBuffer, aLength, transmitMask);
+	}
+
+	//!
+	//! Write frames to selected interfaces.
+	//! \param mask Bit mask of interface indices.
+	//! \return Largest number of frames accepted by one of the interfaces.
+	//!
+	size_t write(const CanMessage *aBuffer, size_t aLength, uint32_t aMask)
+	{
+		size_t result = 0;
+
+		for (size_t i = 0; i < maxInterfaces; ++i) {
+			if ((aMask & (1UL << i)) && interfaces[i] != nullptr) {
+				const size_t count = interfaces[i]->write(aBuffer, aLength);
+
+				stats[i].tx += count;
+				stats[i].dropped += aLength - count;
+				result = std::max(result, count);
+			}
+		}
+
+		return result;
+	}
+
+private:
+	std::array<CanInterface *, maxInterfaces> interfaces;
+	std::array<CanRouterStatistics, maxInterfaces> stats;
+	std::array<Session, sessionCount> sessions;
+	std::array<Route, maxRoutes> routes;
+	Receiver receiver;
+	size_t routeCount;
+	uint32_t transmitMask;
+
+	bool addRoute(CanFilter aFilter, uint32_t aSources, uint32_t aTargets)
+	{
+		if (routeCount >= maxRoutes) {
+			return false;
+		}
+
+		routes[routeCount++] = Route{aFilter, aSources, aTargets};
+		return true;
+	}
+
+	void deliver(const CanMessage *aBuffer, size_t aLength, size_t aIndex)
+	{
+		if (aLength) {
+			stats[aIndex].rx += aLength;
+
+			if (receiver != nullptr) {
+				receiver(aBuffer, aLength);
+			}
+		}
+	}
+
+	void forward(const CanMessage &aMessage, size_t aIndex)
+	{
+		const uint32_t source = 1UL << aIndex;
+
+		for (size_t i = 0; i < routeCount; ++i) {
+			const Route &route = routes[i];
+
+			if ((route.sources & source) && (aMessage.id & route.filter.mask) == route.filter.id) {
+				const uint32_t targets = route.targets & ~source;
+
+				for (size_t target = 0; target < maxInterfaces; ++target) {
+					if ((targets & (1UL << target)) && interfaces[target] != nullptr) {
+						const size_t count = interfaces[target]->write(&aMessage, 1);
+
+						stats[target].bridged += count;
+						stats[target].dropped += 1 - count;
+					}
+				}
+			}
+		}
+	}
+
+	//!
+	//! Check whether the frame belongs to a transfer owned by the interface.
+	//!
+	bool accept(const CanMessage &aMessage, uint8_t aIndex)
+	{
+		if (!aMessage.length || !(aMessage.flags & CanMessage::EXT)) {
+			return true;
+		}
+
+		const uint32_t id = aMessage.id & kIdMask;
+		const uint8_t tail = aMessage.data[aMessage.length - 1];
+		const uint8_t transferId = tail & kTransferIdMask;
+		Session &session = findSession(id);
+
+		if (!session.used || session.id != id) {
+			session = Session{id, aMessage.timestamp, transferId, aIndex, true};
+			return true;
+		}
+
+		// Clocks of controllers are not synchronized, a copy from another interface may have an earlier timestamp
+		const bool stale = aMessage.timestamp > session.time + kSessionTimeout;
+
+		if (session.interface == aIndex
+			|| ((tail & kStartOfTransfer) && (session.transferId != transferId || stale))) {
+			session.interface = aIndex;
+			session.transferId = transferId;
+			session.time = aMessage.timestamp;
+			return true;
+		}
+
+		return false;
+	}
+
+	//!
+	//! Find the session of the identifier or a slot for a new session.
+	//!
+	Session &findSession(uint32_t aId)
+	{
+		const size_t start = static_cast<size_t>((aId * 0x9E3779B1UL) >> 16);
+		Session *candidate = nullptr;
+
+		for (size_t i = 0; i < kProbeCount; ++i) {
+			Session &session = sessions[(start + i) & (sessionCount - 1)];
+
+			if (session.used && session.id == aId) {
+				return session;
+			}
+
+			// Oldest session is replaced when all slots are occupied
+			if (candidate == nullptr || !session.used || (candidate->used && session.time < candidate->time)) {
+				candidate = &session;
+			}
+		}
+
+		return *candidate;
+	}
+};
+
+template<size_t maxInterfaces, size_t sessionCount, size_t maxRoutes>
+constexpr uint32_t CanRouter<maxInterfaces, sessionCount, maxRoutes>::kAllInterfaces;
+
+} // namespace PlazCan
+
+#endif // DRONEDEVICE_PLAZCAN_CANROUTER_HPP_
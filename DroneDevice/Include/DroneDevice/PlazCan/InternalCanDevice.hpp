@@ -52,6 +52,7 @@ protected:
 	using ReloaderType = typename PlatformType::ReloaderType;
 	using RngType = typename PlatformType::RngType;
 	using TimeType = typename PlatformType::TimeType;
+	using TimerType = typename UavCanHandler::Timer;
 
 private:
 	friend class ParamSlave<CurrentType>;
@@ -90,8 +91,10 @@ public:
 		prevAllocationTime{0},
 		nodeStatusPeriod{aNodeStatusPeriod},
 		nodeStatusSent{true},
-		sequences{0, 0}
+		sequences{0, 0, 0},
+		timer{[this]() { onTimerExpired(); }}
 	{
+		handler.getTimers().arm(timer, TimeType::microseconds());
 	}
 
 	Device::DeviceId getBusAddress() const override
@@ -163,37 +166,6 @@ public:
 		}
 	}
 
-	microseconds onTimeoutOccurred() override
-	{
-		microseconds nextWakeTime = microseconds::max();
-		const auto currentTime = TimeType::microseconds();
-
-		if (currentAddress != kAddressUnallocated && nodeStatusPeriod.count() != 0) {
-			if (currentTime >= nextNodeStatusTime) {
-				nextNodeStatusTime = currentTime + nodeStatusPeriod;
-				sendNodeStatus();
-			}
-
-			if (nextWakeTime > nextNodeStatusTime) {
-				nextWakeTime = nextNodeStatusTime;
-			}
-		}
-
-		if (handler.isNextAllocatee(this)) {
-			if (currentTime >= nextAllocationTime) {
-				resetAllocationSequence(currentTime);
-				prevAllocationTime = currentTime;
-				sendAllocationRequest0(desiredAddress);
-			}
-
-			if (nextWakeTime > nextAllocationTime) {
-				nextWakeTime = nextAllocationTime;
-			}
-		}
-
-		return nextWakeTime;
-	}
-
 	uint16_t getFlags() const
 	{
 		return getStatus().flags;
@@ -237,6 +209,10 @@ public:
 	void setNodeStatusPeriod(microseconds aNodeStatusPeriod)
 	{
 		nodeStatusPeriod = aNodeStatusPeriod;
+
+		if (nodeStatusPeriod.count() != 0) {
+			handler.getTimers().armEarlier(timer, nextNodeStatusTime);
+		}
 	}
 
 protected:
@@ -262,8 +238,47 @@ private:
 	struct {
 		uint8_t allocation;
 		uint8_t status;
+		uint8_t telemetry;
 	} sequences;
 
+	TimerType timer;
+
+	void onTimerExpired()
+	{
+		microseconds nextWakeTime = microseconds::max();
+		const auto currentTime = TimeType::microseconds();
+
+		if (currentAddress != kAddressUnallocated && nodeStatusPeriod.count() != 0) {
+			if (currentTime >= nextNodeStatusTime) {
+				nextNodeStatusTime = currentTime + nodeStatusPeriod;
+				sendNodeStatus();
+			}
+
+			nextWakeTime = nextNodeStatusTime;
+		}
+
+		// Devices waiting for other devices of the handler to be allocated are not notified,
+		// they check their turn at their own allocation time
+		if (currentAddress == kAddressUnallocated) {
+			if (currentTime >= nextAllocationTime) {
+				resetAllocationSequence(currentTime);
+
+				if (handler.isNextAllocatee(this)) {
+					prevAllocationTime = currentTime;
+					sendAllocationRequest0(desiredAddress);
+				}
+			}
+
+			if (nextWakeTime > nextAllocationTime) {
+				nextWakeTime = nextAllocationTime;
+			}
+		}
+
+		if (nextWakeTime != microseconds::max()) {
+			handler.getTimers().arm(timer, nextWakeTime);
+		}
+	}
+
 	void processAllocationMessage(const CanardRxTransfer *aTransfer)
 	{
 		if (aTransfer->data_type_id == DataType::Message::ALLOCATION) {
@@ -299,6 +314,9 @@ private:
 
 				if (!memcmp(device.deviceHash().data(), payload, sizeof(payload)) && proposedAddress != 0) {
 					currentAddress = static_cast<Device::DeviceId>(proposedAddress);
+
+					// Announce the node without waiting for the next allocation time
+					handler.getTimers().arm(timer, TimeType::microseconds());
 				}
 			}
 		}
@@ -442,7 +460,7 @@ private:
 	{
 		const auto interfaceStats = handler.getInterfaceStatistics();
 		const auto transferStats = handler.getTransferStatistics();
-		TransportStatsResponse<1> response;
+		TransportStatsResponse<> response;
 
 		fillUint48(response.transfers_tx, transferStats.transfers_tx);
 		fillUint48(response.transfers_rx, transferStats.transfers_rx);
@@ -455,6 +473,27 @@ private:
 		handler.sendCanServiceResponse(currentAddress, aTransfer->source_node_id,
 			static_cast<DataType::Service>(aTransfer->data_type_id), aTransfer->transfer_id,
 			&response, sizeof(response));
+
+		sendPoolTelemetry();
+	}
+
+	void sendPoolTelemetry()
+	{
+		const auto telemetry = handler.getPoolTelemetry();
+		PoolTelemetryMessage message;
+
+		message.capacity_blocks = telemetry.statistics.capacity_blocks;
+		message.current_usage_blocks = telemetry.statistics.current_usage_blocks;
+		message.peak_usage_blocks = telemetry.statistics.peak_usage_blocks;
+		message.peak_rx_state_blocks = telemetry.usage.peak_blocks[CanardBlockRxState];
+		message.peak_rx_buffer_blocks = telemetry.usage.peak_blocks[CanardBlockRxBuffer];
+		message.peak_tx_item_blocks = telemetry.usage.peak_blocks[CanardBlockTxItem];
+		message.failures = telemetry.failures;
+		message.last_failure_ms = static_cast<uint32_t>(
+			std::chrono::duration_cast<std::chrono::milliseconds>(telemetry.lastFailure).count());
+
+		handler.sendCanMessage(currentAddress, DataType::POOL_TELEMETRY, &sequences.telemetry,
+			&message, sizeof(message));
 	}
 };
 
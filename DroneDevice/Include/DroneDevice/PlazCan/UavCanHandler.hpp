@@ -16,6 +16,7 @@
 #include <DroneDevice/PlazCan/HashFinder.hpp>
 #include <DroneDevice/PlazCan/UavCanPacket.hpp>
 #include <DroneDevice/Stubs/MockMutex.hpp>
+#include <DroneDevice/TimerWheel.hpp>
 
 namespace PlazCan {
 
@@ -73,6 +74,8 @@ class UavCanHandler {
 
 public:
 	using PlatformType = Platform;
+	using TimerWheelType = TimerWheel<TimeType>;
+	using Timer = typename TimerWheelType::Timer;
 
 	UavCanHandler(BusType &aBus, void *aArena, size_t aArenaSize,
 		uint64_t (*aHashFinder)(CanardTransferType, uint16_t) = nullptr):
@@ -81,13 +84,19 @@ public:
 		nodes{},
 		mutex{},
 		hashFinder{aHashFinder},
-		nextCleanupTime{kDefaultCleanupInterval + TimeType::microseconds()}
+		timers{},
+		cleanupTimer{[this]() { cleanupStaleTransfers(); }},
+		poolFailures{0},
+		firstPoolFailure{0},
+		lastPoolFailure{0}
 	{
 		canardInit(&canard, aArena, aArenaSize, onReceptionCallback, shouldAcceptCallback, this);
 
 		for (auto &entry : nodes) {
 			entry = nullptr;
 		}
+
+		timers.arm(cleanupTimer, TimeType::microseconds() + kDefaultCleanupInterval);
 	}
 
 	bool attach(CanDevice *aDevice)
@@ -121,6 +130,26 @@ public:
 		return canardGetPoolAllocatorStatistics(&canard);
 	}
 
+	//!
+	//! Timers of the attached devices are armed on the wheel of the handler,
+	//! they expire in onTimeoutOccurred().
+	//!
+	TimerWheelType &getTimers()
+	{
+		return timers;
+	}
+
+	PoolTelemetry getPoolTelemetry() const
+	{
+		return PoolTelemetry{
+			canardGetPoolAllocatorStatistics(&canard),
+			canardGetPoolAllocatorUsage(&canard),
+			poolFailures,
+			firstPoolFailure,
+			lastPoolFailure
+		};
+	}
+
 	CanardTransferStatistics getTransferStatistics() const
 	{
 		return canardGetTransferStatistics(&canard);
@@ -158,30 +187,20 @@ public:
 
 			mutex.lock();
 			canardHandleRxFrame(&canard, &frame, aMessage->timestamp);
+			checkPoolFailures();
 			mutex.unlock();
 
 			aMessage++;
 		}
 	}
 
+	//!
+	//! Call callbacks of the expired timers of the handler and of the attached devices.
+	//! \return Time when the function should be called again.
+	//!
 	microseconds onTimeoutOccurred()
 	{
-		const auto currentTime = TimeType::microseconds();
-
-		if (currentTime >= nextCleanupTime) {
-			cleanupStaleTransfers(currentTime);
-			nextCleanupTime = currentTime + kDefaultCleanupInterval;
-		}
-
-		microseconds nextWakeTime = nextCleanupTime;
-
-		for (auto entry : nodes) {
-			if (entry != nullptr) {
-				nextWakeTime = std::min(nextWakeTime, entry->onTimeoutOccurred());
-			}
-		}
-
-		return nextWakeTime;
+		return timers.poll();
 	}
 
 	void sendCanMessage(Device::DeviceId aSourceNodeId, uint16_t aDataTypeId,
@@ -196,6 +215,7 @@ public:
 			0,
 			aData,
 			static_cast<uint16_t>(aLength));
+		checkPoolFailures();
 		mutex.unlock();
 
 		enqueuePackets();
@@ -215,6 +235,7 @@ public:
 			CanardRequest,
 			aData,
 			static_cast<uint16_t>(aLength));
+		checkPoolFailures();
 		mutex.unlock();
 
 		enqueuePackets();
@@ -234,6 +255,7 @@ public:
 			CanardResponse,
 			aData,
 			static_cast<uint16_t>(aLength));
+		checkPoolFailures();
 		mutex.unlock();
 
 		enqueuePackets();
@@ -266,7 +288,8 @@ private:
 				HashId<DataType::Message::ALLOCATION,             0x0B2A812620A11D40ULL>,
 				HashId<DataType::Message::GLOBAL_TIME_SYNC,       0x20271116A793C2DBULL>,
 				HashId<DataType::Message::NODE_STATUS,            0x0F0868D0C1A7C6F1ULL>,
-				HashId<DataType::Message::COMPOSITE_FIELD_VALUES, 0xC0D0FE11431D2AC1ULL>
+				HashId<DataType::Message::COMPOSITE_FIELD_VALUES, 0xC0D0FE11431D2AC1ULL>,
+				HashId<DataType::Message::POOL_TELEMETRY,         0x5BF9276B0BF5AA50ULL>
 			>;
 		// clang-format on
 
@@ -311,13 +334,43 @@ private:
 	MutexType mutex;
 
 	uint64_t (*hashFinder)(CanardTransferType, uint16_t);
-	microseconds nextCleanupTime;
+	TimerWheelType timers;
+	Timer cleanupTimer;
+
+	uint32_t poolFailures;
+	microseconds firstPoolFailure;
+	microseconds lastPoolFailure;
+
+	//!
+	//! Update times of failed allocations, must be called with the mutex locked.
+	//!
+	void checkPoolFailures()
+	{
+		const auto usage = canardGetPoolAllocatorUsage(&canard);
+		uint32_t failures = 0;
+
+		for (auto count : usage.failures) {
+			failures += count;
+		}
 
-	void cleanupStaleTransfers(microseconds aCurrentTime)
+		if (failures != poolFailures) {
+			lastPoolFailure = TimeType::microseconds();
+			if (!poolFailures) {
+				firstPoolFailure = lastPoolFailure;
+			}
+			poolFailures = failures;
+		}
+	}
+
+	void cleanupStaleTransfers()
 	{
+		const auto currentTime = TimeType::microseconds();
+
 		mutex.lock();
-		canardCleanupStaleTransfers(&canard, static_cast<uint64_t>(aCurrentTime.count()));
+		canardCleanupStaleTransfers(&canard, static_cast<uint64_t>(currentTime.count()));
 		mutex.unlock();
+
+		timers.arm(cleanupTimer, currentTime + kDefaultCleanupInterval);
 	}
 
 	void enqueuePackets()
@@ -25,7 +25,8 @@ enum Message: uint16_t {
 	NODE_STATUS                      = 341,
 
 	// Vendor-specific messages
-	COMPOSITE_FIELD_VALUES           = 20000
+	COMPOSITE_FIELD_VALUES           = 20000,
+	POOL_TELEMETRY                   = 20001
 };
 // clang-format on
 
@@ -171,6 +172,21 @@ struct TransportStatsResponse {
 	CANIfaceStatsType can_iface_stats[count];
 } __attribute__((packed));
 
+//!
+//! Usage of the memory pool of libcanard, broadcast after each response to GetTransportStats.
+//! Layout follows geoscan.PoolTelemetry in Descriptions/geoscan/20001.PoolTelemetry.uavcan.
+//!
+struct PoolTelemetryMessage {
+	uint16_t capacity_blocks;
+	uint16_t current_usage_blocks;
+	uint16_t peak_usage_blocks;
+	uint16_t peak_rx_state_blocks;
+	uint16_t peak_rx_buffer_blocks;
+	uint16_t peak_tx_item_blocks;
+	uint32_t failures; //!< Failed allocations of all purposes
+	uint32_t last_failure_ms; //!< Time of the last failed allocation, zero when there were none
+} __attribute__((packed));
+
 struct EmptyType {
 };
 
@@ -8,6 +8,7 @@
 #ifndef DRONEDEVICE_SHA256_HPP_
 #define DRONEDEVICE_SHA256_HPP_
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -36,18 +37,34 @@ public:
 
 	void update(const uint8_t *aData, size_t aLength)
 	{
-		uint32_t i;
+		// Complete the block collected by previous calls
+		if (datalen > 0) {
+			const size_t count = std::min<size_t>(aLength, sizeof(data) - datalen);
 
-		for (i = 0; i < aLength; ++i) {
-			data[datalen] = aData[i];
-			datalen++;
+			memcpy(data + datalen, aData, count);
+			datalen = static_cast<uint16_t>(datalen + count);
+			aData += count;
+			aLength -= count;
 
-			if (datalen == 64) {
-				transform(data);
-				bitlen += 512;
-				datalen = 0;
+			if (datalen < sizeof(data)) {
+				return;
 			}
+
+			transform(data);
+			bitlen += 512;
+			datalen = 0;
 		}
+
+		// Whole blocks are processed directly from the buffer
+		while (aLength >= sizeof(data)) {
+			transform(aData);
+			bitlen += 512;
+			aData += sizeof(data);
+			aLength -= sizeof(data);
+		}
+
+		memcpy(data, aData, aLength);
+		datalen = static_cast<uint16_t>(aLength);
 	}
 
 	std::array<uint8_t, 32> finalize()
@@ -104,9 +121,12 @@ private:
 	uint16_t datalen;
 	uint8_t data[64];
 
-	static uint32_t k(size_t i)
-	{
-		static const uint32_t table[64] = {
+	//!
+	//! Round constants, the member template allows the definition of the array in the header.
+	//!
+	template<typename T = void>
+	struct RoundConstants {
+		static constexpr uint32_t k[64] = {
 			0x428A2F98UL, 0x71374491UL, 0xB5C0FBCFUL, 0xE9B5DBA5UL, 0x3956C25BUL, 0x59F111F1UL, 0x923F82A4UL, 0xAB1C5ED5UL,
 			0xD807AA98UL, 0x12835B01UL, 0x243185BEUL, 0x550C7DC3UL, 0x72BE5D74UL, 0x80DEB1FEUL, 0x9BDC06A7UL, 0xC19BF174UL,
 			0xE49B69C1UL, 0xEFBE4786UL, 0x0FC19DC6UL, 0x240CA1CCUL, 0x2DE92C6FUL, 0x4A7484AAUL, 0x5CB0A9DCUL, 0x76F988DAUL,
@@ -116,9 +136,7 @@ private:
 			0x19A4C116UL, 0x1E376C08UL, 0x2748774CUL, 0x34B0BCB5UL, 0x391C0CB3UL, 0x4ED8AA4AUL, 0x5B9CCA4FUL, 0x682E6FF3UL,
 			0x748F82EEUL, 0x78A5636FUL, 0x84C87814UL, 0x8CC70208UL, 0x90BEFFFAUL, 0xA4506CEBUL, 0xBEF9A3F7UL, 0xC67178F2UL
 		};
-
-		return table[i];
-	}
+	};
 
 	template<typename T>
 	static T ROTLEFT(T a, unsigned int b)
@@ -168,38 +186,69 @@ private:
 		return ROTRIGHT(x, 17) ^ ROTRIGHT(x, 19) ^ (x >> 10);
 	}
 
-	void transform(const uint8_t *aData)
+	static uint32_t load(const uint8_t *aData)
 	{
-		uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
+		return static_cast<uint32_t>(aData[0]) << 24 | static_cast<uint32_t>(aData[1]) << 16
+			| static_cast<uint32_t>(aData[2]) << 8 | static_cast<uint32_t>(aData[3]);
+	}
 
-		for (i = 0, j = 0; i < 16; ++i, j += 4) {
-			m[i] = (aData[j] << 24) | (aData[j + 1] << 16) | (aData[j + 2] << 8) | (aData[j + 3]);
+	//!
+	//! Single round, working variables are renamed by the caller instead of being shifted.
+	//! \tparam j Index of the round in a group of 16 rounds.
+	//!
+	template<size_t j>
+	static void round(uint32_t a, uint32_t b, uint32_t c, uint32_t &d, uint32_t e, uint32_t f, uint32_t g,
+		uint32_t &h, uint32_t *w, const uint32_t *k, bool aExpand)
+	{
+		// Message schedule is kept in a circular buffer of 16 words
+		if (aExpand) {
+			w[j] += SIG1(w[(j + 14) & 15]) + w[(j + 9) & 15] + SIG0(w[(j + 1) & 15]);
 		}
 
-		for ( ; i < 64; ++i) {
-			m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
+		const uint32_t t1 = h + EP1(e) + CH(e, f, g) + k[j] + w[j];
+		const uint32_t t2 = EP0(a) + MAJ(a, b, c);
+
+		d += t1;
+		h = t1 + t2;
+	}
+
+	void transform(const uint8_t *aData)
+	{
+		const uint32_t * const k = RoundConstants<>::k;
+		uint32_t w[16];
+
+		for (size_t i = 0; i < 16; ++i) {
+			w[i] = load(aData + i * 4);
 		}
 
-		a = state[0];
-		b = state[1];
-		c = state[2];
-		d = state[3];
-		e = state[4];
-		f = state[5];
-		g = state[6];
-		h = state[7];
-
-		for (i = 0; i < 64; ++i) {
-			t1 = h + EP1(e) + CH(e,f,g) + k(i) + m[i];
-			t2 = EP0(a) + MAJ(a,b,c);
-			h = g;
-			g = f;
-			f = e;
-			e = d + t1;
-			d = c;
-			c = b;
-			b = a;
-			a = t1 + t2;
+		uint32_t a = state[0];
+		uint32_t b = state[1];
+		uint32_t c = state[2];
+		uint32_t d = state[3];
+		uint32_t e = state[4];
+		uint32_t f = state[5];
+		uint32_t g = state[6];
+		uint32_t h = state[7];
+
+		for (size_t i = 0; i < 64; i += 16) {
+			const bool expand = i > 0;
+
+			round<0>(a, b, c, d, e, f, g, h, w, k + i, expand);
+			round<1>(h, a, b, c, d, e, f, g, w, k + i, expand);
+			round<2>(g, h, a, b, c, d, e, f, w, k + i, expand);
+			round<3>(f, g, h, a, b, c, d, e, w, k + i, expand);
+			round<4>(e, f, g, h, a, b, c, d, w, k + i, expand);
+			round<5>(d, e, f, g, h, a, b, c, w, k + i, expand);
+			round<6>(c, d, e, f, g, h, a, b, w, k + i, expand);
+			round<7>(b, c, d, e, f, g, h, a, w, k + i, expand);
+			round<8>(a, b, c, d, e, f, g, h, w, k + i, expand);
+			round<9>(h, a, b, c, d, e, f, g, w, k + i, expand);
+			round<10>(g, h, a, b, c, d, e, f, w, k + i, expand);
+			round<11>(f, g, h, a, b, c, d, e, w, k + i, expand);
+			round<12>(e, f, g, h, a, b, c, d, w, k + i, expand);
+			round<13>(d, e, f, g, h, a, b, c, w, k + i, expand);
+			round<14>(c, d, e, f, g, h, a, b, w, k + i, expand);
+			round<15>(b, c, d, e, f, g, h, a, w, k + i, expand);
 		}
 
 		state[0] += a;
@@ -213,4 +262,7 @@ private:
 	}
 };
 
+template<typename T>
+constexpr uint32_t Sha256::RoundConstants<T>::k[64];
+
 #endif // DRONEDEVICE_SHA256_HPP_
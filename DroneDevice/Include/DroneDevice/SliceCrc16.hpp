@@ -0,0 +1,83 @@
+//
+// SliceCrc16.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_SLICECRC16_HPP_
+#define DRONEDEVICE_SLICECRC16_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+//!
+//! CRC16 processing eight bytes per iteration, results are identical to FastCrc16.
+//!
+class SliceCrc16 {
+	struct Table {
+		// Each next table accounts one more zero byte after the indexed one
+		uint16_t data[8][256];
+
+		constexpr Table() :
+			data{}
+		{
+			// x^16 + x^12 + x^5 + 1
+			for (uint32_t i = 0; i < 256; ++i) {
+				uint16_t value = static_cast<uint16_t>(i << 8);
+
+				for (size_t bit = 0; bit < 8; ++bit) {
+					value = static_cast<uint16_t>(value & 0x8000 ? (value << 1) ^ 0x1021 : value << 1);
+				}
+
+				data[0][i] = value;
+			}
+
+			for (size_t slice = 1; slice < 8; ++slice) {
+				for (size_t i = 0; i < 256; ++i) {
+					data[slice][i] = static_cast<uint16_t>((data[slice - 1][i] << 8) ^ data[0][data[slice - 1][i] >> 8]);
+				}
+			}
+		}
+	};
+
+public:
+	using Type = uint16_t;
+	static constexpr size_t size{sizeof(uint16_t)};
+
+	SliceCrc16() = delete;
+	SliceCrc16(const SliceCrc16 &) = delete;
+	SliceCrc16 &operator=(const SliceCrc16 &) = delete;
+
+	//!
+	//! Update checksum with buffer data.
+	//! \param checksum Previous checksum value.
+	//! \param buffer Pointer to buffer with at least @b length characters of data.
+	//! \param length Buffer length.
+	//! \return Updated checksum value.
+	//!
+	static uint16_t update(uint16_t aChecksum, const void *aBuffer, size_t aLength)
+	{
+		static constexpr Table table{};
+
+		const uint8_t *buffer = static_cast<const uint8_t *>(aBuffer);
+
+		while (aLength >= 8) {
+			// Checksum is combined with the first two bytes only
+			aChecksum = table.data[7][buffer[0] ^ (aChecksum >> 8)] ^ table.data[6][buffer[1] ^ (aChecksum & 0xFF)]
+				^ table.data[5][buffer[2]] ^ table.data[4][buffer[3]]
+				^ table.data[3][buffer[4]] ^ table.data[2][buffer[5]]
+				^ table.data[1][buffer[6]] ^ table.data[0][buffer[7]];
+
+			buffer += 8;
+			aLength -= 8;
+		}
+
+		while (aLength--) {
+			aChecksum = static_cast<uint16_t>((aChecksum << 8) ^ table.data[0][((aChecksum >> 8) ^ *buffer++) & 0xFF]);
+		}
+
+		return aChecksum;
+	}
+};
+
+#endif // DRONEDEVICE_SLICECRC16_HPP_
@@ -0,0 +1,94 @@
+//
+// SliceCrc32.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_SLICECRC32_HPP_
+#define DRONEDEVICE_SLICECRC32_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+//!
+//! CRC32 processing eight bytes per iteration, results are identical to FastCrc32.
+//!
+class SliceCrc32 {
+	struct Table {
+		// Each next table accounts one more zero byte after the indexed one
+		uint32_t data[8][256];
+
+		constexpr Table() :
+			data{}
+		{
+			// x^32 + x^26 + x^23 + x^22 + x^16 + x^12 + x^11 + x^10 + x^8 + x^7 + x^5 + x^4 + x^2 + x^1 + 1
+			for (uint32_t i = 0; i < 256; ++i) {
+				uint32_t value = i;
+
+				for (size_t bit = 0; bit < 8; ++bit) {
+					value = value & 0x01 ? (value >> 1) ^ 0xEDB88320UL : value >> 1;
+				}
+
+				data[0][i] = value;
+			}
+
+			for (size_t slice = 1; slice < 8; ++slice) {
+				for (size_t i = 0; i < 256; ++i) {
+					data[slice][i] = (data[slice - 1][i] >> 8) ^ data[0][data[slice - 1][i] & 0xFF];
+				}
+			}
+		}
+	};
+
+public:
+	using Type = uint32_t;
+	static constexpr size_t size{sizeof(uint32_t)};
+
+	SliceCrc32() = delete;
+	SliceCrc32(const SliceCrc32 &) = delete;
+	SliceCrc32 &operator=(const SliceCrc32 &) = delete;
+
+	//!
+	//! Update checksum with buffer data.
+	//! \param checksum Previous checksum value.
+	//! \param buffer Pointer to buffer with at least @b length characters of data.
+	//! \param length Buffer length.
+	//! \return Updated checksum value.
+	//!
+	static uint32_t update(uint32_t aChecksum, const void *aBuffer, size_t aLength)
+	{
+		static constexpr Table table{};
+
+		const uint8_t *buffer = static_cast<const uint8_t *>(aBuffer);
+
+		aChecksum = ~aChecksum;
+
+		while (aLength >= 8) {
+			const uint32_t low = aChecksum ^ load(buffer);
+			const uint32_t high = load(buffer + 4);
+
+			aChecksum = table.data[7][low & 0xFF] ^ table.data[6][(low >> 8) & 0xFF]
+				^ table.data[5][(low >> 16) & 0xFF] ^ table.data[4][low >> 24]
+				^ table.data[3][high & 0xFF] ^ table.data[2][(high >> 8) & 0xFF]
+				^ table.data[1][(high >> 16) & 0xFF] ^ table.data[0][high >> 24];
+
+			buffer += 8;
+			aLength -= 8;
+		}
+
+		while (aLength--) {
+			aChecksum = (aChecksum >> 8) ^ table.data[0][(aChecksum ^ *buffer++) & 0xFF];
+		}
+
+		return ~aChecksum;
+	}
+
+private:
+	static uint32_t load(const uint8_t *aBuffer)
+	{
+		return static_cast<uint32_t>(aBuffer[0]) | static_cast<uint32_t>(aBuffer[1]) << 8
+			| static_cast<uint32_t>(aBuffer[2]) << 16 | static_cast<uint32_t>(aBuffer[3]) << 24;
+	}
+};
+
+#endif // DRONEDEVICE_SLICECRC32_HPP_
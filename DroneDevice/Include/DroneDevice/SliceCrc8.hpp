@@ -0,0 +1,82 @@
+//
+// SliceCrc8.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_SLICECRC8_HPP_
+#define DRONEDEVICE_SLICECRC8_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+//!
+//! CRC8 processing eight bytes per iteration, results are identical to FastCrc8.
+//!
+class SliceCrc8 {
+	struct Table {
+		// Each next table accounts one more zero byte after the indexed one
+		uint8_t data[8][256];
+
+		constexpr Table() :
+			data{}
+		{
+			// x^8 + x^5 + x^4 + 1
+			for (uint32_t i = 0; i < 256; ++i) {
+				uint8_t value = static_cast<uint8_t>(i);
+
+				for (size_t bit = 0; bit < 8; ++bit) {
+					value = static_cast<uint8_t>(value & 0x01 ? (value >> 1) ^ 0x8C : value >> 1);
+				}
+
+				data[0][i] = value;
+			}
+
+			for (size_t slice = 1; slice < 8; ++slice) {
+				for (size_t i = 0; i < 256; ++i) {
+					data[slice][i] = data[0][data[slice - 1][i]];
+				}
+			}
+		}
+	};
+
+public:
+	using Type = uint8_t;
+	static constexpr size_t size{sizeof(uint8_t)};
+
+	SliceCrc8() = delete;
+	SliceCrc8(const SliceCrc8 &) = delete;
+	SliceCrc8 &operator=(const SliceCrc8 &) = delete;
+
+	//!
+	//! Update checksum with buffer data.
+	//! \param checksum Previous checksum value.
+	//! \param buffer Pointer to buffer with at least @b length characters of data.
+	//! \param length Buffer length.
+	//! \return Updated checksum value.
+	//!
+	static uint8_t update(uint8_t aChecksum, const void *aBuffer, size_t aLength)
+	{
+		static constexpr Table table{};
+
+		const uint8_t *buffer = static_cast<const uint8_t *>(aBuffer);
+
+		while (aLength >= 8) {
+			aChecksum = table.data[7][buffer[0] ^ aChecksum] ^ table.data[6][buffer[1]]
+				^ table.data[5][buffer[2]] ^ table.data[4][buffer[3]]
+				^ table.data[3][buffer[4]] ^ table.data[2][buffer[5]]
+				^ table.data[1][buffer[6]] ^ table.data[0][buffer[7]];
+
+			buffer += 8;
+			aLength -= 8;
+		}
+
+		while (aLength--) {
+			aChecksum = table.data[0][aChecksum ^ *buffer++];
+		}
+
+		return aChecksum;
+	}
+};
+
+#endif // DRONEDEVICE_SLICECRC8_HPP_
@@ -0,0 +1,390 @@
+//
+// CanTrace.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_STUBS_CANTRACE_HPP_
+#define DRONEDEVICE_STUBS_CANTRACE_HPP_
+
+#include <DroneDevice/Can.hpp>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace Device {
+
+struct CanTraceRecord {
+	std::chrono::microseconds timestamp;
+	CanMessage message;
+};
+
+//!
+//! Captured CAN traffic. Traces are stored as text, one frame per line:
+//! timestamp in microseconds, identifier, data length and data bytes, all numbers except the timestamp
+//! are hexadecimal. Extended identifiers have 8 digits and standard identifiers have 3 digits,
+//! remote frames are marked with R instead of data bytes. Empty lines and lines starting with # are skipped.
+//!
+//!     1500000 1E01017F 8 00 00 00 00 00 00 00 C0
+//!
+//! Log files of candump from can-utils are accepted as well, so traces may be captured
+//! with SocketCAN tools: (1634567890.123456) can0 1E01017F#00000000000000C0
+//!
+class CanTrace {
+public:
+	using Records = std::vector<CanTraceRecord>;
+
+	CanTrace() :
+		frames{}
+	{
+	}
+
+	void append(std::chrono::microseconds aTimestamp, const CanMessage &aMessage)
+	{
+		CanTraceRecord record{aTimestamp, aMessage};
+
+		record.message.timestamp = static_cast<uint64_t>(aTimestamp.count());
+		frames.push_back(record);
+	}
+
+	void clear()
+	{
+		frames.clear();
+	}
+
+	bool empty() const
+	{
+		return frames.empty();
+	}
+
+	size_t size() const
+	{
+		return frames.size();
+	}
+
+	Records &records()
+	{
+		return frames;
+	}
+
+	const Records &records() const
+	{
+		return frames;
+	}
+
+	Records::const_iterator begin() const
+	{
+		return frames.begin();
+	}
+
+	Records::const_iterator end() const
+	{
+		return frames.end();
+	}
+
+	//!
+	//! Duration between the first and the last frame.
+	//!
+	std::chrono::microseconds duration() const
+	{
+		return frames.empty() ? std::chrono::microseconds{0} : frames.back().timestamp - frames.front().timestamp;
+	}
+
+	//!
+	//! Read a trace from a file, frames are appended to the current content.
+	//! \param path Path to the file.
+	//! \return True on success, false when the file can not be opened or contains malformed lines.
+	//!
+	bool load(const char *aPath)
+	{
+		FILE * const file = fopen(aPath, "r");
+
+		if (file == nullptr) {
+			return false;
+		}
+
+		char line[256];
+		bool result = true;
+
+		while (result && fgets(line, sizeof(line), file) != nullptr) {
+			CanTraceRecord record;
+
+			if (isBlank(line)) {
+				continue;
+			}
+
+			if (parse(line, &record)) {
+				frames.push_back(record);
+			} else {
+				result = false;
+			}
+		}
+
+		fclose(file);
+		return result;
+	}
+
+	//!
+	//! Write the trace to a file in the native format.
+	//! \param path Path to the file, the file is replaced.
+	//! \return True on success.
+	//!
+	bool save(const char *aPath) const
+	{
+		FILE * const file = fopen(aPath, "w");
+
+		if (file == nullptr) {
+			return false;
+		}
+
+		bool result = true;
+
+		for (const auto &record : frames) {
+			char line[kMaxLineLength];
+
+			format(record, line);
+			result = result && fputs(line, file) >= 0;
+		}
+
+		return fclose(file) == 0 && result;
+	}
+
+	//!
+	//! Parse a line in the native or in the candump format.
+	//! \param line Line of text, trailing line break is allowed.
+	//! \param record Parsed frame.
+	//! \return True when the line contains a valid frame.
+	//!
+	static bool parse(const char *aLine, CanTraceRecord *aRecord)
+	{
+		while (*aLine == ' ' || *aLine == '\t') {
+			++aLine;
+		}
+
+		CanMessage message{};
+		uint64_t timestamp;
+		bool result;
+
+		if (*aLine == '(') {
+			result = parseCandump(aLine, &timestamp, &message);
+		} else {
+			result = parseNative(aLine, &timestamp, &message);
+		}
+
+		if (result) {
+			message.timestamp = timestamp;
+			aRecord->timestamp = std::chrono::microseconds{timestamp};
+			aRecord->message = message;
+		}
+
+		return result;
+	}
+
+	static constexpr size_t kMaxLineLength{64};
+
+	//!
+	//! Format a frame in the native format.
+	//! \param record Frame.
+	//! \param buffer Buffer with at least kMaxLineLength bytes, the line is terminated with a line break.
+	//! \return Length of the line.
+	//!
+	static size_t format(const CanTraceRecord &aRecord, char *aBuffer)
+	{
+		const CanMessage &message = aRecord.message;
+		const bool extended = (message.flags & CanMessage::EXT) != 0;
+		int length = snprintf(aBuffer, kMaxLineLength, extended ? "%" PRId64 " %08" PRIX32 " %u" : "%" PRId64 " %03" PRIX32 " %u",
+			static_cast<int64_t>(aRecord.timestamp.count()), message.id, static_cast<unsigned int>(message.length));
+
+		if (message.flags & CanMessage::RTR) {
+			length += snprintf(aBuffer + length, kMaxLineLength - static_cast<size_t>(length), " R");
+		} else {
+			for (size_t i = 0; i < message.length; ++i) {
+				length += snprintf(aBuffer + length, kMaxLineLength - static_cast<size_t>(length), " %02X",
+					static_cast<unsigned int>(message.data[i]));
+			}
+		}
+
+		length += snprintf(aBuffer + length, kMaxLineLength - static_cast<size_t>(length), "\n");
+		return static_cast<size_t>(length);
+	}
+
+private:
+	Records frames;
+
+	static bool isBlank(const char *aLine)
+	{
+		while (*aLine == ' ' || *aLine == '\t') {
+			++aLine;
+		}
+
+		return *aLine == '#' || *aLine == '\r' || *aLine == '\n' || *aLine == '\0';
+	}
+
+	static int digit(char aCharacter)
+	{
+		if (aCharacter >= '0' && aCharacter <= '9') {
+			return aCharacter - '0';
+		} else if (aCharacter >= 'A' && aCharacter <= 'F') {
+			return aCharacter - 'A' + 10;
+		} else if (aCharacter >= 'a' && aCharacter <= 'f') {
+			return aCharacter - 'a' + 10;
+		} else {
+			return -1;
+		}
+	}
+
+	static bool isEnd(const char *aText)
+	{
+		while (*aText == ' ' || *aText == '\t' || *aText == '\r' || *aText == '\n') {
+			++aText;
+		}
+
+		return *aText == '\0';
+	}
+
+	//!
+	//! Parse the identifier, the number of digits selects the frame format.
+	//!
+	static bool parseIdentifier(const char **aText, CanMessage *aMessage)
+	{
+		const char *position = *aText;
+		uint32_t id = 0;
+		size_t digits = 0;
+
+		for (int value; (value = digit(*position)) >= 0; ++position, ++digits) {
+			id = (id << 4) | static_cast<uint32_t>(value);
+		}
+
+		if (digits == 8 && id <= 0x1FFFFFFFUL) {
+			aMessage->flags = CanMessage::EXT;
+		} else if (digits == 3 && id <= 0x7FFUL) {
+			aMessage->flags = 0;
+		} else {
+			return false;
+		}
+
+		aMessage->id = id;
+		*aText = position;
+		return true;
+	}
+
+	static bool parseNative(const char *aLine, uint64_t *aTimestamp, CanMessage *aMessage)
+	{
+		char *end;
+
+		*aTimestamp = strtoull(aLine, &end, 10);
+		if (end == aLine || (*end != ' ' && *end != '\t')) {
+			return false;
+		}
+
+		aLine = end;
+		while (*aLine == ' ' || *aLine == '\t') {
+			++aLine;
+		}
+
+		if (!parseIdentifier(&aLine, aMessage) || (*aLine != ' ' && *aLine != '\t')) {
+			return false;
+		}
+
+		const unsigned long length = strtoul(aLine, &end, 16);
+
+		if (end == aLine || length > CanMessage::kMaxLength) {
+			return false;
+		}
+
+		aLine = end;
+		aMessage->length = static_cast<uint8_t>(length);
+
+		while (*aLine == ' ' || *aLine == '\t') {
+			++aLine;
+		}
+
+		if (*aLine == 'R') {
+			aMessage->flags |= CanMessage::RTR;
+			return isEnd(aLine + 1);
+		}
+
+		for (size_t i = 0; i < aMessage->length; ++i) {
+			while (*aLine == ' ' || *aLine == '\t') {
+				++aLine;
+			}
+
+			const int high = digit(aLine[0]);
+			const int low = high >= 0 ? digit(aLine[1]) : -1;
+
+			if (low < 0) {
+				return false;
+			}
+
+			aMessage->data[i] = static_cast<uint8_t>((high << 4) | low);
+			aLine += 2;
+		}
+
+		return isEnd(aLine);
+	}
+
+	static bool parseCandump(const char *aLine, uint64_t *aTimestamp, CanMessage *aMessage)
+	{
+		char *end;
+		const uint64_t seconds = strtoull(aLine + 1, &end, 10);
+
+		if (end == aLine + 1 || *end != '.') {
+			return false;
+		}
+
+		const char * const fraction = end + 1;
+		const uint64_t subseconds = strtoull(fraction, &end, 10);
+
+		if (end - fraction != 6 || *end != ')') {
+			return false;
+		}
+
+		*aTimestamp = seconds * 1000000 + subseconds;
+
+		// Skip the interface name
+		aLine = end + 1;
+		while (*aLine == ' ' || *aLine == '\t') {
+			++aLine;
+		}
+		while (*aLine != ' ' && *aLine != '\t' && *aLine != '\0') {
+			++aLine;
+		}
+		while (*aLine == ' ' || *aLine == '\t') {
+			++aLine;
+		}
+
+		if (!parseIdentifier(&aLine, aMessage) || *aLine++ != '#') {
+			return false;
+		}
+
+		if (*aLine == 'R') {
+			aMessage->flags |= CanMessage::RTR;
+			aMessage->length = 0;
+
+			const int length = digit(aLine[1]);
+
+			if (length >= 0 && length <= static_cast<int>(CanMessage::kMaxLength)) {
+				aMessage->length = static_cast<uint8_t>(length);
+				++aLine;
+			}
+
+			return isEnd(aLine + 1);
+		}
+
+		size_t length = 0;
+
+		while (length < CanMessage::kMaxLength && digit(aLine[0]) >= 0 && digit(aLine[1]) >= 0) {
+			aMessage->data[length++] = static_cast<uint8_t>((digit(aLine[0]) << 4) | digit(aLine[1]));
+			aLine += 2;
+		}
+
+		aMessage->length = static_cast<uint8_t>(length);
+		return isEnd(aLine);
+	}
+};
+
+} // namespace Device
+
+#endif // DRONEDEVICE_STUBS_CANTRACE_HPP_
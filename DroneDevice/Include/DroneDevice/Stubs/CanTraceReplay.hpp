@@ -0,0 +1,197 @@
+//
+// CanTraceReplay.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_STUBS_CANTRACEREPLAY_HPP_
+#define DRONEDEVICE_STUBS_CANTRACEREPLAY_HPP_
+
+#include <DroneDevice/PlazCan/CanDevice.hpp>
+#include <DroneDevice/Stubs/CanTrace.hpp>
+#include <DroneDevice/Stubs/SimTime.hpp>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <vector>
+
+namespace Device {
+
+//!
+//! Controller for replays, frames written by the protocol stack are stored with the simulated time.
+//!
+class ReplayCan {
+public:
+	ReplayCan() :
+		output{},
+		stats{}
+	{
+	}
+
+	CanStatistics getStatistics() const
+	{
+		return stats;
+	}
+
+	void setCallback(std::function<void ()>)
+	{
+	}
+
+	void setFilters(const CanFilter *, size_t)
+	{
+	}
+
+	size_t read(CanMessage *, size_t)
+	{
+		return 0;
+	}
+
+	size_t write(const CanMessage *aBuffer, size_t aLength)
+	{
+		for (size_t i = 0; i < aLength; ++i) {
+			CanMessage message = aBuffer[i];
+
+			message.id &= (message.flags & CanMessage::EXT) ? 0x1FFFFFFFUL : 0x7FFUL;
+			output.append(SimTime::microseconds(), message);
+		}
+
+		stats.tx += aLength;
+		return aLength;
+	}
+
+	//!
+	//! Frames sent during replays.
+	//!
+	const CanTrace &getOutput() const
+	{
+		return output;
+	}
+
+	void clear()
+	{
+		output.clear();
+		stats = CanStatistics{};
+	}
+
+private:
+	CanTrace output;
+	CanStatistics stats;
+};
+
+//!
+//! Deterministic replay of captured traffic into UavCanHandler. The platform of the handler must use SimTime,
+//! the time is advanced to the timestamp of each frame and handler timers are serviced in between,
+//! so the replay does not depend on the speed of the host.
+//!
+template<typename Handler>
+class CanTraceReplay {
+public:
+	struct Result {
+		size_t frames;
+		uint64_t transfers; //!< Transfers delivered to devices
+		uint32_t droppedTransfers;
+		uint32_t transferErrors;
+		PlazCan::PoolTelemetry pool;
+		std::chrono::nanoseconds cpuTime; //!< Processor time of the thread, including timers
+		std::vector<uint32_t> frameTimes; //!< Sorted processing times of received frames in nanoseconds
+
+		//!
+		//! Processing time of a single frame.
+		//! \param fraction Percentile as a fraction, for example 0.99.
+		//!
+		std::chrono::nanoseconds frameTime(double aFraction) const
+		{
+			if (frameTimes.empty()) {
+				return std::chrono::nanoseconds{0};
+			}
+
+			const size_t index = std::min(frameTimes.size() - 1,
+				static_cast<size_t>(aFraction * static_cast<double>(frameTimes.size())));
+
+			return std::chrono::nanoseconds{frameTimes[index]};
+		}
+
+		std::chrono::nanoseconds meanFrameTime() const
+		{
+			uint64_t sum = 0;
+
+			for (auto value : frameTimes) {
+				sum += value;
+			}
+
+			return std::chrono::nanoseconds{frameTimes.empty() ? 0 : sum / frameTimes.size()};
+		}
+	};
+
+	CanTraceReplay() = delete;
+	CanTraceReplay(const CanTraceReplay &) = delete;
+	CanTraceReplay &operator=(const CanTraceReplay &) = delete;
+
+	//!
+	//! Feed all frames of the trace into the handler. The trace is shifted in time so that the first frame
+	//! is received at the current simulated time.
+	//! \param handler Protocol stack with attached devices.
+	//! \param trace Frames sorted by time.
+	//! \return Statistics of the replay, pool telemetry covers the whole lifetime of the handler.
+	//!
+	static Result run(Handler &aHandler, const CanTrace &aTrace)
+	{
+		Result result{};
+		const auto initial = aHandler.getTransferStatistics();
+		const auto origin = SimTime::nanoseconds();
+		const auto first = aTrace.empty() ? std::chrono::microseconds{0} : aTrace.begin()->timestamp;
+		const auto cpuStart = threadTime();
+		auto wakeTime = std::chrono::duration_cast<std::chrono::nanoseconds>(aHandler.onTimeoutOccurred());
+
+		result.frameTimes.reserve(aTrace.size());
+
+		for (const auto &record : aTrace) {
+			const auto arrival = origin + std::chrono::duration_cast<std::chrono::nanoseconds>(record.timestamp - first);
+
+			while (wakeTime <= arrival) {
+				SimTime::advanceTo(wakeTime);
+
+				const auto next = std::chrono::duration_cast<std::chrono::nanoseconds>(aHandler.onTimeoutOccurred());
+				wakeTime = std::max(next, SimTime::nanoseconds() + std::chrono::microseconds{1});
+			}
+
+			SimTime::advanceTo(arrival);
+
+			CanMessage message = record.message;
+			message.timestamp = SimTime::time();
+
+			const auto start = std::chrono::steady_clock::now();
+			aHandler.onMessageReceived(&message, 1);
+			const auto elapsed = std::chrono::steady_clock::now() - start;
+
+			result.frameTimes.push_back(static_cast<uint32_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+		}
+
+		const auto current = aHandler.getTransferStatistics();
+
+		result.cpuTime = threadTime() - cpuStart;
+		result.frames = aTrace.size();
+		result.transfers = current.transfers_rx - initial.transfers_rx;
+		result.droppedTransfers = current.dropped_transfers - initial.dropped_transfers;
+		result.transferErrors = current.transfer_errors - initial.transfer_errors;
+		result.pool = aHandler.getPoolTelemetry();
+		std::sort(result.frameTimes.begin(), result.frameTimes.end());
+
+		return result;
+	}
+
+private:
+	static std::chrono::nanoseconds threadTime()
+	{
+		struct timespec value;
+
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &value);
+		return std::chrono::seconds{value.tv_sec} + std::chrono::nanoseconds{value.tv_nsec};
+	}
+};
+
+} // namespace Device
+
+#endif // DRONEDEVICE_STUBS_CANTRACEREPLAY_HPP_
@@ -0,0 +1,127 @@
+//
+// LatencyHistogram.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_STUBS_LATENCYHISTOGRAM_HPP_
+#define DRONEDEVICE_STUBS_LATENCYHISTOGRAM_HPP_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Device {
+
+//!
+//! Histogram of latencies with logarithmic buckets, each power of two is split into 16 linear buckets,
+//! so percentiles have a relative error below 7 %. Values below 16 microseconds are exact.
+//!
+class LatencyHistogram {
+	static constexpr unsigned int kSubBits{4};
+	static constexpr size_t kSubBuckets{1 << kSubBits};
+	static constexpr size_t kBuckets{(64 - kSubBits + 1) * kSubBuckets};
+
+public:
+	LatencyHistogram() :
+		buckets{},
+		samples{0},
+		sum{0},
+		maximum{0}
+	{
+	}
+
+	void clear()
+	{
+		buckets.fill(0);
+		samples = 0;
+		sum = 0;
+		maximum = 0;
+	}
+
+	void record(std::chrono::microseconds aValue)
+	{
+		const uint64_t value = aValue.count() > 0 ? static_cast<uint64_t>(aValue.count()) : 0;
+
+		++buckets[bucketIndex(value)];
+		++samples;
+		sum += value;
+		maximum = std::max(maximum, value);
+	}
+
+	size_t count() const
+	{
+		return samples;
+	}
+
+	std::chrono::microseconds max() const
+	{
+		return std::chrono::microseconds{maximum};
+	}
+
+	std::chrono::microseconds mean() const
+	{
+		return std::chrono::microseconds{samples ? sum / samples : 0};
+	}
+
+	//!
+	//! Upper bound of the bucket which contains the percentile.
+	//! \param fraction Percentile as a fraction, for example 0.99.
+	//!
+	std::chrono::microseconds percentile(double aFraction) const
+	{
+		if (!samples) {
+			return std::chrono::microseconds{0};
+		}
+
+		const uint64_t rank = std::max<uint64_t>(1,
+			static_cast<uint64_t>(aFraction * static_cast<double>(samples) + 0.5));
+		uint64_t accumulated = 0;
+
+		for (size_t index = 0; index < kBuckets; ++index) {
+			accumulated += buckets[index];
+
+			if (accumulated >= rank) {
+				return std::chrono::microseconds{std::min(bucketLimit(index), maximum)};
+			}
+		}
+
+		return std::chrono::microseconds{maximum};
+	}
+
+private:
+	std::array<uint64_t, kBuckets> buckets;
+	size_t samples;
+	uint64_t sum;
+	uint64_t maximum;
+
+	static size_t bucketIndex(uint64_t aValue)
+	{
+		if (aValue < kSubBuckets) {
+			return static_cast<size_t>(aValue);
+		}
+
+		const unsigned int exponent = 63 - static_cast<unsigned int>(__builtin_clzll(aValue));
+		const unsigned int shift = exponent - kSubBits;
+
+		return (shift + 1) * kSubBuckets + static_cast<size_t>((aValue >> shift) & (kSubBuckets - 1));
+	}
+
+	static uint64_t bucketLimit(size_t aIndex)
+	{
+		if (aIndex < kSubBuckets) {
+			return aIndex;
+		}
+
+		const unsigned int shift = static_cast<unsigned int>(aIndex / kSubBuckets) - 1;
+		const uint64_t base = (kSubBuckets + (aIndex % kSubBuckets)) << shift;
+
+		return base + ((uint64_t{1} << shift) - 1);
+	}
+};
+
+} // namespace Device
+
+#endif // DRONEDEVICE_STUBS_LATENCYHISTOGRAM_HPP_
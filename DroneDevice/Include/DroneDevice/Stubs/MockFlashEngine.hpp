@@ -0,0 +1,151 @@
+//
+// MockFlashEngine.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_STUBS_MOCKFLASHENGINE_HPP_
+#define DRONEDEVICE_STUBS_MOCKFLASHENGINE_HPP_
+
+#include <DroneDevice/InplaceFunction.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+
+namespace Device {
+
+//!
+//! Erase and program engine for tests. Jobs are either completed immediately inside erase() and write()
+//! or queued until complete() or run() is called, which resembles completion from the interrupt
+//! of the flash controller. Queued jobs may be completed from another thread.
+//! \tparam Memory Memory interface with erase(address, length) and write(address, buffer, length).
+//!
+template<typename Memory>
+class MockFlashEngine {
+public:
+	using Callback = InplaceFunction<void (bool)>;
+
+	//!
+	//! Construct the engine.
+	//! \param immediate Complete jobs before returning from erase() and write().
+	//! \param capacity Length of the job queue, erase() and write() fail when the queue is full.
+	//!
+	explicit MockFlashEngine(bool aImmediate = false, size_t aCapacity = std::numeric_limits<size_t>::max()) :
+		jobs{},
+		mutex{},
+		capacity{aCapacity},
+		peak{0},
+		immediate{aImmediate}
+	{
+	}
+
+	MockFlashEngine(const MockFlashEngine &) = delete;
+	MockFlashEngine &operator=(const MockFlashEngine &) = delete;
+
+	bool erase(uintptr_t aOffset, size_t aLength, Callback aCallback = nullptr)
+	{
+		return enqueue([aOffset, aLength]() { return Memory::erase(aOffset, aLength); }, aCallback);
+	}
+
+	bool write(uintptr_t aOffset, const void *aBuffer, size_t aLength, Callback aCallback = nullptr)
+	{
+		return enqueue([aOffset, aBuffer, aLength]() { return Memory::write(aOffset, aBuffer, aLength); }, aCallback);
+	}
+
+	bool isBusy() const
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		return !jobs.empty();
+	}
+
+	//!
+	//! Largest number of jobs which were queued at the same time.
+	//!
+	size_t getPeakJobs() const
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		return peak;
+	}
+
+	//!
+	//! Complete the oldest pending job.
+	//! \return False when there are no pending jobs.
+	//!
+	bool complete()
+	{
+		Job job;
+
+		{
+			std::lock_guard<std::mutex> lock{mutex};
+
+			if (jobs.empty()) {
+				return false;
+			}
+
+			job = jobs.front();
+			jobs.pop_front();
+		}
+
+		execute(job);
+		return true;
+	}
+
+	//!
+	//! Complete all pending jobs including jobs queued from callbacks.
+	//!
+	void run()
+	{
+		while (complete());
+	}
+
+private:
+	struct Job {
+		std::function<bool ()> operation;
+		Callback callback;
+	};
+
+	std::deque<Job> jobs;
+	mutable std::mutex mutex;
+	size_t capacity;
+	size_t peak;
+	bool immediate;
+
+	bool enqueue(std::function<bool ()> aOperation, Callback aCallback)
+	{
+		const Job job{aOperation, aCallback};
+
+		if (immediate) {
+			execute(job);
+			return true;
+		}
+
+		std::lock_guard<std::mutex> lock{mutex};
+
+		if (jobs.size() >= capacity) {
+			return false;
+		}
+
+		jobs.push_back(job);
+		peak = std::max(peak, jobs.size());
+		return true;
+	}
+
+	static void execute(const Job &aJob)
+	{
+		Memory::unlock();
+		const bool result = aJob.operation();
+		Memory::lock();
+
+		if (aJob.callback != nullptr) {
+			aJob.callback(result);
+		}
+	}
+};
+
+} // namespace Device
+
+#endif // DRONEDEVICE_STUBS_MOCKFLASHENGINE_HPP_
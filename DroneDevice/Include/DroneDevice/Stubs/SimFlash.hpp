@@ -0,0 +1,343 @@
+//
+// SimFlash.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_STUBS_SIMFLASH_HPP_
+#define DRONEDEVICE_STUBS_SIMFLASH_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace Device {
+
+//!
+//! Programming rules of a flash family.
+//! \tparam unit Programming granularity, addresses and lengths of writes should be aligned to it.
+//! \tparam overwritable Whether programmed units may be programmed again to clear more bits,
+//! otherwise a unit is programmed once after erase.
+//!
+template<size_t unit, bool overwritable>
+struct SimFlashTraits {
+	static constexpr size_t kUnit{unit};
+	static constexpr bool kOverwritable{overwritable};
+};
+
+using SimFlashF1 = SimFlashTraits<2, false>; //!< STM32F0, STM32F1 and STM32F3, half-words
+using SimFlashF4 = SimFlashTraits<1, true>; //!< STM32F4 and STM32F7 with x8 parallelism
+using SimFlashL4 = SimFlashTraits<8, false>; //!< STM32L4 and STM32G4, double words with ECC
+
+//!
+//! Host memory interface with NOR flash behaviour for tests and benchmarks of storage code.
+//! Memory is kept in RAM or in a memory-mapped file, so the content survives restarts of the process.
+//! Erase and program cycles are counted per page, power cuts are injected after a number
+//! of modified bytes: the interrupted operation is left incomplete and all following
+//! operations fail until the power is restored.
+//! \tparam pageSize Size of an erase page.
+//! \tparam pages Number of pages.
+//! \tparam Traits Programming rules, see SimFlashTraits.
+//! \tparam base Absolute address of the memory.
+//!
+template<size_t pageSize, size_t pages, typename Traits = SimFlashF4, uintptr_t base = 0>
+class SimFlash {
+	static constexpr size_t kSize{pageSize * pages};
+
+	static_assert(pageSize % Traits::kUnit == 0, "Incorrect page size");
+
+public:
+	struct Counters {
+		size_t erases; //!< Number of erased pages
+		size_t programs; //!< Number of write operations
+		size_t programmedBytes;
+		size_t reads;
+		size_t errors; //!< Number of rejected operations
+	};
+
+	SimFlash() = delete;
+	SimFlash(const SimFlash &) = delete;
+	SimFlash &operator=(const SimFlash &) = delete;
+
+	static constexpr uintptr_t address()
+	{
+		return base;
+	}
+
+	static constexpr size_t capacity()
+	{
+		return kSize;
+	}
+
+	//!
+	//! Map the memory to a file, missing part of the file is filled with the erased value.
+	//! \param path Path to the file, the file is created when needed.
+	//! \return True on success, the memory is kept in RAM otherwise.
+	//!
+	static bool open(const char *aPath)
+	{
+		close();
+
+		const int descriptor = ::open(aPath, O_RDWR | O_CREAT, 0644);
+
+		if (descriptor < 0) {
+			return false;
+		}
+
+		struct stat info;
+		const size_t existing = fstat(descriptor, &info) == 0 ? static_cast<size_t>(info.st_size) : 0;
+
+		if (ftruncate(descriptor, static_cast<off_t>(kSize)) != 0) {
+			::close(descriptor);
+			return false;
+		}
+
+		void * const mapping = mmap(nullptr, kSize, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+		::close(descriptor);
+
+		if (mapping == MAP_FAILED) {
+			return false;
+		}
+
+		state().file = static_cast<uint8_t *>(mapping);
+
+		if (existing < kSize) {
+			memset(state().file + existing, 0xFF, kSize - existing);
+		}
+
+		return true;
+	}
+
+	//!
+	//! Unmap the file, the memory is switched back to RAM with the erased value.
+	//!
+	static void close()
+	{
+		if (state().file != nullptr) {
+			msync(state().file, kSize, MS_SYNC);
+			munmap(state().file, kSize);
+			state().file = nullptr;
+		}
+	}
+
+	//!
+	//! Erase the whole memory without counting cycles and reset counters.
+	//!
+	static void format()
+	{
+		memset(data(), 0xFF, kSize);
+		resetCounters();
+		std::fill(std::begin(state().cycles), std::end(state().cycles), 0);
+	}
+
+	static bool protect()
+	{
+		return false;
+	}
+
+	static bool isProtected()
+	{
+		return false;
+	}
+
+	static void lock()
+	{
+		state().locked = true;
+	}
+
+	static void unlock()
+	{
+		state().locked = false;
+	}
+
+	static bool erase(uintptr_t aAddress, size_t aLength)
+	{
+		if (!isPowered() || state().locked || !contains(aAddress, aLength)
+				|| (aAddress - base) % pageSize != 0 || aLength % pageSize != 0) {
+			++state().counters.errors;
+			return false;
+		}
+
+		const size_t first = (aAddress - base) / pageSize;
+
+		for (size_t page = first; page < first + aLength / pageSize; ++page) {
+			uint8_t * const memory = data() + page * pageSize;
+			const size_t length = consume(pageSize);
+
+			++state().cycles[page];
+			++state().counters.erases;
+			memset(memory, 0xFF, length);
+
+			if (length != pageSize) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static bool read(uintptr_t aAddress, void *aBuffer, size_t aLength)
+	{
+		if (!isPowered() || !contains(aAddress, aLength)) {
+			++state().counters.errors;
+			return false;
+		}
+
+		++state().counters.reads;
+		memcpy(aBuffer, data() + (aAddress - base), aLength);
+		return true;
+	}
+
+	static bool write(uintptr_t aAddress, const void *aBuffer, size_t aLength)
+	{
+		if (!isPowered() || state().locked || !contains(aAddress, aLength)
+				|| (aAddress - base) % Traits::kUnit != 0 || aLength % Traits::kUnit != 0) {
+			++state().counters.errors;
+			return false;
+		}
+
+		const uint8_t * const buffer = static_cast<const uint8_t *>(aBuffer);
+		uint8_t * const memory = data() + (aAddress - base);
+
+		// Programming stops at the first unit which violates the rules of the family
+		for (size_t position = 0; position < aLength; position += Traits::kUnit) {
+			if (!isProgrammable(memory + position, buffer + position)) {
+				++state().counters.errors;
+				return false;
+			}
+
+			const size_t length = consume(Traits::kUnit);
+
+			memcpy(memory + position, buffer + position, length);
+			state().counters.programmedBytes += length;
+
+			if (length != Traits::kUnit) {
+				return false;
+			}
+		}
+
+		++state().counters.programs;
+		return true;
+	}
+
+	//!
+	//! Cut the power when the given number of bytes is modified by erase and program operations.
+	//! \param bytes Number of bytes modified before the cut.
+	//!
+	static void cutPowerAfter(size_t aBytes)
+	{
+		state().budget = aBytes;
+	}
+
+	static void restorePower()
+	{
+		state().budget = std::numeric_limits<size_t>::max();
+		state().powered = true;
+	}
+
+	static bool isPowered()
+	{
+		return state().powered;
+	}
+
+	static const Counters &counters()
+	{
+		return state().counters;
+	}
+
+	static void resetCounters()
+	{
+		state().counters = Counters{};
+	}
+
+	//!
+	//! Number of erase cycles of the page since the last format.
+	//!
+	static uint32_t eraseCycles(size_t aPage)
+	{
+		return state().cycles[aPage];
+	}
+
+	static uint32_t maxEraseCycles()
+	{
+		return *std::max_element(std::begin(state().cycles), std::end(state().cycles));
+	}
+
+	//!
+	//! Direct access to the content for test setup and checks.
+	//!
+	static uint8_t *data()
+	{
+		return state().file != nullptr ? state().file : state().memory;
+	}
+
+private:
+	struct State {
+		State()
+		{
+			memset(memory, 0xFF, sizeof(memory));
+		}
+
+		uint8_t memory[kSize];
+		uint8_t *file{nullptr};
+		uint32_t cycles[pages]{};
+		Counters counters{};
+		size_t budget{std::numeric_limits<size_t>::max()};
+		bool powered{true};
+		bool locked{true};
+	};
+
+	static State &state()
+	{
+		static State object;
+		return object;
+	}
+
+	static bool contains(uintptr_t aAddress, size_t aLength)
+	{
+		return aAddress >= base && aAddress - base <= kSize && aLength <= kSize - (aAddress - base);
+	}
+
+	static bool isProgrammable(const uint8_t *aMemory, const uint8_t *aValue)
+	{
+		for (size_t i = 0; i < Traits::kUnit; ++i) {
+			if (Traits::kOverwritable ? (aMemory[i] & aValue[i]) != aValue[i] : aMemory[i] != 0xFF) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	//!
+	//! Take bytes from the power budget.
+	//! \return Number of bytes modified before the power cut.
+	//!
+	static size_t consume(size_t aLength)
+	{
+		State &current = state();
+
+		if (current.budget >= aLength) {
+			if (current.budget != std::numeric_limits<size_t>::max()) {
+				current.budget -= aLength;
+			}
+			return aLength;
+		}
+
+		const size_t length = current.budget;
+
+		current.budget = 0;
+		current.powered = false;
+		return length;
+	}
+};
+
+} // namespace Device
+
+#endif // DRONEDEVICE_STUBS_SIMFLASH_HPP_
@@ -0,0 +1,76 @@
+//
+// SimTime.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_STUBS_SIMTIME_HPP_
+#define DRONEDEVICE_STUBS_SIMTIME_HPP_
+
+#include <chrono>
+#include <cstdint>
+
+namespace Device {
+
+//!
+//! Simulated time source with the interface of LocalTime, the time changes only when
+//! a simulation advances it. Resolution is one nanosecond, so bit times of CAN buses are exact.
+//!
+class SimTime {
+public:
+	SimTime() = delete;
+	SimTime(const SimTime &) = delete;
+	SimTime &operator=(const SimTime &) = delete;
+
+	static std::chrono::nanoseconds nanoseconds()
+	{
+		return now();
+	}
+
+	static std::chrono::microseconds microseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(now());
+	}
+
+	static std::chrono::milliseconds milliseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(now());
+	}
+
+	static std::chrono::seconds seconds()
+	{
+		return std::chrono::duration_cast<std::chrono::seconds>(now());
+	}
+
+	static uint64_t time()
+	{
+		return static_cast<uint64_t>(microseconds().count());
+	}
+
+	//!
+	//! Move the time forward, the time never goes back.
+	//! \param time Absolute time.
+	//!
+	static void advanceTo(std::chrono::nanoseconds aTime)
+	{
+		if (aTime > now()) {
+			now() = aTime;
+		}
+	}
+
+	static void reset()
+	{
+		now() = std::chrono::nanoseconds{0};
+	}
+
+private:
+	static std::chrono::nanoseconds &now()
+	{
+		static std::chrono::nanoseconds value{0};
+		return value;
+	}
+};
+
+} // namespace Device
+
+#endif // DRONEDEVICE_STUBS_SIMTIME_HPP_
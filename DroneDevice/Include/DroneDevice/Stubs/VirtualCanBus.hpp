@@ -0,0 +1,598 @@
+//
+// VirtualCanBus.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_STUBS_VIRTUALCANBUS_HPP_
+#define DRONEDEVICE_STUBS_VIRTUALCANBUS_HPP_
+
+#include <DroneDevice/Can.hpp>
+#include <DroneDevice/Queue.hpp>
+#include <DroneDevice/Stubs/LatencyHistogram.hpp>
+#include <DroneDevice/Stubs/SimTime.hpp>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace Device {
+
+struct VirtualCanFrame {
+	CanMessage message;
+	std::chrono::nanoseconds queued; //!< Time when the frame was written to the controller
+};
+
+//!
+//! Controller attached to VirtualCanBus.
+//!
+class VirtualCanNode {
+public:
+	virtual ~VirtualCanNode() = default;
+
+	//!
+	//! Frame which takes part in the next arbitration.
+	//! \return Pointer to the frame or nullptr when the controller has nothing to send.
+	//!
+	virtual const VirtualCanFrame *peek() const = 0;
+
+	virtual void onTransmitted() = 0;
+	virtual void onTransmitError() = 0;
+	virtual void onBusOff() = 0;
+	virtual void onReceived(const CanMessage &aMessage) = 0;
+};
+
+//!
+//! In-process CAN bus for simulations of many nodes with SimTime.
+//! Frames are arbitrated bit by bit on the identifier field, frame lengths include stuff bits,
+//! so bus load matches a physical bus with the same bit rate. Error frames are injected with a given
+//! probability, controllers retransmit corrupted frames and go bus-off after repeated errors.
+//! The bus tracks UAVCAN service transfers and measures the time from queueing of the first frame
+//! of a request to the delivery of the last frame of the response.
+//!
+class VirtualCanBus {
+	static constexpr unsigned int kErrorFrameBits{6 + 8}; //!< Error flag and error delimiter
+	static constexpr unsigned int kInterframeBits{3};
+	static constexpr unsigned int kErrorPassiveLimit{128};
+	static constexpr unsigned int kBusOffLimit{256};
+
+public:
+	struct Statistics {
+		uint64_t frames; //!< Successfully transmitted frames
+		uint64_t errorFrames;
+		uint64_t bits; //!< Bus time in bits, including error frames and interframe spaces
+		uint64_t busOffs;
+		std::chrono::nanoseconds busy;
+		std::chrono::nanoseconds elapsed;
+
+		//!
+		//! Fraction of time when the bus was occupied.
+		//!
+		double utilization() const
+		{
+			return elapsed.count() ? static_cast<double>(busy.count()) / static_cast<double>(elapsed.count()) : 0.0;
+		}
+
+		//!
+		//! Successfully transmitted frames per second.
+		//!
+		double throughput() const
+		{
+			return elapsed.count() ? static_cast<double>(frames) * 1e9 / static_cast<double>(elapsed.count()) : 0.0;
+		}
+	};
+
+	explicit VirtualCanBus(uint32_t aBitrate, double aErrorRate = 0.0, uint32_t aSeed = 1) :
+		nodes{},
+		requests{},
+		requestLatency{},
+		frameLatency{},
+		stats{},
+		origin{SimTime::nanoseconds()},
+		bitrate{aBitrate},
+		errorRate{aErrorRate},
+		seed{aSeed ? aSeed : 1}
+	{
+	}
+
+	VirtualCanBus(const VirtualCanBus &) = delete;
+	VirtualCanBus &operator=(const VirtualCanBus &) = delete;
+
+	void attach(VirtualCanNode *aNode)
+	{
+		nodes.push_back(Entry{aNode, 0, false});
+	}
+
+	void detach(const VirtualCanNode *aNode)
+	{
+		nodes.erase(std::remove_if(nodes.begin(), nodes.end(),
+			[aNode](const Entry &aEntry) { return aEntry.node == aNode; }), nodes.end());
+	}
+
+	void setErrorRate(double aErrorRate)
+	{
+		errorRate = aErrorRate;
+	}
+
+	Statistics getStatistics() const
+	{
+		Statistics result = stats;
+
+		result.elapsed = SimTime::nanoseconds() - origin;
+		return result;
+	}
+
+	//!
+	//! Latency of UAVCAN service requests.
+	//!
+	const LatencyHistogram &getRequestLatency() const
+	{
+		return requestLatency;
+	}
+
+	//!
+	//! Time from queueing of a frame to its delivery.
+	//!
+	const LatencyHistogram &getFrameLatency() const
+	{
+		return frameLatency;
+	}
+
+	void resetStatistics()
+	{
+		stats = Statistics{};
+		origin = SimTime::nanoseconds();
+		requestLatency.clear();
+		frameLatency.clear();
+	}
+
+	//!
+	//! Transmit the next frame or advance the time to the limit when no frames are pending.
+	//! \param limit Absolute time.
+	//! \return True when the bus was occupied by a frame or an error frame.
+	//!
+	bool step(std::chrono::nanoseconds aLimit)
+	{
+		const Entry * const winner = arbitrate();
+
+		if (winner == nullptr) {
+			SimTime::advanceTo(aLimit);
+			return false;
+		}
+
+		const VirtualCanFrame frame = *winner->node->peek();
+		const unsigned int length = frameBits(frame.message);
+
+		if (collision || random() < errorRate) {
+			// Error is detected somewhere in the frame before the acknowledgement
+			const unsigned int position = 1 + static_cast<unsigned int>(random() * (length - 13));
+
+			occupy(position + kErrorFrameBits + kInterframeBits);
+			++stats.errorFrames;
+
+			for (auto &entry : nodes) {
+				if (entry.node->peek() != nullptr && arbitrationKey(entry.node->peek()->message) == key) {
+					entry.node->onTransmitError();
+					entry.errors += 8;
+
+					if (entry.errors >= kBusOffLimit) {
+						// Recovery sequence is not simulated, the controller restarts with empty mailboxes
+						entry.node->onBusOff();
+						entry.errors = 0;
+						++stats.busOffs;
+					}
+				}
+			}
+			return true;
+		}
+
+		// Controllers which send identical frames complete the transmission together
+		for (auto &entry : nodes) {
+			entry.sending = entry.node->peek() != nullptr && arbitrationKey(entry.node->peek()->message) == key;
+		}
+
+		occupy(length);
+		++stats.frames;
+		frameLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(SimTime::nanoseconds()
+			- frame.queued));
+		trackTransfer(frame);
+
+		for (auto &entry : nodes) {
+			if (entry.sending) {
+				entry.errors -= std::min(entry.errors, 1U);
+				entry.node->onTransmitted();
+			} else {
+				entry.node->onReceived(frame.message);
+			}
+		}
+
+		return true;
+	}
+
+	//!
+	//! Run the simulation for a period of time.
+	//! \param duration Duration of the period.
+	//! \param timers Function which services timers of all nodes and returns the next wake-up time.
+	//!
+	void run(std::chrono::microseconds aDuration, std::function<std::chrono::microseconds ()> aTimers = nullptr)
+	{
+		const std::chrono::nanoseconds end = SimTime::nanoseconds() + aDuration;
+
+		while (SimTime::nanoseconds() < end) {
+			std::chrono::nanoseconds limit = end;
+
+			if (aTimers != nullptr) {
+				// Timers which are already due are serviced again after the next event
+				limit = std::min(limit, std::max<std::chrono::nanoseconds>(aTimers(),
+					SimTime::nanoseconds() + std::chrono::microseconds{1}));
+			}
+
+			step(limit);
+		}
+	}
+
+	//!
+	//! Arbitration field in the order of transmission, lower values win.
+	//! Standard frames are padded, so they win against extended frames with the same base identifier.
+	//!
+	static uint32_t arbitrationKey(const CanMessage &aMessage)
+	{
+		const uint32_t rtr = (aMessage.flags & CanMessage::RTR) ? 1 : 0;
+
+		if (aMessage.flags & CanMessage::EXT) {
+			return ((aMessage.id >> 18) & 0x7FF) << 21 | 1U << 20 | 1U << 19 | (aMessage.id & 0x3FFFF) << 1 | rtr;
+		} else {
+			return (aMessage.id & 0x7FF) << 21 | rtr << 20;
+		}
+	}
+
+	//!
+	//! Length of the frame on the bus including stuff bits and the interframe space.
+	//!
+	static unsigned int frameBits(const CanMessage &aMessage)
+	{
+		uint8_t bits[1 + 32 + 6 + 64 + 15];
+		unsigned int count = 0;
+
+		auto append = [&bits, &count](uint32_t aValue, unsigned int aWidth) {
+			while (aWidth--) {
+				bits[count++] = static_cast<uint8_t>((aValue >> aWidth) & 1);
+			}
+		};
+
+		const bool remote = (aMessage.flags & CanMessage::RTR) != 0;
+
+		append(0, 1); // Start of frame
+		if (aMessage.flags & CanMessage::EXT) {
+			append(aMessage.id >> 18, 11);
+			append(3, 2); // SRR and IDE
+			append(aMessage.id, 18);
+			append(remote ? 1 : 0, 1);
+			append(0, 2); // Reserved bits r1 and r0
+		} else {
+			append(aMessage.id, 11);
+			append(remote ? 1 : 0, 1);
+			append(0, 2); // IDE and r0
+		}
+		append(aMessage.length, 4);
+		if (!remote) {
+			for (size_t i = 0; i < std::min<size_t>(aMessage.length, static_cast<size_t>(CanMessage::kMaxLength)); ++i) {
+				append(aMessage.data[i], 8);
+			}
+		}
+		append(crc15(bits, count), 15);
+
+		unsigned int stuffed = 0;
+		unsigned int run = 0;
+		uint8_t previous = 2;
+
+		for (unsigned int i = 0; i < count; ++i) {
+			run = bits[i] == previous ? run + 1 : 1;
+			previous = bits[i];
+
+			if (run == 5) {
+				// Stuff bit has the opposite value and starts a new run
+				++stuffed;
+				previous = static_cast<uint8_t>(!previous);
+				run = 1;
+			}
+		}
+
+		// CRC delimiter, acknowledgement slot and delimiter, end of frame
+		return count + stuffed + 1 + 2 + 7 + kInterframeBits;
+	}
+
+private:
+	struct Entry {
+		VirtualCanNode *node;
+		unsigned int errors; //!< Transmit error counter
+		bool sending;
+	};
+
+	std::vector<Entry> nodes;
+	std::unordered_map<uint32_t, std::chrono::nanoseconds> requests;
+	LatencyHistogram requestLatency;
+	LatencyHistogram frameLatency;
+	Statistics stats;
+	std::chrono::nanoseconds origin;
+	uint32_t bitrate;
+	double errorRate;
+	uint32_t seed;
+	uint32_t key{0};
+	bool collision{false};
+
+	static uint16_t crc15(const uint8_t *aBits, unsigned int aCount)
+	{
+		uint16_t crc = 0;
+
+		for (unsigned int i = 0; i < aCount; ++i) {
+			const bool next = (aBits[i] ^ (crc >> 14)) & 1;
+
+			crc = static_cast<uint16_t>((crc << 1) & 0x7FFF);
+			if (next) {
+				crc ^= 0x4599;
+			}
+		}
+
+		return crc;
+	}
+
+	//!
+	//! Find the frame with the lowest arbitration field, error passive controllers
+	//! take part only when error active controllers are silent.
+	//! Identical arbitration fields with different content are detected as a collision.
+	//!
+	Entry *arbitrate()
+	{
+		Entry *winner = nullptr;
+		bool passive = true;
+
+		collision = false;
+
+		for (auto &entry : nodes) {
+			const VirtualCanFrame * const frame = entry.node->peek();
+
+			if (frame == nullptr) {
+				continue;
+			}
+
+			const uint32_t current = arbitrationKey(frame->message);
+			const bool currentPassive = entry.errors >= kErrorPassiveLimit;
+
+			if (winner == nullptr || (passive && !currentPassive) || (passive == currentPassive && current < key)) {
+				winner = &entry;
+				key = current;
+				passive = currentPassive;
+				collision = false;
+			} else if (passive == currentPassive && current == key) {
+				collision = collision || !isEqual(winner->node->peek()->message, frame->message);
+			}
+		}
+
+		return winner;
+	}
+
+	static bool isEqual(const CanMessage &aFirst, const CanMessage &aSecond)
+	{
+		return aFirst.id == aSecond.id && aFirst.flags == aSecond.flags && aFirst.length == aSecond.length
+			&& std::equal(aFirst.data, aFirst.data + aFirst.length, aSecond.data);
+	}
+
+	void occupy(unsigned int aBits)
+	{
+		const std::chrono::nanoseconds duration{static_cast<uint64_t>(aBits) * 1000000000ULL / bitrate};
+
+		stats.bits += aBits;
+		stats.busy += duration;
+		SimTime::advanceTo(SimTime::nanoseconds() + duration);
+	}
+
+	//!
+	//! Uniform random value in the range [0, 1).
+	//!
+	double random()
+	{
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		return static_cast<double>(seed) / 4294967296.0;
+	}
+
+	//!
+	//! Match UAVCAN service responses with requests.
+	//! Identifier layout: priority, service type, request flag, destination, service flag, source.
+	//! Tail byte: start and end of transfer flags, toggle bit and transfer identifier.
+	//!
+	void trackTransfer(const VirtualCanFrame &aFrame)
+	{
+		const CanMessage &message = aFrame.message;
+
+		if (!(message.flags & CanMessage::EXT) || !message.length || !(message.id & 0x80)) {
+			return;
+		}
+
+		const uint32_t source = message.id & 0x7F;
+		const uint32_t destination = (message.id >> 8) & 0x7F;
+		const bool request = (message.id & 0x8000) != 0;
+		const uint8_t tail = message.data[message.length - 1];
+		const uint32_t client = request ? source : destination;
+		const uint32_t server = request ? destination : source;
+		const uint32_t transfer = ((message.id >> 16) & 0xFF) << 24 | client << 16 | server << 8 | (tail & 0x1F);
+
+		if (request && (tail & 0x80)) {
+			requests[transfer] = aFrame.queued;
+		} else if (!request && (tail & 0x40)) {
+			const auto iter = requests.find(transfer);
+
+			if (iter != requests.end()) {
+				requestLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(SimTime::nanoseconds()
+					- iter->second));
+				requests.erase(iter);
+			}
+		}
+	}
+};
+
+//!
+//! Controller of VirtualCanBus with the interface of CAN drivers, so it can be used as the bus type
+//! of UavCanHandler. Like bxCAN, three transmit mailboxes are arbitrated by identifier,
+//! frames wait in the software queue in order of writing.
+//! \tparam rxSize Capacity of the receive queue.
+//! \tparam txSize Capacity of the transmit queue.
+//!
+template<size_t rxSize, size_t txSize>
+class VirtualCan : public VirtualCanNode {
+	static constexpr size_t kMailboxes{3};
+	static constexpr size_t kMaxFilters{28};
+
+public:
+	VirtualCan(VirtualCanBus &aBus, std::function<void ()> aCallback = nullptr) :
+		bus{aBus},
+		rxQueue{},
+		txQueue{},
+		mailboxes{},
+		callback{aCallback},
+		stats{},
+		filters{},
+		filterCount{0},
+		occupied{0}
+	{
+		bus.attach(this);
+	}
+
+	VirtualCan(const VirtualCan &) = delete;
+	VirtualCan &operator=(const VirtualCan &) = delete;
+
+	~VirtualCan() override
+	{
+		bus.detach(this);
+	}
+
+	CanStatistics getStatistics() const
+	{
+		return stats;
+	}
+
+	void setCallback(std::function<void ()> aCallback)
+	{
+		callback = aCallback;
+	}
+
+	void setFilters(const CanFilter *aFilters, size_t aCount)
+	{
+		filterCount = std::min(aCount, kMaxFilters);
+		std::copy(aFilters, aFilters + filterCount, filters);
+	}
+
+	size_t read(CanMessage *aBuffer, size_t aLength)
+	{
+		return rxQueue.pop(aBuffer, aLength);
+	}
+
+	size_t write(const CanMessage *aBuffer, size_t aLength)
+	{
+		size_t count = 0;
+
+		while (count < aLength && !txQueue.full()) {
+			VirtualCanFrame frame{aBuffer[count++], SimTime::nanoseconds()};
+
+			frame.message.id &= (frame.message.flags & CanMessage::EXT) ? 0x1FFFFFFFUL : 0x7FFUL;
+			txQueue.push(frame);
+		}
+
+		load();
+		return count;
+	}
+
+	const VirtualCanFrame *peek() const override
+	{
+		const VirtualCanFrame *result = nullptr;
+
+		for (size_t i = 0; i < occupied; ++i) {
+			if (result == nullptr || VirtualCanBus::arbitrationKey(mailboxes[i].message)
+					< VirtualCanBus::arbitrationKey(result->message)) {
+				result = &mailboxes[i];
+			}
+		}
+
+		return result;
+	}
+
+	void onTransmitted() override
+	{
+		const VirtualCanFrame * const frame = peek();
+		const size_t index = static_cast<size_t>(frame - mailboxes);
+
+		std::copy(mailboxes + index + 1, mailboxes + occupied, mailboxes + index);
+		--occupied;
+		++stats.tx;
+		load();
+	}
+
+	void onTransmitError() override
+	{
+		++stats.errors;
+	}
+
+	void onBusOff() override
+	{
+		occupied = 0;
+		txQueue.clear();
+	}
+
+	void onReceived(const CanMessage &aMessage) override
+	{
+		if (!isAccepted(aMessage)) {
+			return;
+		}
+
+		if (rxQueue.full()) {
+			++stats.errors;
+			return;
+		}
+
+		CanMessage message = aMessage;
+
+		message.timestamp = SimTime::time();
+		rxQueue.push(message);
+		++stats.rx;
+
+		if (callback != nullptr) {
+			callback();
+		}
+	}
+
+private:
+	VirtualCanBus &bus;
+	Queue<CanMessage, rxSize> rxQueue;
+	Queue<VirtualCanFrame, txSize> txQueue;
+	VirtualCanFrame mailboxes[kMailboxes];
+	std::function<void ()> callback;
+	CanStatistics stats;
+	CanFilter filters[kMaxFilters];
+	size_t filterCount;
+	size_t occupied;
+
+	void load()
+	{
+		while (occupied < kMailboxes && !txQueue.empty()) {
+			mailboxes[occupied++] = txQueue.pop();
+		}
+	}
+
+	bool isAccepted(const CanMessage &aMessage) const
+	{
+		if (!filterCount) {
+			return true;
+		}
+
+		return std::any_of(filters, filters + filterCount, [&aMessage](const CanFilter &aFilter) {
+			return (aMessage.id & aFilter.mask) == (aFilter.id & aFilter.mask);
+		});
+	}
+};
+
+} // namespace Device
+
+#endif // DRONEDEVICE_STUBS_VIRTUALCANBUS_HPP_
@@ -0,0 +1,80 @@
+//
+// TaskQueue.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_TASKQUEUE_HPP_
+#define DRONEDEVICE_TASKQUEUE_HPP_
+
+#include <DroneDevice/Queue.hpp>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+//!
+//! Set of task queues with different priorities, the queue is not thread-safe.
+//! Tasks should be assignable from nullptr, captures are released when the task is removed.
+//! \tparam Task Task type.
+//! \tparam capacity Capacity of the queue of each priority.
+//! \tparam priorities Number of priority levels, zero is the highest priority.
+//!
+template<typename Task, size_t capacity, size_t priorities = 1>
+class TaskQueue {
+	static_assert(priorities > 0 && priorities <= 8, "Incorrect priority count");
+
+public:
+	bool empty() const
+	{
+		return !pending;
+	}
+
+	bool full(size_t aPriority) const
+	{
+		assert(aPriority < priorities);
+		return queues[aPriority].full();
+	}
+
+	bool push(const Task &aTask, size_t aPriority)
+	{
+		assert(aPriority < priorities);
+
+		if (queues[aPriority].full()) {
+			return false;
+		}
+
+		queues[aPriority].push(aTask);
+		pending = static_cast<uint8_t>(pending | (1 << aPriority));
+		return true;
+	}
+
+	//!
+	//! Remove the oldest task with the highest priority.
+	//! \param task Destination for the task.
+	//! \return True when the task was removed.
+	//!
+	bool pop(Task &aTask)
+	{
+		if (!pending) {
+			return false;
+		}
+
+		const size_t priority = static_cast<size_t>(__builtin_ctz(pending));
+
+		aTask = queues[priority].front();
+		queues[priority].front() = nullptr;
+		queues[priority].pop();
+
+		if (queues[priority].empty()) {
+			pending = static_cast<uint8_t>(pending & ~(1 << priority));
+		}
+
+		return true;
+	}
+
+private:
+	Queue<Task, capacity> queues[priorities];
+	uint8_t pending{0};
+};
+
+#endif // DRONEDEVICE_TASKQUEUE_HPP_
@@ -0,0 +1,368 @@
+//
+// TimerWheel.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_TIMERWHEEL_HPP_
+#define DRONEDEVICE_TIMERWHEEL_HPP_
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+//!
+//! Hierarchical timer wheel. Timers are kept in intrusive lists, so arming and cancelling take
+//! constant time, and occupied slots are tracked with bitmaps, so the time of the next event is
+//! found without scanning the timers. Time spent in poll() depends on the number of due timers only.
+//! \tparam Clock Time source with a static microseconds() method. scheduleWakeUp() additionally requires
+//! a static wakeAt(deadline) method that programs an interrupt at the deadline, owners that return
+//! the deadline from poll() to their caller may use clocks without a wake up source.
+//! \tparam resolution Duration of a tick in microseconds, deadlines are rounded up to ticks.
+//! \tparam levels Number of wheels, each next one has 32 times coarser slots.
+//!
+template<class Clock, uint32_t resolution = 1000, size_t levels = 4>
+class TimerWheel {
+	static_assert(resolution > 0, "Incorrect resolution");
+	static_assert(levels > 0 && levels <= 8, "Incorrect level count");
+
+	static constexpr unsigned int kBits{5};
+	static constexpr size_t kSlots{1 << kBits};
+	static constexpr uint64_t kMask{kSlots - 1};
+	static constexpr uint8_t kOverflow{levels};
+
+public:
+	class Timer {
+		friend class TimerWheel;
+
+	public:
+		explicit Timer(std::function<void ()> aCallback = nullptr) :
+			callback{aCallback}
+		{
+		}
+
+		Timer(const Timer &) = delete;
+		Timer &operator=(const Timer &) = delete;
+
+		~Timer()
+		{
+			if (owner != nullptr) {
+				owner->cancel(*this);
+			}
+		}
+
+		bool armed() const
+		{
+			return owner != nullptr;
+		}
+
+		std::chrono::microseconds deadline() const
+		{
+			return std::chrono::microseconds{static_cast<int64_t>(expiry * resolution)};
+		}
+
+		void setCallback(std::function<void ()> aCallback)
+		{
+			callback = aCallback;
+		}
+
+	private:
+		std::function<void ()> callback;
+		TimerWheel *owner{nullptr};
+		Timer *next{nullptr};
+		Timer **prev{nullptr};
+		uint64_t expiry{0};
+		uint8_t level{0};
+		uint8_t slot{0};
+	};
+
+	TimerWheel()
+	{
+		for (auto &wheel : slots) {
+			for (auto &head : wheel) {
+				head = nullptr;
+			}
+		}
+	}
+
+	TimerWheel(const TimerWheel &) = delete;
+	TimerWheel &operator=(const TimerWheel &) = delete;
+
+	~TimerWheel()
+	{
+		// Timers may outlive the wheel, they should not unlink themselves from it
+		for (auto &wheel : slots) {
+			for (auto head : wheel) {
+				release(head);
+			}
+		}
+
+		release(overflow);
+	}
+
+	//!
+	//! Arm the timer, previous deadline of an armed timer is replaced.
+	//! \param timer Timer to be armed.
+	//! \param deadline Absolute time when the callback should be called.
+	//!
+	void arm(Timer &aTimer, std::chrono::microseconds aDeadline)
+	{
+		if (aTimer.owner != nullptr) {
+			aTimer.owner->cancel(aTimer);
+		}
+
+		const int64_t deadline = aDeadline.count() > 0 ? aDeadline.count() : 0;
+
+		aTimer.expiry = (static_cast<uint64_t>(deadline) + resolution - 1) / resolution;
+		aTimer.owner = this;
+		insert(aTimer);
+	}
+
+	//!
+	//! Arm the timer unless it is already armed with an earlier deadline.
+	//!
+	void armEarlier(Timer &aTimer, std::chrono::microseconds aDeadline)
+	{
+		if (aTimer.owner != this || aDeadline < aTimer.deadline()) {
+			arm(aTimer, aDeadline);
+		}
+	}
+
+	void cancel(Timer &aTimer)
+	{
+		if (aTimer.owner == this) {
+			unlink(aTimer);
+			aTimer.owner = nullptr;
+		}
+	}
+
+	//!
+	//! Call callbacks of the expired timers, callbacks may arm and cancel timers.
+	//! Timers armed from callbacks with elapsed deadlines expire at the next tick.
+	//! \return Deadline of the earliest armed timer or microseconds::max() when there are no timers.
+	//!
+	std::chrono::microseconds poll()
+	{
+		advance(static_cast<uint64_t>(Clock::microseconds().count()) / resolution);
+		return nextDeadline();
+	}
+
+	std::chrono::microseconds nextDeadline() const
+	{
+		const uint64_t next = nextEvent();
+
+		if (next == UINT64_MAX) {
+			return std::chrono::microseconds::max();
+		}
+
+		return std::chrono::microseconds{static_cast<int64_t>(next * resolution)};
+	}
+
+	//!
+	//! Request a wake up interrupt at the earliest deadline. Should be called
+	//! with interrupts disabled just before entering the sleep mode.
+	//!
+	void scheduleWakeUp() const
+	{
+		static_assert(std::is_void<decltype(Clock::wakeAt(std::chrono::microseconds{}))>::value,
+			"Clock without a wake up source");
+
+		Clock::wakeAt(nextDeadline());
+	}
+
+private:
+	Timer *slots[levels][kSlots];
+	Timer *overflow{nullptr};
+	uint32_t occupied[levels]{};
+	uint64_t current{0};
+	bool expiring{false};
+
+	static unsigned int countTrailingZeros(uint32_t aValue)
+	{
+		return static_cast<unsigned int>(__builtin_ctz(aValue));
+	}
+
+	static uint32_t bit(size_t aSlot)
+	{
+		return static_cast<uint32_t>(1) << aSlot;
+	}
+
+	static void release(Timer *aTimer)
+	{
+		while (aTimer != nullptr) {
+			Timer * const next = aTimer->next;
+
+			aTimer->owner = nullptr;
+			aTimer->next = nullptr;
+			aTimer->prev = nullptr;
+			aTimer = next;
+		}
+	}
+
+	void insert(Timer &aTimer)
+	{
+		// Overdue timers are placed into the current slot, timers armed while the slot expires are placed
+		// into the following slot, so the expiration loop always ends
+		const uint64_t earliest = expiring ? current + 1 : current;
+		const uint64_t expiry = aTimer.expiry > earliest ? aTimer.expiry : earliest;
+		const uint64_t difference = expiry ^ current;
+		uint8_t level = 0;
+
+		// Timer is placed on the level of the most significant digit that differs from the current time
+		while (level < levels && (difference >> (kBits * (level + 1))) != 0) {
+			++level;
+		}
+
+		Timer **head;
+
+		if (level == kOverflow) {
+			aTimer.slot = 0;
+			head = &overflow;
+		} else {
+			aTimer.slot = static_cast<uint8_t>((expiry >> (kBits * level)) & kMask);
+			occupied[level] |= bit(aTimer.slot);
+			head = &slots[level][aTimer.slot];
+		}
+
+		aTimer.level = level;
+		aTimer.prev = head;
+		aTimer.next = *head;
+
+		if (*head != nullptr) {
+			(*head)->prev = &aTimer.next;
+		}
+
+		*head = &aTimer;
+	}
+
+	void unlink(Timer &aTimer)
+	{
+		*aTimer.prev = aTimer.next;
+
+		if (aTimer.next != nullptr) {
+			aTimer.next->prev = aTimer.prev;
+		}
+
+		if (aTimer.level != kOverflow && slots[aTimer.level][aTimer.slot] == nullptr) {
+			occupied[aTimer.level] &= ~bit(aTimer.slot);
+		}
+
+		aTimer.next = nullptr;
+		aTimer.prev = nullptr;
+	}
+
+	//!
+	//! Find the earliest tick when a slot should be cascaded or expired.
+	//!
+	uint64_t nextEvent() const
+	{
+		uint64_t result = UINT64_MAX;
+
+		for (size_t level = 0; level < levels; ++level) {
+			const unsigned int shift = static_cast<unsigned int>(kBits * level);
+			const uint32_t digit = static_cast<uint32_t>((current >> shift) & kMask);
+			const uint32_t pending = occupied[level] & ~(bit(digit) - 1);
+
+			if (pending) {
+				const uint64_t block = (current >> (shift + kBits)) << (shift + kBits);
+				uint64_t time = block | (static_cast<uint64_t>(countTrailingZeros(pending)) << shift);
+
+				if (time < current) {
+					time = current;
+				}
+				if (time < result) {
+					result = time;
+				}
+			}
+		}
+
+		if (overflow != nullptr) {
+			const unsigned int shift = static_cast<unsigned int>(kBits * levels);
+			const uint64_t time = ((current >> shift) + 1) << shift;
+
+			if (time < result) {
+				result = time;
+			}
+		}
+
+		return result;
+	}
+
+	void cascade(Timer **aHead)
+	{
+		// Timers are detached first because some of them may return to the same list
+		Timer *timer = *aHead;
+		*aHead = nullptr;
+
+		while (timer != nullptr) {
+			Timer * const next = timer->next;
+
+			if (timer->level != kOverflow) {
+				occupied[timer->level] &= ~bit(timer->slot);
+			}
+
+			insert(*timer);
+			timer = next;
+		}
+	}
+
+	void advance(uint64_t aTarget)
+	{
+		while (true) {
+			const uint64_t next = nextEvent();
+
+			if (next > aTarget) {
+				if (aTarget > current) {
+					current = aTarget;
+				}
+				break;
+			}
+
+			current = next;
+
+			// Move timers from coarse slots to finer ones, starting from the coarsest slot
+			if (overflow != nullptr && (current & ((1ULL << (kBits * levels)) - 1)) == 0) {
+				cascade(&overflow);
+			}
+
+			for (size_t level = levels - 1; level > 0; --level) {
+				const size_t digit = static_cast<size_t>((current >> (kBits * level)) & kMask);
+
+				if (occupied[level] & bit(digit)) {
+					cascade(&slots[level][digit]);
+				}
+			}
+
+			// Expired timers are detached into a local list, callbacks may cancel any of them
+			const size_t slot = static_cast<size_t>(current & kMask);
+			Timer *expired = slots[0][slot];
+
+			slots[0][slot] = nullptr;
+			occupied[0] &= ~bit(slot);
+
+			if (expired != nullptr) {
+				expired->prev = &expired;
+			}
+
+			expiring = true;
+
+			while (expired != nullptr) {
+				Timer &timer = *expired;
+
+				unlink(timer);
+				timer.owner = nullptr;
+
+				if (timer.callback) {
+					timer.callback();
+				}
+			}
+
+			expiring = false;
+		}
+	}
+};
+
+#endif // DRONEDEVICE_TIMERWHEEL_HPP_
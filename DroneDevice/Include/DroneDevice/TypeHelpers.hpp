@@ -8,11 +8,26 @@
 #ifndef DRONEDEVICE_TYPEHELPERS_HPP_
 #define DRONEDEVICE_TYPEHELPERS_HPP_
 
+#include <cstddef>
+
 namespace TypeHelpers {
 
 template<typename T, typename M> M getMemberType(M T::*);
 template<typename T, typename M> T getClassType(M T::*);
 
+template<typename T, typename... Ts>
+struct IndexOf;
+
+template<typename T, typename... Ts>
+struct IndexOf<T, T, Ts...> {
+	static constexpr size_t value = 0;
+};
+
+template<typename T, typename U, typename... Ts>
+struct IndexOf<T, U, Ts...> {
+	static constexpr size_t value = 1 + IndexOf<T, Ts...>::value;
+};
+
 }
 
 #endif // DRONEDEVICE_TYPEHELPERS_HPP_
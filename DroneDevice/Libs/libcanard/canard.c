@@ -254,7 +254,7 @@ void canardPopTxQueue(CanardInstance* ins)
 {
     CanardTxQueueItem* item = ins->tx_queue;
     ins->tx_queue = item->next;
-    freeBlock(&ins->allocator, item);
+    freeBlockFor(&ins->allocator, item, CanardBlockTxItem);
 }
 
 void canardHandleRxFrame(CanardInstance* ins, const CanardCANFrame* frame, uint64_t timestamp_usec)
@@ -521,7 +521,7 @@ void canardCleanupStaleTransfers(CanardInstance* ins, uint64_t current_time_usec
             {
                 releaseStatePayload(ins, state);
                 ins->rx_states = ins->rx_states->next;
-                freeBlock(&ins->allocator, state);
+                freeBlockFor(&ins->allocator, state, CanardBlockRxState);
                 state = ins->rx_states;
                 prev = state;
             }
@@ -529,7 +529,7 @@ void canardCleanupStaleTransfers(CanardInstance* ins, uint64_t current_time_usec
             {
                 releaseStatePayload(ins, state);
                 prev->next = state->next;
-                freeBlock(&ins->allocator, state);
+                freeBlockFor(&ins->allocator, state, CanardBlockRxState);
                 state = prev->next;
             }
         }
@@ -786,7 +786,7 @@ void canardReleaseRxTransferPayload(CanardInstance* ins, CanardRxTransfer* trans
     while (transfer->payload_middle != NULL)
     {
         CanardBufferBlock* const temp = transfer->payload_middle->next;
-        freeBlock(&ins->allocator, transfer->payload_middle);
+        freeBlockFor(&ins->allocator, transfer->payload_middle, CanardBlockRxBuffer);
         transfer->payload_middle = temp;
     }
 
@@ -801,6 +801,11 @@ CanardPoolAllocatorStatistics canardGetPoolAllocatorStatistics(const CanardInsta
     return ins->allocator.statistics;
 }
 
+CanardPoolAllocatorUsage canardGetPoolAllocatorUsage(const CanardInstance* ins)
+{
+    return ins->allocator.usage;
+}
+
 CanardTransferStatistics canardGetTransferStatistics(const CanardInstance* ins)
 {
     return ins->transfer_statistics;
@@ -1042,7 +1047,7 @@ CANARD_INTERNAL void pushTxQueue(CanardInstance* ins, CanardTxQueueItem* item)
  */
 CANARD_INTERNAL CanardTxQueueItem* createTxItem(CanardPoolAllocator* allocator)
 {
-    CanardTxQueueItem* item = (CanardTxQueueItem*) allocateBlock(allocator);
+    CanardTxQueueItem* item = (CanardTxQueueItem*) allocateBlockFor(allocator, CanardBlockTxItem);
     if (item == NULL)
     {
         return NULL;
@@ -1222,7 +1227,7 @@ CANARD_INTERNAL CanardRxState* createRxState(CanardPoolAllocator* allocator, uin
         .dtid_tt_snid_dnid = transfer_descriptor
     };
 
-    CanardRxState* state = (CanardRxState*) allocateBlock(allocator);
+    CanardRxState* state = (CanardRxState*) allocateBlockFor(allocator, CanardBlockRxState);
     if (state == NULL)
     {
         return NULL;
@@ -1237,7 +1242,7 @@ CANARD_INTERNAL uint64_t releaseStatePayload(CanardInstance* ins, CanardRxState*
     while (rxstate->buffer_blocks != NULL)
     {
         CanardBufferBlock* const temp = rxstate->buffer_blocks->next;
-        freeBlock(&ins->allocator, rxstate->buffer_blocks);
+        freeBlockFor(&ins->allocator, rxstate->buffer_blocks, CanardBlockRxBuffer);
         rxstate->buffer_blocks = temp;
     }
     rxstate->payload_len = 0;
@@ -1350,7 +1355,7 @@ CANARD_INTERNAL int16_t bufferBlockPushBytes(CanardPoolAllocator* allocator,
 
 CANARD_INTERNAL CanardBufferBlock* createBufferBlock(CanardPoolAllocator* allocator)
 {
-    CanardBufferBlock* block = (CanardBufferBlock*) allocateBlock(allocator);
+    CanardBufferBlock* block = (CanardBufferBlock*) allocateBlockFor(allocator, CanardBlockRxBuffer);
     if (block == NULL)
     {
         return NULL;
@@ -1589,6 +1594,8 @@ CANARD_INTERNAL void initPoolAllocator(CanardPoolAllocator* allocator,
     allocator->statistics.capacity_blocks = buf_len;
     allocator->statistics.current_usage_blocks = 0;
     allocator->statistics.peak_usage_blocks = 0;
+
+    memset(&allocator->usage, 0, sizeof(allocator->usage));
 }
 
 CANARD_INTERNAL void* allocateBlock(CanardPoolAllocator* allocator)
@@ -1623,3 +1630,30 @@ CANARD_INTERNAL void freeBlock(CanardPoolAllocator* allocator, void* p)
     CANARD_ASSERT(allocator->statistics.current_usage_blocks > 0);
     allocator->statistics.current_usage_blocks--;
 }
+
+CANARD_INTERNAL void* allocateBlockFor(CanardPoolAllocator* allocator, CanardBlockPurpose purpose)
+{
+    void* result = allocateBlock(allocator);
+
+    if (result == NULL)
+    {
+        allocator->usage.failures[purpose]++;
+        return NULL;
+    }
+
+    allocator->usage.current_blocks[purpose]++;
+    if (allocator->usage.peak_blocks[purpose] < allocator->usage.current_blocks[purpose])
+    {
+        allocator->usage.peak_blocks[purpose] = allocator->usage.current_blocks[purpose];
+    }
+
+    return result;
+}
+
+CANARD_INTERNAL void freeBlockFor(CanardPoolAllocator* allocator, void* p, CanardBlockPurpose purpose)
+{
+    freeBlock(allocator, p);
+
+    CANARD_ASSERT(allocator->usage.current_blocks[purpose] > 0);
+    allocator->usage.current_blocks[purpose]--;
+}
@@ -200,6 +200,29 @@ typedef struct
     uint16_t peak_usage_blocks;             ///< Maximum number of blocks used since initialization
 } CanardPoolAllocatorStatistics;
 
+/**
+ * Purposes of memory blocks, used to break the pool usage down.
+ */
+typedef enum
+{
+    CanardBlockRxState = 0,                 ///< Reception state of a transfer, one per transfer descriptor
+    CanardBlockRxBuffer,                    ///< Payload of a multi-frame transfer being received
+    CanardBlockTxItem,                      ///< Frame in the transmission queue
+    CanardBlockPurposeCount
+} CanardBlockPurpose;
+
+/**
+ * This structure provides pool usage per block purpose and counters of failed allocations.
+ * Failed allocations of reception blocks result in dropped transfers, failed allocations of transmission blocks
+ * result in errors returned by canardBroadcast() and canardRequestOrRespond().
+ */
+typedef struct
+{
+    uint16_t current_blocks[CanardBlockPurposeCount];   ///< Number of blocks currently allocated for each purpose
+    uint16_t peak_blocks[CanardBlockPurposeCount];      ///< Maximum number of blocks used for each purpose
+    uint32_t failures[CanardBlockPurposeCount];         ///< Number of allocations failed due to an exhausted pool
+} CanardPoolAllocatorUsage;
+
 /**
  * This structure provides statistics of received transfers.
  * This data helps to detect interface errors and buffer overflows.
@@ -221,6 +244,7 @@ typedef struct
 {
     CanardPoolAllocatorBlock* free_list;
     CanardPoolAllocatorStatistics statistics;
+    CanardPoolAllocatorUsage usage;
 } CanardPoolAllocator;
 
 /**
@@ -493,6 +517,13 @@ void canardReleaseRxTransferPayload(CanardInstance* ins,
  */
 CanardPoolAllocatorStatistics canardGetPoolAllocatorStatistics(const CanardInstance* ins);
 
+/**
+ * Returns a copy of the pool usage per block purpose.
+ * Refer to the type CanardPoolAllocatorUsage.
+ * Use this function to find out which kind of traffic exhausts the pool.
+ */
+CanardPoolAllocatorUsage canardGetPoolAllocatorUsage(const CanardInstance* ins);
+
 /**
  * Returns a copy of the transfer statistics.
  * Refer to the type CanardTransferStatistics.
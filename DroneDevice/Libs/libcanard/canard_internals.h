@@ -181,6 +181,19 @@ CANARD_INTERNAL void* allocateBlock(CanardPoolAllocator* allocator);
 CANARD_INTERNAL void freeBlock(CanardPoolAllocator* allocator,
                                void* p);
 
+/**
+ * Allocates a block and accounts it to the given purpose.
+ */
+CANARD_INTERNAL void* allocateBlockFor(CanardPoolAllocator* allocator,
+                                       CanardBlockPurpose purpose);
+
+/**
+ * Frees a block previously returned by allocateBlockFor with the same purpose.
+ */
+CANARD_INTERNAL void freeBlockFor(CanardPoolAllocator* allocator,
+                                  void* p,
+                                  CanardBlockPurpose purpose);
+
 /// Abort the build if the current platform is not supported.
 CANARD_STATIC_ASSERT(((uint32_t)CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE) < 32,
                      "Platforms where sizeof(void*) > 4 are not supported. "
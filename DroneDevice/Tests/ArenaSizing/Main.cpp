@@ -0,0 +1,187 @@
+//
+// Main.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "../Common/CaptureNetwork.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+// Recommends sizes of libcanard arenas for a workload: ArenaSizing [nodes | trace file].
+// The workload is either a capture of the virtual network with a master reading files of all nodes
+// or a trace in the format of CanTrace. The trace is replayed into each protocol stack with a large arena,
+// the peak usage is the minimal pool size, which is verified with a second replay.
+
+using namespace std::chrono_literals;
+
+static constexpr size_t kLargeArenaSize{65536};
+static constexpr size_t kDefaultNodes{16};
+
+// Block layout of 32-bit targets, payload blocks of the host hold more data because of wider pointers
+static constexpr size_t kTargetBlockSize{24 + 2 * 4};
+static constexpr size_t kTargetBufferData{kTargetBlockSize - 4};
+static constexpr size_t kHostBufferData{CANARD_MEM_BLOCK_SIZE - sizeof(void *)};
+
+static constexpr size_t kMarginPercent{25};
+static constexpr size_t kArenaAlignment{64};
+
+//!
+//! Device which accepts all transfers, it is the worst case for any node on the bus.
+//!
+class Listener : public PlazCan::CanDevice {
+public:
+	Device::DeviceId getBusAddress() const override
+	{
+		return 126;
+	}
+
+	PlazCan::Status getStatus() const override
+	{
+		return PlazCan::Status{PlazCan::Mode::OPERATIONAL, PlazCan::Health::HEALTHY};
+	}
+
+	PlazCan::UidType getUID() const override
+	{
+		return PlazCan::UidType{};
+	}
+
+	bool onAcceptanceRequest(uint16_t, CanardTransferType, Device::DeviceId, Device::DeviceId) override
+	{
+		return true;
+	}
+
+	void onMessageReceived(const CanardRxTransfer *) override
+	{
+	}
+};
+
+using ListenerHandler = PlazCan::UavCanHandler<PlazCan::PlatformWrapper<Device::ReplayCan, Device::SimTime>, 1>;
+
+struct ListenerStack {
+	using Handler = ListenerHandler;
+
+	explicit ListenerStack(size_t aArenaSize) :
+		port{},
+		arena(aArenaSize),
+		handler{port, arena.data(), arena.size(), findUnknownHash},
+		listener{}
+	{
+		handler.attach(&listener);
+	}
+
+	static uint64_t findUnknownHash(CanardTransferType, uint16_t)
+	{
+		return 0;
+	}
+
+	Device::ReplayCan port;
+	std::vector<uint8_t> arena;
+	Handler handler;
+	Listener listener;
+};
+
+static void printHeader()
+{
+	printf("%-10s %6s %8s %9s %7s %8s %12s %12s\n", "Stack", "Peak", "RxState", "RxBuffer", "TxItem", "Failures",
+		"Minimal", "Recommended");
+}
+
+static void printRow(const char *aName, const PlazCan::PoolTelemetry &aTelemetry, uint32_t aVerifiedFailures)
+{
+	const auto &usage = aTelemetry.usage;
+	const size_t peak = aTelemetry.statistics.peak_usage_blocks;
+
+	// Payload blocks are scaled to the smaller data area of target blocks
+	const size_t extraBuffers = (usage.peak_blocks[CanardBlockRxBuffer] * kHostBufferData + kTargetBufferData - 1)
+		/ kTargetBufferData - usage.peak_blocks[CanardBlockRxBuffer];
+	const size_t minimal = (peak + extraBuffers) * kTargetBlockSize;
+	const size_t recommended = (minimal * (100 + kMarginPercent) / 100 + kArenaAlignment - 1)
+		/ kArenaAlignment * kArenaAlignment;
+
+	printf("%-10s %6zu %8u %9u %7u %8u %12zu %12zu%s\n", aName, peak,
+		static_cast<unsigned int>(usage.peak_blocks[CanardBlockRxState]),
+		static_cast<unsigned int>(usage.peak_blocks[CanardBlockRxBuffer]),
+		static_cast<unsigned int>(usage.peak_blocks[CanardBlockTxItem]),
+		static_cast<unsigned int>(aTelemetry.failures), minimal, recommended,
+		aVerifiedFailures ? " (verification failed)" : "");
+}
+
+template<typename Stack>
+static void sizeStack(const char *aName, const Device::CanTrace &aTrace)
+{
+	Device::SimTime::reset();
+	Stack large{kLargeArenaSize};
+	const auto result = Device::CanTraceReplay<typename Stack::Handler>::run(large.handler, aTrace);
+
+	// Replay is deterministic, the same workload must fit into the peak number of blocks
+	Device::SimTime::reset();
+	Stack minimal{result.pool.statistics.peak_usage_blocks * CANARD_MEM_BLOCK_SIZE};
+	const auto verified = Device::CanTraceReplay<typename Stack::Handler>::run(minimal.handler, aTrace);
+
+	printRow(aName, result.pool, verified.pool.failures);
+}
+
+int main(int argc, char **argv)
+{
+	Device::CanTrace trace;
+	const char * const argument = argc > 1 ? argv[1] : nullptr;
+	char *end = nullptr;
+	const size_t nodes = argument != nullptr ? strtoul(argument, &end, 10) : kDefaultNodes;
+
+	if (argument != nullptr && *end != '\0') {
+		if (!trace.load(argument)) {
+			fprintf(stderr, "Failed to load trace %s\n", argument);
+			return EXIT_FAILURE;
+		}
+
+		printf("Workload: %s, %zu frames, %.1f s\n", argument, trace.size(),
+			std::chrono::duration<double>(trace.duration()).count());
+		printHeader();
+		sizeStack<ListenerStack>("Listener", trace);
+		return EXIT_SUCCESS;
+	}
+
+	if (nodes < 1 || nodes > kMaxNodes) {
+		fprintf(stderr, "Number of nodes must be from 1 to %zu\n", kMaxNodes);
+		return EXIT_FAILURE;
+	}
+
+	Device::SimTime::reset();
+	Network network{nodes, 1000000};
+
+	network.run(30s);
+	for (size_t round = 0; round < 4; ++round) {
+		for (size_t i = 0; i < network.master.hub.size(); ++i) {
+			network.master.hub[i]->fileRead(0, 0, 64, nullptr, nullptr);
+		}
+		network.run(200ms);
+	}
+
+	trace = network.recorder.trace;
+	printf("Workload: %zu nodes, %zu allocated, %zu frames, %.1f s\n", nodes, network.master.hub.size(),
+		trace.size(), std::chrono::duration<double>(trace.duration()).count());
+	printHeader();
+
+	// Nodes are measured in the live network, their own transmissions are part of the workload
+	PlazCan::PoolTelemetry node = network.nodes.front()->handler.getPoolTelemetry();
+
+	for (const auto &entry : network.nodes) {
+		const auto telemetry = entry->handler.getPoolTelemetry();
+
+		if (telemetry.statistics.peak_usage_blocks > node.statistics.peak_usage_blocks) {
+			node = telemetry;
+		}
+	}
+	printRow("Node", node, 0);
+
+	auto &records = trace.records();
+
+	records.erase(std::remove_if(records.begin(), records.end(), [](const Device::CanTraceRecord &aRecord) {
+		return (aRecord.message.id & 0x7F) == kMasterAddress;
+	}), records.end());
+
+	sizeStack<ReplayMaster>("Master", trace);
+	sizeStack<ListenerStack>("Listener", trace);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+//
+// Aes.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "BaselineAes.hpp"
+#include "Benchmark.hpp"
+#include <DroneDevice/Aes.hpp>
+#include <vector>
+
+static constexpr char kKey[] = "2B7E151628AED2A6ABF7158809CF4F3C";
+static constexpr size_t kBlockLength{16};
+static constexpr size_t kLongLength{1 << 16};
+
+// Buffer is processed in place and is not restored, so the result depends on the iteration count
+static std::vector<uint8_t> &buffer()
+{
+	static std::vector<uint8_t> instance(Benchmark::data().begin(), Benchmark::data().begin() + kLongLength);
+	return instance;
+}
+
+template<typename T>
+static Benchmark::Body makeCbcBody(size_t aLength, bool aEncrypt)
+{
+	return [aLength, aEncrypt]() {
+		static T cipher{kKey};
+
+		if (aEncrypt) {
+			cipher.encrypt(buffer().data(), aLength);
+		} else {
+			cipher.decrypt(buffer().data(), aLength);
+		}
+
+		return static_cast<uint32_t>(buffer()[0]);
+	};
+}
+
+// Previous implementation decrypts a single block per call
+static Benchmark::Body makeBaselineCbcBody(size_t aLength)
+{
+	return [aLength]() {
+		static BaselineAes cipher{kKey};
+
+		for (size_t position = 0; position < aLength; position += kBlockLength) {
+			cipher.decrypt(buffer().data() + position);
+		}
+
+		return static_cast<uint32_t>(buffer()[0]);
+	};
+}
+
+static Benchmark::Body makeCtrBody(size_t aLength)
+{
+	return [aLength]() {
+		static const uint8_t counter[AesCipher::kBlockSize] = {};
+		static AesCtr cipher{kKey, counter};
+
+		cipher.process(buffer().data(), aLength);
+		return static_cast<uint32_t>(buffer()[0]);
+	};
+}
+
+static Benchmark baselineAesKey{"BaselineAesKey", AesCipher::kKeySize, []() {
+	BaselineAes cipher{kKey};
+	uint8_t block[kBlockLength] = {};
+
+	cipher.decrypt(block);
+	return static_cast<uint32_t>(block[0]);
+}};
+static Benchmark baselineAesCbcDecryptBlock{"BaselineAesCbcDecrypt/16", kBlockLength,
+	makeBaselineCbcBody(kBlockLength)};
+static Benchmark baselineAesCbcDecrypt{"BaselineAesCbcDecrypt/64K", kLongLength, makeBaselineCbcBody(kLongLength)};
+
+static Benchmark aesKey{"AesKey", AesCipher::kKeySize, []() {
+	const AesCipher cipher{kKey};
+	uint8_t block[AesCipher::kBlockSize] = {};
+
+	cipher.encryptBlock(block, block);
+	return static_cast<uint32_t>(block[0]);
+}};
+static Benchmark aesCbcEncrypt{"AesCbcEncrypt/64K", kLongLength, makeCbcBody<Aes>(kLongLength, true)};
+static Benchmark aesCbcDecryptBlock{"AesCbcDecrypt/16", kBlockLength, makeCbcBody<Aes>(kBlockLength, false)};
+static Benchmark aesCbcDecrypt{"AesCbcDecrypt/64K", kLongLength, makeCbcBody<Aes>(kLongLength, false)};
+static Benchmark aesCtr{"AesCtr/64K", kLongLength, makeCtrBody(kLongLength)};
@@ -0,0 +1,45 @@
+//
+// Benchmark.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_TESTS_BENCHMARK_BENCHMARK_HPP_
+#define DRONEDEVICE_TESTS_BENCHMARK_BENCHMARK_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+//!
+//! Throughput benchmark, instances are registered at static initialization
+//! and executed by the main function.
+//!
+class Benchmark {
+public:
+	//! Function processing the data once, the result is used to prevent elimination of the calculation.
+	using Body = std::function<uint32_t ()>;
+
+	Benchmark(const char *aName, size_t aBytes, Body aBody);
+
+	//!
+	//! Run registered benchmarks.
+	//! \param filter Substring of the benchmark name or nullptr to run all benchmarks.
+	//!
+	static void runAll(const char *aFilter);
+
+	//!
+	//! Buffer with random data shared between benchmarks.
+	//!
+	static const std::vector<uint8_t> &data();
+
+private:
+	const char *name;
+	size_t bytes;
+	Body body;
+
+	static std::vector<Benchmark *> &registry();
+};
+
+#endif // DRONEDEVICE_TESTS_BENCHMARK_BENCHMARK_HPP_
@@ -0,0 +1,125 @@
+//
+// CanReplay.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "Benchmark.hpp"
+#include <DroneDevice/PlazCan/PlatformWrapper.hpp>
+#include <DroneDevice/PlazCan/UavCanHandler.hpp>
+#include <DroneDevice/Stubs/CanTraceReplay.hpp>
+#include <cstdlib>
+#include <vector>
+
+// Throughput column of replay benchmarks shows billions of frames per second.
+// A captured trace is replayed instead of the synthetic one when CAN_TRACE contains a path to the trace.
+static constexpr size_t kNodes{100};
+static constexpr size_t kRounds{20};
+static constexpr size_t kArenaSize{16384};
+static constexpr Device::DeviceId kMasterAddress{127};
+
+using Handler = PlazCan::UavCanHandler<PlazCan::PlatformWrapper<Device::ReplayCan, Device::SimTime>, 1>;
+
+//!
+//! Device which accepts all transfers, so the whole reception path of libcanard is measured.
+//!
+class Sink : public PlazCan::CanDevice {
+public:
+	Device::DeviceId getBusAddress() const override
+	{
+		return kMasterAddress;
+	}
+
+	PlazCan::Status getStatus() const override
+	{
+		return PlazCan::Status{PlazCan::Mode::OPERATIONAL, PlazCan::Health::HEALTHY};
+	}
+
+	PlazCan::UidType getUID() const override
+	{
+		return PlazCan::UidType{};
+	}
+
+	bool onAcceptanceRequest(uint16_t, CanardTransferType, Device::DeviceId, Device::DeviceId) override
+	{
+		return true;
+	}
+
+	void onMessageReceived(const CanardRxTransfer *aTransfer) override
+	{
+		bytes += aTransfer->payload_len;
+	}
+
+	uint32_t bytes{0};
+};
+
+static uint64_t findUnknownHash(CanardTransferType, uint16_t)
+{
+	return 0;
+}
+
+//!
+//! Status messages of all nodes and multi-frame responses to file reads of the master.
+//!
+static Device::CanTrace makeSyntheticTrace()
+{
+	Device::SimTime::reset();
+
+	Device::ReplayCan bus;
+	std::vector<uint8_t> arena(kArenaSize);
+	Handler generator{bus, arena.data(), arena.size()};
+	uint8_t transferIds[kNodes] = {0};
+	uint8_t payload[66];
+
+	for (size_t i = 0; i < sizeof(payload); ++i) {
+		payload[i] = Benchmark::data()[i];
+	}
+
+	for (size_t round = 0; round < kRounds; ++round) {
+		for (size_t node = 0; node < kNodes; ++node) {
+			const auto source = static_cast<Device::DeviceId>(node + 1);
+
+			generator.sendCanMessage(source, PlazCan::DataType::Message::NODE_STATUS, &transferIds[node], payload, 7);
+			generator.sendCanServiceResponse(source, kMasterAddress, PlazCan::DataType::Service::FILE_READ,
+				static_cast<uint8_t>(round), payload, sizeof(payload));
+			Device::SimTime::advanceTo(Device::SimTime::nanoseconds() + std::chrono::milliseconds{1});
+		}
+	}
+
+	return bus.getOutput();
+}
+
+static const Device::CanTrace &trace()
+{
+	static const Device::CanTrace result = []() {
+		const char * const path = getenv("CAN_TRACE");
+		Device::CanTrace loaded;
+
+		if (path != nullptr && loaded.load(path)) {
+			return loaded;
+		}
+
+		return makeSyntheticTrace();
+	}();
+
+	return result;
+}
+
+static Benchmark::Body makeReplayBody()
+{
+	return []() {
+		Device::SimTime::reset();
+
+		Device::ReplayCan bus;
+		std::vector<uint8_t> arena(kArenaSize);
+		Handler handler{bus, arena.data(), arena.size(), findUnknownHash};
+		Sink sink;
+
+		handler.attach(&sink);
+		const auto result = Device::CanTraceReplay<Handler>::run(handler, trace());
+
+		return static_cast<uint32_t>(result.transfers) + sink.bytes;
+	};
+}
+
+static Benchmark canReplay{"CanReplay", trace().size(), makeReplayBody()};
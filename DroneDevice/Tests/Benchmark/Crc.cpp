@@ -0,0 +1,44 @@
+//
+// Crc.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "Benchmark.hpp"
+#include <DroneDevice/Crc16.hpp>
+#include <DroneDevice/Crc32.hpp>
+#include <DroneDevice/Crc8.hpp>
+#include <DroneDevice/FastCrc16.hpp>
+#include <DroneDevice/FastCrc32.hpp>
+#include <DroneDevice/FastCrc8.hpp>
+#include <DroneDevice/HostCrc32.hpp>
+#include <DroneDevice/SliceCrc16.hpp>
+#include <DroneDevice/SliceCrc32.hpp>
+#include <DroneDevice/SliceCrc8.hpp>
+
+template<typename T>
+static Benchmark::Body makeCrcBody(size_t aLength)
+{
+	return [aLength]() {
+		return static_cast<uint32_t>(T::update(0, Benchmark::data().data(), aLength));
+	};
+}
+
+static constexpr size_t kShortLength{64};
+static constexpr size_t kLongLength{1 << 20};
+
+static Benchmark crc8{"Crc8/64K", kLongLength >> 4, makeCrcBody<Crc8>(kLongLength >> 4)};
+static Benchmark fastCrc8{"FastCrc8/1M", kLongLength, makeCrcBody<FastCrc8>(kLongLength)};
+static Benchmark sliceCrc8{"SliceCrc8/1M", kLongLength, makeCrcBody<SliceCrc8>(kLongLength)};
+
+static Benchmark crc16{"Crc16/64K", kLongLength >> 4, makeCrcBody<Crc16>(kLongLength >> 4)};
+static Benchmark fastCrc16{"FastCrc16/1M", kLongLength, makeCrcBody<FastCrc16>(kLongLength)};
+static Benchmark sliceCrc16{"SliceCrc16/1M", kLongLength, makeCrcBody<SliceCrc16>(kLongLength)};
+
+static Benchmark crc32{"Crc32/64K", kLongLength >> 4, makeCrcBody<Crc32>(kLongLength >> 4)};
+static Benchmark fastCrc32Short{"FastCrc32/64", kShortLength, makeCrcBody<FastCrc32>(kShortLength)};
+static Benchmark fastCrc32{"FastCrc32/1M", kLongLength, makeCrcBody<FastCrc32>(kLongLength)};
+static Benchmark sliceCrc32Short{"SliceCrc32/64", kShortLength, makeCrcBody<SliceCrc32>(kShortLength)};
+static Benchmark sliceCrc32{"SliceCrc32/1M", kLongLength, makeCrcBody<SliceCrc32>(kLongLength)};
+static Benchmark hostCrc32Short{"HostCrc32/64", kShortLength, makeCrcBody<HostCrc32>(kShortLength)};
+static Benchmark hostCrc32{"HostCrc32/1M", kLongLength, makeCrcBody<HostCrc32>(kLongLength)};
@@ -0,0 +1,66 @@
+//
+// Lz.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "Benchmark.hpp"
+#include <DroneDevice/LzDecoder.hpp>
+#include <DroneDevice/LzEncoder.hpp>
+#include <algorithm>
+
+static constexpr size_t kImageLength{256 * 1024};
+static constexpr size_t kChunk{256};
+
+// Image made of recent fragments of random data, compressible like machine code
+static const std::vector<uint8_t> &image()
+{
+	static std::vector<uint8_t> content;
+
+	if (content.empty()) {
+		const std::vector<uint8_t> &random = Benchmark::data();
+		size_t index = 0;
+
+		while (content.size() < kImageLength) {
+			const size_t selector = random[index++ % random.size()];
+
+			if (content.size() > 1024 && selector < 170) {
+				const size_t source = content.size() - 32 - random[index++ % random.size()] * 3;
+				const size_t length = 4 + (selector & 0x1F);
+
+				for (size_t i = 0; i < length; ++i) {
+					content.push_back(content[source + i]);
+				}
+			} else {
+				content.push_back(random[index++ % random.size()]);
+			}
+		}
+
+		content.resize(kImageLength);
+	}
+
+	return content;
+}
+
+static Benchmark::Body makeDecoderBody()
+{
+	return []() {
+		static const std::vector<uint8_t> stream = LzEncoder<>::compress(image().data(), image().size(), 11);
+		alignas(8) static uint8_t window[2048];
+		uint32_t sum = 0;
+
+		LzDecoder<> decoder{window, sizeof(window), [&sum](size_t, const void *aBuffer, size_t) {
+			sum += *static_cast<const uint8_t *>(aBuffer);
+			return true;
+		}};
+
+		for (size_t position = 0; position < stream.size(); position += kChunk) {
+			decoder.update(stream.data() + position, std::min(kChunk, stream.size() - position));
+		}
+
+		return decoder.finalize() ? sum : 0;
+	};
+}
+
+// Throughput is measured in decompressed bytes, CRC of the output is included
+static Benchmark lzDecoder{"LzDecoder/256K", kImageLength, makeDecoderBody()};
@@ -0,0 +1,81 @@
+//
+// Main.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "Benchmark.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+static constexpr size_t kDataSize{1 << 20};
+static constexpr double kMinDuration{0.2};
+
+static volatile uint32_t sink;
+
+Benchmark::Benchmark(const char *aName, size_t aBytes, Body aBody) :
+	name{aName},
+	bytes{aBytes},
+	body{aBody}
+{
+	registry().push_back(this);
+}
+
+void Benchmark::runAll(const char *aFilter)
+{
+	printf("%-32s %14s %12s %12s\n", "Benchmark", "Time", "Iterations", "Throughput");
+
+	for (auto *benchmark : registry()) {
+		if (aFilter != nullptr && strstr(benchmark->name, aFilter) == nullptr) {
+			continue;
+		}
+
+		// Warm up caches and lazily initialized tables
+		sink = benchmark->body();
+
+		size_t iterations = 0;
+		double elapsed = 0.0;
+		const auto start = std::chrono::steady_clock::now();
+
+		do {
+			sink = benchmark->body();
+			++iterations;
+			elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		} while (elapsed < kMinDuration);
+
+		const double time = elapsed / static_cast<double>(iterations);
+		const double throughput = static_cast<double>(benchmark->bytes) / time / 1e9;
+
+		printf("%-32s %11.0f ns %12zu %9.3f GB/s\n", benchmark->name, time * 1e9, iterations, throughput);
+	}
+}
+
+const std::vector<uint8_t> &Benchmark::data()
+{
+	static const std::vector<uint8_t> buffer = []() {
+		std::mt19937 generator{1};
+		std::vector<uint8_t> result(kDataSize);
+
+		for (auto &value : result) {
+			value = static_cast<uint8_t>(generator());
+		}
+
+		return result;
+	}();
+
+	return buffer;
+}
+
+std::vector<Benchmark *> &Benchmark::registry()
+{
+	static std::vector<Benchmark *> benchmarks;
+	return benchmarks;
+}
+
+int main(int argc, char **argv)
+{
+	Benchmark::runAll(argc > 1 ? argv[1] : nullptr);
+	return 0;
+}
@@ -0,0 +1,41 @@
+//
+// Sha256.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "BaselineSha256.hpp"
+#include "Benchmark.hpp"
+#include <DroneDevice/Sha256.hpp>
+#include <algorithm>
+
+template<typename T>
+static Benchmark::Body makeShaBody(size_t aLength, size_t aChunk)
+{
+	return [aLength, aChunk]() {
+		const uint8_t * const buffer = Benchmark::data().data();
+		T sha;
+
+		for (size_t position = 0; position < aLength; position += aChunk) {
+			sha.update(buffer + position, std::min(aChunk, aLength - position));
+		}
+
+		return static_cast<uint32_t>(sha.finalize()[0]);
+	};
+}
+
+static constexpr size_t kShortLength{64};
+static constexpr size_t kLongLength{1 << 20};
+
+// Single byte updates show the cost of the buffering path, BaselineSha256 is the previous implementation
+static Benchmark baselineSha256Bytes{"BaselineSha256/64K/1", kLongLength >> 4,
+	makeShaBody<BaselineSha256>(kLongLength >> 4, 1)};
+static Benchmark baselineSha256Chunks{"BaselineSha256/1M/100", kLongLength, makeShaBody<BaselineSha256>(kLongLength, 100)};
+static Benchmark baselineSha256Short{"BaselineSha256/64", kShortLength,
+	makeShaBody<BaselineSha256>(kShortLength, kShortLength)};
+static Benchmark baselineSha256{"BaselineSha256/1M", kLongLength, makeShaBody<BaselineSha256>(kLongLength, kLongLength)};
+
+static Benchmark sha256Bytes{"Sha256/64K/1", kLongLength >> 4, makeShaBody<Sha256>(kLongLength >> 4, 1)};
+static Benchmark sha256Chunks{"Sha256/1M/100", kLongLength, makeShaBody<Sha256>(kLongLength, 100)};
+static Benchmark sha256Short{"Sha256/64", kShortLength, makeShaBody<Sha256>(kShortLength, kShortLength)};
+static Benchmark sha256{"Sha256/1M", kLongLength, makeShaBody<Sha256>(kLongLength, kLongLength)};
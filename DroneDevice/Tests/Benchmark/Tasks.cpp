@@ -0,0 +1,101 @@
+//
+// Tasks.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "Benchmark.hpp"
+#include <DroneDevice/InplaceFunction.hpp>
+#include <DroneDevice/Queue.hpp>
+#include <DroneDevice/TaskQueue.hpp>
+#include <functional>
+
+// Throughput column of task benchmarks shows billions of tasks per second
+static constexpr size_t kTasks{32};
+static constexpr size_t kTaskSize{4 * sizeof(void *)};
+
+using StdTask = std::function<void ()>;
+using InplaceTask = InplaceFunction<void (), kTaskSize>;
+
+static uint32_t counter;
+
+// Typical task captures an object, a buffer and a length, which does not fit into std::function
+static void work(uint32_t *aCounter, const uint8_t *aBuffer, size_t aLength)
+{
+	*aCounter += aBuffer[aLength & 0xFF];
+}
+
+static Benchmark::Body makeFifoBody()
+{
+	return []() {
+		static Queue<StdTask, kTasks> queue;
+		const uint8_t * const buffer = Benchmark::data().data();
+
+		for (size_t i = 0; i < kTasks; ++i) {
+			uint32_t * const target = &counter;
+			queue.push([target, buffer, i]() { work(target, buffer, i); });
+		}
+		while (!queue.empty()) {
+			queue.pop()();
+		}
+
+		return counter;
+	};
+}
+
+static Benchmark::Body makePriorityBody()
+{
+	return []() {
+		static TaskQueue<InplaceTask, kTasks, 4> queue;
+		const uint8_t * const buffer = Benchmark::data().data();
+		InplaceTask task;
+
+		for (size_t i = 0; i < kTasks; ++i) {
+			uint32_t * const target = &counter;
+			queue.push([target, buffer, i]() { work(target, buffer, i); }, i & 3);
+		}
+		while (queue.pop(task)) {
+			task();
+		}
+
+		return counter;
+	};
+}
+
+//!
+//! Measure the time from queuing an urgent task behind a full queue of background tasks
+//! to the start of the urgent task. Background tasks take about a microsecond each.
+//!
+template<size_t priorities>
+static Benchmark::Body makeLatencyBody()
+{
+	return []() {
+		static TaskQueue<InplaceTask, kTasks + 1, priorities> queue;
+		static volatile uint32_t spin;
+		InplaceTask task;
+		bool urgent = false;
+
+		for (size_t i = 0; i < kTasks; ++i) {
+			queue.push([]() { for (uint32_t j = 0; j < 1000; ++j) { spin = spin + j; } }, priorities - 1);
+		}
+		queue.push([&urgent]() { urgent = true; }, 0);
+
+		uint32_t before = 0;
+
+		while (!urgent && queue.pop(task)) {
+			task();
+			++before;
+		}
+
+		// Remaining tasks are dropped, removal is much cheaper than execution
+		while (queue.pop(task)) {
+		}
+
+		return before;
+	};
+}
+
+static Benchmark tasksFifo{"Tasks/Dispatch/Function", kTasks, makeFifoBody()};
+static Benchmark tasksPriority{"Tasks/Dispatch/Inplace", kTasks, makePriorityBody()};
+static Benchmark tasksLatencyFifo{"Tasks/Latency/1", 1, makeLatencyBody<1>()};
+static Benchmark tasksLatencyPriority{"Tasks/Latency/4", 1, makeLatencyBody<4>()};
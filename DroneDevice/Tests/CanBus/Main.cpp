@@ -0,0 +1,450 @@
+//
+// Main.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "gtest/gtest.h"
+#include "Network.hpp"
+#include <cstdio>
+
+using namespace std::chrono_literals;
+
+static CanMessage makeMessage(uint32_t aId, bool aExtended, uint8_t aLength, uint8_t aFill)
+{
+	CanMessage message{};
+
+	message.id = aId;
+	message.flags = aExtended ? CanMessage::EXT : 0;
+	message.length = aLength;
+	std::fill(message.data, message.data + aLength, aFill);
+	return message;
+}
+
+static void printReport(const char *aName, const Network &aNetwork)
+{
+	const auto stats = aNetwork.bus.getStatistics();
+	const auto &latency = aNetwork.bus.getRequestLatency();
+
+	printf("%s: %.0f frames/s, utilization %.1f %%, %llu error frames, %u dropped transfers, "
+		"requests %zu, latency p50 %lld us, p99 %lld us, max %lld us\n",
+		aName, stats.throughput(), stats.utilization() * 100.0, static_cast<unsigned long long>(stats.errorFrames),
+		aNetwork.droppedTransfers(), latency.count(), static_cast<long long>(latency.percentile(0.5).count()),
+		static_cast<long long>(latency.percentile(0.99).count()), static_cast<long long>(latency.max().count()));
+}
+
+TEST(CanBus, FrameLength)
+{
+	// Shortest frame: 44 bits, 6 stuff bits and the interframe space
+	EXPECT_EQ(Device::VirtualCanBus::frameBits(makeMessage(0, false, 0, 0)), 53U);
+
+	const unsigned int alternating = Device::VirtualCanBus::frameBits(makeMessage(0x1555555, true, 8, 0x55));
+	const unsigned int uniform = Device::VirtualCanBus::frameBits(makeMessage(0x1555555, true, 8, 0x00));
+
+	EXPECT_GE(alternating, 131U);
+	EXPECT_GT(uniform, alternating + 10);
+	EXPECT_LE(uniform, 160U);
+}
+
+TEST(CanBus, Arbitration)
+{
+	Device::SimTime::reset();
+
+	Device::VirtualCanBus bus{1000000};
+	Port first{bus};
+	Port second{bus};
+	Port observer{bus};
+
+	const CanMessage messages[] = {
+		makeMessage(0x200, false, 1, 1),
+		makeMessage(0x300, false, 1, 2),
+	};
+	const CanMessage other[] = {
+		makeMessage(0x100 << 18, true, 1, 3), // Same base identifier as the standard frame below
+		makeMessage(0x100, false, 1, 4),
+	};
+
+	first.write(messages, 2);
+	second.write(other, 2);
+
+	while (bus.step(Device::SimTime::nanoseconds()));
+
+	CanMessage received[4];
+	ASSERT_EQ(observer.read(received, 4), 4U);
+
+	// Standard frame wins against the extended frame with the same base identifier
+	EXPECT_EQ(received[0].data[0], 4);
+	EXPECT_EQ(received[1].data[0], 3);
+	EXPECT_EQ(received[2].data[0], 1);
+	EXPECT_EQ(received[3].data[0], 2);
+	EXPECT_EQ(first.getStatistics().rx, 2U);
+	EXPECT_EQ(first.getStatistics().tx, 2U);
+
+	const auto stats = bus.getStatistics();
+	EXPECT_EQ(stats.frames, 4U);
+	EXPECT_EQ(stats.busy, std::chrono::nanoseconds{stats.bits * 1000});
+	EXPECT_EQ(Device::SimTime::nanoseconds(), stats.busy);
+}
+
+TEST(CanBus, ErrorFrames)
+{
+	Device::SimTime::reset();
+
+	Device::VirtualCanBus bus{500000, 0.2};
+	Port sender{bus};
+	Port receiver{bus};
+
+	for (uint8_t i = 0; i < 100; ++i) {
+		const CanMessage message = makeMessage(0x10, false, 8, i);
+		CanMessage received;
+
+		ASSERT_EQ(sender.write(&message, 1), 1U);
+		while (bus.step(Device::SimTime::nanoseconds()));
+		ASSERT_EQ(receiver.read(&received, 1), 1U);
+		EXPECT_EQ(received.data[0], i);
+	}
+
+	const auto stats = bus.getStatistics();
+
+	// Corrupted frames are retransmitted, receivers see each frame once
+	EXPECT_EQ(receiver.getStatistics().rx, 100U);
+	EXPECT_GT(stats.errorFrames, 0U);
+	EXPECT_EQ(sender.getStatistics().errors, stats.errorFrames);
+	EXPECT_EQ(stats.busOffs, 0U);
+}
+
+TEST(CanBus, Collision)
+{
+	Device::SimTime::reset();
+
+	Device::VirtualCanBus bus{1000000};
+	Port first{bus};
+	Port second{bus};
+	Port third{bus};
+
+	const CanMessage messages[] = {makeMessage(0x42, false, 1, 1), makeMessage(0x42, false, 1, 2)};
+	const CanMessage identical = makeMessage(0x50, false, 1, 5);
+
+	first.write(&messages[0], 1);
+	second.write(&messages[1], 1);
+	while (bus.step(Device::SimTime::nanoseconds()));
+
+	// Both controllers go bus-off instead of blocking the bus forever
+	EXPECT_EQ(bus.getStatistics().busOffs, 2U);
+	EXPECT_EQ(third.getStatistics().rx, 0U);
+
+	first.write(&identical, 1);
+	second.write(&identical, 1);
+	while (bus.step(Device::SimTime::nanoseconds()));
+
+	// Identical frames are transmitted together
+	EXPECT_EQ(third.getStatistics().rx, 1U);
+	EXPECT_EQ(first.getStatistics().tx, 1U);
+	EXPECT_EQ(second.getStatistics().tx, 1U);
+}
+
+TEST(CanBus, LatencyHistogram)
+{
+	Device::LatencyHistogram histogram;
+
+	for (int i = 1; i <= 1000; ++i) {
+		histogram.record(std::chrono::microseconds{i});
+	}
+
+	EXPECT_EQ(histogram.count(), 1000U);
+	EXPECT_EQ(histogram.max().count(), 1000);
+	EXPECT_NEAR(static_cast<double>(histogram.percentile(0.5).count()), 500.0, 500.0 / 16);
+	EXPECT_NEAR(static_cast<double>(histogram.percentile(0.99).count()), 990.0, 990.0 / 16);
+	EXPECT_EQ(histogram.percentile(1.0).count(), 1000);
+}
+
+TEST(CanBus, ManyNodes)
+{
+	Device::SimTime::reset();
+
+	Network network{100, 1000000};
+
+	// Allocation is sequential, the master serves one node at a time
+	network.run(120s);
+
+	EXPECT_EQ(network.allocated(), 100U);
+	EXPECT_EQ(network.master.hub.size(), 100U);
+
+	// Burst of file reads from all nodes at once
+	network.bus.resetStatistics();
+
+	for (size_t round = 0; round < 4; ++round) {
+		for (size_t i = 0; i < network.master.hub.size(); ++i) {
+			network.master.hub[i]->fileRead(0, 0, 32, nullptr, nullptr);
+		}
+		network.run(200ms);
+	}
+	network.run(1s);
+
+	const auto stats = network.bus.getStatistics();
+	const auto &latency = network.bus.getRequestLatency();
+
+	printReport("ManyNodes", network);
+
+	EXPECT_EQ(latency.count(), 400U);
+	EXPECT_GT(stats.utilization(), 0.0);
+	EXPECT_LT(stats.utilization(), 1.0);
+	EXPECT_LE(latency.percentile(0.5), latency.percentile(0.99));
+	EXPECT_EQ(network.droppedTransfers(), 0U);
+}
+
+TEST(CanBus, AllocationStormWithSmallPool)
+{
+	Device::SimTime::reset();
+
+	// Master pool is too small for concurrent multi-frame transfers of many nodes
+	Network network{100, 250000, 1024};
+
+	network.run(30s);
+
+	printReport("AllocationStorm", network);
+
+	EXPECT_GT(network.droppedTransfers(), 0U);
+	EXPECT_GT(network.bus.getStatistics().utilization(), 0.0);
+}
+
+TEST(CanBus, SilentNodes)
+{
+	Device::SimTime::reset();
+
+	Network network{4, 1000000};
+
+	network.master.hub.setPurgeTimeout(5000ms);
+	network.run(10s);
+	ASSERT_EQ(network.master.hub.size(), 4U);
+
+	// Node stops sending status messages, the proxy is disabled and then removed by its timer
+	const auto address = network.nodes[0]->device.getBusAddress();
+	const auto silent = [address](const NetworkMaster::Hub::ProxyType *aProxy) {
+		return aProxy->getBusAddress() == address;
+	};
+
+	network.nodes[0]->device.setNodeStatusPeriod(0us);
+	network.run(4s);
+	ASSERT_NE(network.master.hub.find(silent), nullptr);
+	EXPECT_EQ(network.master.hub.find(silent)->getStatus().mode, PlazCan::Mode::OFFLINE);
+
+	network.run(2s);
+	EXPECT_EQ(network.master.hub.find(silent), nullptr);
+	EXPECT_EQ(network.master.hub.size(), 3U);
+}
+
+static void runBuses(Device::VirtualCanBus &aFirst, Device::VirtualCanBus &aSecond)
+{
+	while (aFirst.step(Device::SimTime::nanoseconds()) | aSecond.step(Device::SimTime::nanoseconds()));
+}
+
+// Single-frame transfer of a message type
+static CanMessage makeTransfer(uint16_t aDataTypeId, uint8_t aSource, uint8_t aTransferId, uint8_t aFill)
+{
+	CanMessage message = makeMessage((16UL << 24) | (static_cast<uint32_t>(aDataTypeId) << 8) | aSource, true, 8, aFill);
+
+	message.data[7] = static_cast<uint8_t>(0xC0 | aTransferId);
+	return message;
+}
+
+TEST(CanBus, RouterDeduplicates)
+{
+	Device::SimTime::reset();
+
+	Device::VirtualCanBus first{1000000};
+	Device::VirtualCanBus second{1000000};
+	Port firstSender{first};
+	Port secondSender{second};
+	RedundantLink link{first, second};
+	std::vector<CanMessage> received;
+
+	link.router.setCallback([&received](const CanMessage *aMessages, size_t aCount) {
+		received.insert(received.end(), aMessages, aMessages + aCount);
+	});
+
+	// Redundant node sends each transfer to both buses
+	for (uint8_t i = 0; i < 4; ++i) {
+		const CanMessage message = makeTransfer(341, 5, i, i);
+
+		firstSender.write(&message, 1);
+		secondSender.write(&message, 1);
+	}
+	runBuses(first, second);
+
+	ASSERT_EQ(received.size(), 4U);
+	for (uint8_t i = 0; i < 4; ++i) {
+		EXPECT_EQ(received[i].data[0], i);
+	}
+	EXPECT_EQ(link.router.getInterfaceStatistics(0).duplicates + link.router.getInterfaceStatistics(1).duplicates, 4U);
+	EXPECT_EQ(link.router.getStatistics().rx, 4U);
+
+	// Transfers of other sources and transfers seen only on one bus are not affected
+	const CanMessage other = makeTransfer(341, 6, 0, 9);
+	const CanMessage next = makeTransfer(341, 5, 4, 10);
+
+	secondSender.write(&other, 1);
+	firstSender.write(&next, 1);
+	runBuses(first, second);
+
+	EXPECT_EQ(received.size(), 6U);
+}
+
+//!
+//! Interface which returns prepared frames with their own timestamps.
+//!
+class FrameQueue : public PlazCan::CanInterface {
+public:
+	CanStatistics getStatistics() const override
+	{
+		return CanStatistics{};
+	}
+
+	size_t read(CanMessage *aBuffer, size_t aLength) override
+	{
+		const size_t count = std::min(aLength, frames.size());
+
+		std::copy(frames.begin(), frames.begin() + count, aBuffer);
+		frames.erase(frames.begin(), frames.begin() + count);
+		return count;
+	}
+
+	size_t write(const CanMessage *, size_t aLength) override
+	{
+		return aLength;
+	}
+
+	void push(CanMessage aMessage, uint64_t aTimestamp)
+	{
+		aMessage.timestamp = aTimestamp;
+		frames.push_back(aMessage);
+	}
+
+private:
+	std::vector<CanMessage> frames;
+};
+
+TEST(CanBus, RouterDeduplicatesEarlierCopy)
+{
+	FrameQueue first;
+	FrameQueue second;
+	PlazCan::CanRouter<> router;
+	size_t received = 0;
+
+	router.attach(first);
+	router.attach(second);
+	router.setCallback([&received](const CanMessage *, size_t aCount) { received += aCount; });
+
+	// Second controller stamps the copy of the same transfer earlier than the first one
+	const CanMessage message = makeTransfer(341, 5, 0, 0);
+
+	first.push(message, 3000000);
+	router.receive(0);
+	second.push(message, 2999900);
+	router.receive(1);
+
+	EXPECT_EQ(received, 1U);
+	EXPECT_EQ(router.getInterfaceStatistics(1).duplicates, 1U);
+
+	// Copy of a new transfer after the timeout is accepted from the second interface
+	second.push(message, 5000100);
+	router.receive(1);
+
+	EXPECT_EQ(received, 2U);
+}
+
+TEST(CanBus, RouterTransmit)
+{
+	Device::SimTime::reset();
+
+	Device::VirtualCanBus first{1000000};
+	Device::VirtualCanBus second{1000000};
+	Port firstObserver{first};
+	Port secondObserver{second};
+	RedundantLink link{first, second};
+	const CanMessage message = makeTransfer(341, 5, 0, 1);
+
+	EXPECT_EQ(link.router.write(&message, 1), 1U);
+	runBuses(first, second);
+
+	EXPECT_EQ(firstObserver.getStatistics().rx, 1U);
+	EXPECT_EQ(secondObserver.getStatistics().rx, 1U);
+	EXPECT_EQ(link.router.getStatistics().tx, 2U);
+
+	// Chosen interfaces
+	EXPECT_EQ(link.router.write(&message, 1, 1U << 1), 1U);
+	link.router.setTransmitMask(1U << 0);
+	EXPECT_EQ(link.router.write(&message, 1), 1U);
+	runBuses(first, second);
+
+	EXPECT_EQ(firstObserver.getStatistics().rx, 2U);
+	EXPECT_EQ(secondObserver.getStatistics().rx, 2U);
+}
+
+TEST(CanBus, RouterBridge)
+{
+	Device::SimTime::reset();
+
+	Device::VirtualCanBus first{1000000};
+	Device::VirtualCanBus second{1000000};
+	Port sender{first};
+	Port observer{second};
+	RedundantLink link{first, second};
+	size_t received = 0;
+
+	link.router.setCallback([&received](const CanMessage *, size_t aCount) { received += aCount; });
+	ASSERT_TRUE(link.router.addMessageRoute(341, 1U << 0, Router::kAllInterfaces));
+	ASSERT_TRUE(link.router.addServiceRoute(48, 1U << 0, 1U << 1));
+
+	const CanMessage messages[] = {
+		makeTransfer(341, 5, 0, 1),
+		makeTransfer(342, 5, 0, 2),
+		makeMessage((16UL << 24) | (48UL << 16) | (7UL << 8) | 0x80 | 5, true, 8, 3),
+	};
+
+	sender.write(messages, 3);
+	runBuses(first, second);
+
+	// Selected types are forwarded, all frames are delivered locally
+	CanMessage forwarded[3];
+
+	ASSERT_EQ(observer.read(forwarded, 3), 2U);
+	EXPECT_EQ(forwarded[0].data[0], 1);
+	EXPECT_EQ(forwarded[1].data[0], 3);
+	EXPECT_EQ(link.router.getInterfaceStatistics(1).bridged, 2U);
+	EXPECT_EQ(received, 3U);
+}
+
+TEST(CanBus, RedundantBuses)
+{
+	Device::SimTime::reset();
+
+	RedundantNetwork network{4, 1000000};
+
+	network.run(20s);
+
+	EXPECT_EQ(network.allocated(), 4U);
+	EXPECT_EQ(network.master.hub.size(), 4U);
+
+	const auto initial = network.master.handler.getTransferStatistics();
+	const auto duplicates = network.master.link.router.getInterfaceStatistics(0).duplicates
+		+ network.master.link.router.getInterfaceStatistics(1).duplicates;
+
+	// Each transfer arrives twice, copies are discarded before libcanard
+	EXPECT_GT(duplicates, initial.transfers_rx);
+	EXPECT_EQ(initial.transfer_errors, 0U);
+
+	// Communication continues when one of the buses fails
+	network.first.setErrorRate(1.0);
+	for (size_t i = 0; i < network.master.hub.size(); ++i) {
+		network.master.hub[i]->fileRead(0, 0, 32, nullptr, nullptr);
+	}
+	network.run(5s);
+
+	const auto current = network.master.handler.getTransferStatistics();
+
+	EXPECT_GE(current.transfers_rx - initial.transfers_rx, 4U * 5U + 4U);
+	EXPECT_EQ(current.transfer_errors, 0U);
+	EXPECT_EQ(current.dropped_transfers, 0U);
+	EXPECT_EQ(network.master.hub.size(), 4U);
+}
@@ -0,0 +1,192 @@
+//
+// Network.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_TESTS_CANBUS_NETWORK_HPP_
+#define DRONEDEVICE_TESTS_CANBUS_NETWORK_HPP_
+
+#include "../Common/SimNetwork.hpp"
+#include <DroneDevice/PlazCan/CanRouter.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+static constexpr size_t kMaxNodes{128};
+
+using NetworkMaster = Master<Port, kMaxNodes>;
+
+struct Network {
+	Network(size_t aNodeCount, uint32_t aBitrate, size_t aMasterArenaSize = 16384):
+		bus{aBitrate},
+		master{aMasterArenaSize, bus},
+		nodes{}
+	{
+		master.port.setCallback([this]() { receive(master.port, master.handler); });
+
+		for (size_t i = 0; i < aNodeCount; ++i) {
+			nodes.emplace_back(new Node{bus, static_cast<uint32_t>(i + 1)});
+		}
+	}
+
+	void run(std::chrono::microseconds aDuration)
+	{
+		bus.run(aDuration, [this]() {
+			auto next = master.handler.onTimeoutOccurred();
+
+			for (auto &node : nodes) {
+				next = std::min(next, node->handler.onTimeoutOccurred());
+			}
+			return next;
+		});
+	}
+
+	size_t allocated() const
+	{
+		return static_cast<size_t>(std::count_if(nodes.begin(), nodes.end(), [](const std::unique_ptr<Node> &aNode) {
+			return aNode->device.getBusAddress() != PlazCan::kAddressUnallocated;
+		}));
+	}
+
+	uint32_t droppedTransfers() const
+	{
+		uint32_t result = master.handler.getTransferStatistics().dropped_transfers;
+
+		for (const auto &node : nodes) {
+			result += node->handler.getTransferStatistics().dropped_transfers;
+		}
+		return result;
+	}
+
+	Device::VirtualCanBus bus;
+	NetworkMaster master;
+	std::vector<std::unique_ptr<Node>> nodes;
+};
+
+using Router = PlazCan::CanRouter<2>;
+using RouterPlatform = PlazCan::PlatformWrapper<Router, Device::SimTime, SimRng>;
+
+//!
+//! Two controllers connected to redundant buses through a router.
+//!
+struct RedundantLink {
+	RedundantLink(Device::VirtualCanBus &aFirst, Device::VirtualCanBus &aSecond):
+		first{aFirst},
+		second{aSecond},
+		firstInterface{first},
+		secondInterface{second},
+		router{}
+	{
+		router.attach(firstInterface);
+		router.attach(secondInterface);
+		first.setCallback([this]() { router.receive(0); });
+		second.setCallback([this]() { router.receive(1); });
+	}
+
+	Port first;
+	Port second;
+	PlazCan::CanInterfaceAdapter<Port> firstInterface;
+	PlazCan::CanInterfaceAdapter<Port> secondInterface;
+	Router router;
+};
+
+struct RedundantNode {
+	using Handler = PlazCan::UavCanHandler<RouterPlatform, 1>;
+	using CanDevice = PlazCan::InternalCanDevice<DUT, Handler>;
+
+	RedundantNode(Device::VirtualCanBus &aFirst, Device::VirtualCanBus &aSecond, uint32_t aSerial):
+		link{aFirst, aSecond},
+		arena(1024),
+		handler{link.router, arena.data(), arena.size()},
+		dut{"Node", aSerial},
+		device{dut, handler}
+	{
+		handler.attach(&device);
+		link.router.setCallback([this](const CanMessage *aMessages, size_t aCount) {
+			handler.onMessageReceived(aMessages, aCount);
+		});
+	}
+
+	RedundantLink link;
+	std::vector<uint8_t> arena;
+	Handler handler;
+	DUT dut;
+	CanDevice device;
+};
+
+struct RedundantMaster {
+	using Handler = PlazCan::UavCanHandler<RouterPlatform, kMaxNodes + 1>;
+	using Hub = PlazCan::CanProxyHub<PlazCan::InternalCanDevice<DUT, Handler>, kMaxNodes>;
+
+	RedundantMaster(Device::VirtualCanBus &aFirst, Device::VirtualCanBus &aSecond):
+		link{aFirst, aSecond},
+		arena(16384),
+		handler{link.router, arena.data(), arena.size()},
+		dut{"Master", 0xFFFFFFFFUL},
+		hub{true, dut, handler, kMasterAddress, false}
+	{
+		handler.attach(&hub);
+		link.router.setCallback([this](const CanMessage *aMessages, size_t aCount) {
+			handler.onMessageReceived(aMessages, aCount);
+		});
+	}
+
+	RedundantLink link;
+	std::vector<uint8_t> arena;
+	Handler handler;
+	DUT dut;
+	Hub hub;
+};
+
+//!
+//! Nodes and a master connected to two redundant buses.
+//!
+struct RedundantNetwork {
+	RedundantNetwork(size_t aNodeCount, uint32_t aBitrate):
+		first{aBitrate},
+		second{aBitrate},
+		master{first, second},
+		nodes{}
+	{
+		for (size_t i = 0; i < aNodeCount; ++i) {
+			nodes.emplace_back(new RedundantNode{first, second, static_cast<uint32_t>(i + 1)});
+		}
+	}
+
+	void run(std::chrono::microseconds aDuration)
+	{
+		const std::chrono::nanoseconds end = Device::SimTime::nanoseconds() + aDuration;
+
+		while (Device::SimTime::nanoseconds() < end) {
+			auto next = master.handler.onTimeoutOccurred();
+
+			for (auto &node : nodes) {
+				next = std::min(next, node->handler.onTimeoutOccurred());
+			}
+
+			// Frames of both buses are processed in turns, which is enough for functional tests
+			const bool busy = first.step(Device::SimTime::nanoseconds()) | second.step(Device::SimTime::nanoseconds());
+
+			if (!busy) {
+				Device::SimTime::advanceTo(std::min(end, std::max<std::chrono::nanoseconds>(next,
+					Device::SimTime::nanoseconds() + std::chrono::microseconds{1})));
+			}
+		}
+	}
+
+	size_t allocated() const
+	{
+		return static_cast<size_t>(std::count_if(nodes.begin(), nodes.end(),
+			[](const std::unique_ptr<RedundantNode> &aNode) {
+				return aNode->device.getBusAddress() != PlazCan::kAddressUnallocated;
+			}));
+	}
+
+	Device::VirtualCanBus first;
+	Device::VirtualCanBus second;
+	RedundantMaster master;
+	std::vector<std::unique_ptr<RedundantNode>> nodes;
+};
+
+#endif // DRONEDEVICE_TESTS_CANBUS_NETWORK_HPP_
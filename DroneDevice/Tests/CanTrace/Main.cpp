@@ -0,0 +1,203 @@
+//
+// Main.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "gtest/gtest.h"
+#include "../Common/CaptureNetwork.hpp"
+#include <cstdio>
+#include <string>
+
+using namespace std::chrono_literals;
+
+static bool operator==(const CanMessage &aLeft, const CanMessage &aRight)
+{
+	return aLeft.id == aRight.id && aLeft.flags == aRight.flags && aLeft.length == aRight.length
+		&& std::equal(aLeft.data, aLeft.data + aLeft.length, aRight.data);
+}
+
+static bool operator==(const Device::CanTrace &aLeft, const Device::CanTrace &aRight)
+{
+	return aLeft.size() == aRight.size() && std::equal(aLeft.begin(), aLeft.end(), aRight.begin(),
+		[](const Device::CanTraceRecord &aFirst, const Device::CanTraceRecord &aSecond) {
+			return aFirst.timestamp == aSecond.timestamp && aFirst.message == aSecond.message;
+		});
+}
+
+static void printReport(const char *aName, const Replay::Result &aResult)
+{
+	printf("%s: %zu frames, %llu transfers, %u dropped, pool peak %u of %u blocks, "
+		"frame time mean %lld ns, p50 %lld ns, p99 %lld ns, cpu time %lld us\n",
+		aName, aResult.frames, static_cast<unsigned long long>(aResult.transfers), aResult.droppedTransfers,
+		static_cast<unsigned int>(aResult.pool.statistics.peak_usage_blocks),
+		static_cast<unsigned int>(aResult.pool.statistics.capacity_blocks),
+		static_cast<long long>(aResult.meanFrameTime().count()),
+		static_cast<long long>(aResult.frameTime(0.5).count()),
+		static_cast<long long>(aResult.frameTime(0.99).count()),
+		static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(aResult.cpuTime).count()));
+}
+
+//!
+//! Capture traffic of a network with a master which reads files of all nodes.
+//!
+static Device::CanTrace capture(size_t aNodeCount, uint64_t *aMasterTransfers)
+{
+	Device::SimTime::reset();
+
+	Network network{aNodeCount, 1000000};
+
+	network.run(30s);
+
+	for (size_t round = 0; round < 4; ++round) {
+		for (size_t i = 0; i < network.master.hub.size(); ++i) {
+			network.master.hub[i]->fileRead(0, 0, 64, nullptr, nullptr);
+		}
+		network.run(200ms);
+	}
+
+	*aMasterTransfers = network.master.handler.getTransferStatistics().transfers_rx;
+
+	// The master does not receive own frames
+	Device::CanTrace trace = network.recorder.trace;
+	auto &records = trace.records();
+
+	records.erase(std::remove_if(records.begin(), records.end(), [](const Device::CanTraceRecord &aRecord) {
+		return (aRecord.message.id & 0x7F) == kMasterAddress;
+	}), records.end());
+
+	return trace;
+}
+
+TEST(CanTrace, ParseNative)
+{
+	Device::CanTraceRecord record;
+
+	ASSERT_TRUE(Device::CanTrace::parse("1500000 1E01017F 8 01 02 03 04 05 06 07 C0\n", &record));
+	EXPECT_EQ(record.timestamp.count(), 1500000);
+	EXPECT_EQ(record.message.timestamp, 1500000U);
+	EXPECT_EQ(record.message.id, 0x1E01017FU);
+	EXPECT_EQ(record.message.flags, CanMessage::EXT);
+	EXPECT_EQ(record.message.length, 8);
+	EXPECT_EQ(record.message.data[0], 0x01);
+	EXPECT_EQ(record.message.data[7], 0xC0);
+
+	ASSERT_TRUE(Device::CanTrace::parse("  42 7FF 0", &record));
+	EXPECT_EQ(record.message.id, 0x7FFU);
+	EXPECT_EQ(record.message.flags, 0);
+	EXPECT_EQ(record.message.length, 0);
+
+	ASSERT_TRUE(Device::CanTrace::parse("42 123 2 R", &record));
+	EXPECT_EQ(record.message.flags, CanMessage::RTR);
+	EXPECT_EQ(record.message.length, 2);
+
+	EXPECT_FALSE(Device::CanTrace::parse("42 800 0", &record));
+	EXPECT_FALSE(Device::CanTrace::parse("42 20000000 0", &record));
+	EXPECT_FALSE(Device::CanTrace::parse("42 1234 0", &record));
+	EXPECT_FALSE(Device::CanTrace::parse("42 123 9", &record));
+	EXPECT_FALSE(Device::CanTrace::parse("42 123 2 01", &record));
+	EXPECT_FALSE(Device::CanTrace::parse("42 123 1 01 02", &record));
+	EXPECT_FALSE(Device::CanTrace::parse("x 123 0", &record));
+}
+
+TEST(CanTrace, ParseCandump)
+{
+	Device::CanTraceRecord record;
+
+	ASSERT_TRUE(Device::CanTrace::parse("(1634567890.000123) can0 1E01017F#0102C0\n", &record));
+	EXPECT_EQ(record.timestamp.count(), 1634567890000123LL);
+	EXPECT_EQ(record.message.id, 0x1E01017FU);
+	EXPECT_EQ(record.message.flags, CanMessage::EXT);
+	EXPECT_EQ(record.message.length, 3);
+	EXPECT_EQ(record.message.data[2], 0xC0);
+
+	ASSERT_TRUE(Device::CanTrace::parse("(0.000001) vcan0 123#", &record));
+	EXPECT_EQ(record.message.flags, 0);
+	EXPECT_EQ(record.message.length, 0);
+
+	ASSERT_TRUE(Device::CanTrace::parse("(0.000001) vcan0 123#R", &record));
+	EXPECT_EQ(record.message.flags, CanMessage::RTR);
+
+	EXPECT_FALSE(Device::CanTrace::parse("(0.1) can0 123#00", &record));
+	EXPECT_FALSE(Device::CanTrace::parse("(0.000001) can0 123#0", &record));
+	EXPECT_FALSE(Device::CanTrace::parse("(0.000001) can0 123#000000000000000000", &record));
+}
+
+TEST(CanTrace, SaveAndLoad)
+{
+	uint64_t masterTransfers;
+	const Device::CanTrace trace = capture(4, &masterTransfers);
+	const std::string path = testing::TempDir() + "CanTraceTest.log";
+
+	ASSERT_FALSE(trace.empty());
+	ASSERT_TRUE(trace.save(path.c_str()));
+
+	Device::CanTrace loaded;
+
+	ASSERT_TRUE(loaded.load(path.c_str()));
+	EXPECT_TRUE(loaded == trace);
+	EXPECT_EQ(loaded.duration(), trace.duration());
+
+	remove(path.c_str());
+	EXPECT_FALSE(loaded.load(path.c_str()));
+}
+
+TEST(CanTrace, ReplayIsDeterministic)
+{
+	uint64_t masterTransfers;
+	const Device::CanTrace trace = capture(16, &masterTransfers);
+
+	Device::SimTime::reset();
+	ReplayMaster first{16384};
+	const auto result = Replay::run(first.handler, trace);
+
+	printReport("Replay", result);
+
+	// Master repeats the requests of the capture, so nodes answer as expected
+	EXPECT_EQ(first.hub.size(), 16U);
+	EXPECT_EQ(result.frames, trace.size());
+	EXPECT_EQ(result.frameTimes.size(), trace.size());
+	EXPECT_EQ(result.transfers, masterTransfers);
+	EXPECT_EQ(result.droppedTransfers, 0U);
+	EXPECT_EQ(result.transferErrors, 0U);
+	EXPECT_GT(result.pool.statistics.peak_usage_blocks, 0U);
+	EXPECT_EQ(result.pool.failures, 0U);
+	EXPECT_EQ(result.pool.lastFailure.count(), 0);
+	EXPECT_LE(result.frameTime(0.5), result.frameTime(0.99));
+	EXPECT_GT(result.cpuTime.count(), 0);
+
+	Device::SimTime::reset();
+	ReplayMaster second{16384};
+	const auto repeated = Replay::run(second.handler, trace);
+
+	EXPECT_EQ(repeated.transfers, result.transfers);
+	EXPECT_EQ(repeated.pool.statistics.peak_usage_blocks, result.pool.statistics.peak_usage_blocks);
+	EXPECT_TRUE(second.port.getOutput() == first.port.getOutput());
+}
+
+TEST(CanTrace, ReplayWithSmallPool)
+{
+	uint64_t masterTransfers;
+	const Device::CanTrace trace = capture(16, &masterTransfers);
+
+	Device::SimTime::reset();
+	ReplayMaster master{512};
+	const auto result = Replay::run(master.handler, trace);
+
+	printReport("SmallPool", result);
+
+	EXPECT_GT(result.droppedTransfers, 0U);
+	EXPECT_LT(result.transfers, masterTransfers);
+	EXPECT_EQ(result.pool.statistics.peak_usage_blocks, result.pool.statistics.capacity_blocks);
+
+	// Exhausted pool is reported by purpose with times of failures
+	const auto &usage = result.pool.usage;
+
+	EXPECT_EQ(result.pool.failures, usage.failures[CanardBlockRxState] + usage.failures[CanardBlockRxBuffer]
+		+ usage.failures[CanardBlockTxItem]);
+	EXPECT_GE(result.pool.failures, result.droppedTransfers);
+	EXPECT_GT(result.pool.firstFailure.count(), 0);
+	EXPECT_GT(result.pool.lastFailure, result.pool.firstFailure);
+	EXPECT_LE(usage.peak_blocks[CanardBlockRxState], result.pool.statistics.capacity_blocks);
+	EXPECT_GT(usage.peak_blocks[CanardBlockRxBuffer], 0U);
+}
@@ -0,0 +1,100 @@
+//
+// CaptureNetwork.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_TESTS_COMMON_CAPTURENETWORK_HPP_
+#define DRONEDEVICE_TESTS_COMMON_CAPTURENETWORK_HPP_
+
+#include "SimNetwork.hpp"
+#include <DroneDevice/Stubs/CanTrace.hpp>
+#include <DroneDevice/Stubs/CanTraceReplay.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+static constexpr size_t kMaxNodes{32};
+
+using ReplayMaster = Master<Device::ReplayCan, kMaxNodes>;
+using Replay = Device::CanTraceReplay<ReplayMaster::Handler>;
+
+//!
+//! Bus analyzer which stores all frames, like candump on a physical bus.
+//!
+class Recorder : public Device::VirtualCanNode {
+public:
+	explicit Recorder(Device::VirtualCanBus &aBus) :
+		bus{aBus},
+		trace{}
+	{
+		bus.attach(this);
+	}
+
+	~Recorder() override
+	{
+		bus.detach(this);
+	}
+
+	const Device::VirtualCanFrame *peek() const override
+	{
+		return nullptr;
+	}
+
+	void onTransmitted() override
+	{
+	}
+
+	void onTransmitError() override
+	{
+	}
+
+	void onBusOff() override
+	{
+	}
+
+	void onReceived(const CanMessage &aMessage) override
+	{
+		trace.append(Device::SimTime::microseconds(), aMessage);
+	}
+
+	Device::VirtualCanBus &bus;
+	Device::CanTrace trace;
+};
+
+//!
+//! Nodes with their own protocol stacks and a master on a virtual bus, the traffic is captured.
+//!
+struct Network {
+	Network(size_t aNodeCount, uint32_t aBitrate):
+		bus{aBitrate},
+		recorder{bus},
+		master{16384, bus},
+		nodes{}
+	{
+		master.port.setCallback([this]() { receive(master.port, master.handler); });
+
+		for (size_t i = 0; i < aNodeCount; ++i) {
+			nodes.emplace_back(new Node{bus, static_cast<uint32_t>(i + 1)});
+		}
+	}
+
+	void run(std::chrono::microseconds aDuration)
+	{
+		bus.run(aDuration, [this]() {
+			auto next = master.handler.onTimeoutOccurred();
+
+			for (auto &node : nodes) {
+				next = std::min(next, node->handler.onTimeoutOccurred());
+			}
+			return next;
+		});
+	}
+
+	Device::VirtualCanBus bus;
+	Recorder recorder;
+	Master<Port, kMaxNodes> master;
+	std::vector<std::unique_ptr<Node>> nodes;
+};
+
+#endif // DRONEDEVICE_TESTS_COMMON_CAPTURENETWORK_HPP_
@@ -0,0 +1,141 @@
+//
+// SimNetwork.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_TESTS_COMMON_SIMNETWORK_HPP_
+#define DRONEDEVICE_TESTS_COMMON_SIMNETWORK_HPP_
+
+#include <DroneDevice/InternalDevice/InternalDevice.hpp>
+#include <DroneDevice/InternalDevice/MemoryFile.hpp>
+#include <DroneDevice/PlazCan/CanProxyHub.hpp>
+#include <DroneDevice/PlazCan/InternalCanDevice.hpp>
+#include <DroneDevice/PlazCan/PlatformWrapper.hpp>
+#include <DroneDevice/PlazCan/UavCanHandler.hpp>
+#include <DroneDevice/Stubs/SimTime.hpp>
+#include <DroneDevice/Stubs/VirtualCanBus.hpp>
+#include <utility>
+#include <vector>
+
+// Deterministic random numbers for allocation intervals of nodes
+struct SimRng {
+	static void init()
+	{
+	}
+
+	static uint32_t random()
+	{
+		static uint32_t state{0x12345678};
+
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+};
+
+//!
+//! Device with a file, the content of the file depends on the serial number.
+//!
+class DUT : public Device::InternalDevice {
+public:
+	DUT(const char *aAlias, uint32_t aSerial):
+		Device::InternalDevice{aAlias, Device::Version{{1, 0}, {1, 0, 0, 0}}}
+	{
+		memcpy(hash.data(), &aSerial, sizeof(aSerial));
+		hash[sizeof(aSerial)] = 0xA5;
+
+		uint8_t content[64];
+
+		for (size_t i = 0; i < sizeof(content); ++i) {
+			content[i] = static_cast<uint8_t>(aSerial + i);
+		}
+
+		file.restartWrite();
+		file.writeChunk(0, content, sizeof(content));
+		file.finalizeWrite(sizeof(content));
+	}
+
+	Device::MemoryFile<64> file;
+
+	Device::AbstractFile *getFile(Device::FileId aFile) override
+	{
+		return aFile == 0 ? &file : nullptr;
+	}
+};
+
+using Port = Device::VirtualCan<64, 256>;
+using Platform = PlazCan::PlatformWrapper<Port, Device::SimTime, SimRng>;
+
+static constexpr Device::DeviceId kMasterAddress{127};
+
+//!
+//! Pass all received frames of the port to the protocol stack.
+//!
+template<typename Stack>
+static void receive(Port &aPort, Stack &aHandler)
+{
+	CanMessage messages[8];
+	size_t count;
+
+	while ((count = aPort.read(messages, 8)) != 0) {
+		aHandler.onMessageReceived(messages, count);
+	}
+}
+
+//!
+//! Device with its own controller and protocol stack, like a separate microcontroller on the bus.
+//!
+struct Node {
+	using Handler = PlazCan::UavCanHandler<Platform, 1>;
+	using CanDevice = PlazCan::InternalCanDevice<DUT, Handler>;
+
+	Node(Device::VirtualCanBus &aBus, uint32_t aSerial, size_t aArenaSize = 1024):
+		port{aBus},
+		arena(aArenaSize),
+		handler{port, arena.data(), arena.size()},
+		dut{"Node", aSerial},
+		device{dut, handler}
+	{
+		handler.attach(&device);
+		port.setCallback([this]() { receive(port, handler); });
+	}
+
+	Port port;
+	std::vector<uint8_t> arena;
+	Handler handler;
+	DUT dut;
+	CanDevice device;
+};
+
+//!
+//! Master which allocates addresses and keeps proxies of all nodes, frames are passed
+//! to the handler by the owner of the master.
+//! \tparam Bus Controller of the master, constructed from the trailing arguments of the constructor.
+//! \tparam maxNodes Capacity of the hub.
+//!
+template<typename Bus, size_t maxNodes>
+struct Master {
+	using Handler = PlazCan::UavCanHandler<PlazCan::PlatformWrapper<Bus, Device::SimTime, SimRng>, maxNodes + 1>;
+	using Hub = PlazCan::CanProxyHub<PlazCan::InternalCanDevice<DUT, Handler>, maxNodes>;
+
+	template<typename... Args>
+	Master(size_t aArenaSize, Args &&... aArgs):
+		port{std::forward<Args>(aArgs)...},
+		arena(aArenaSize),
+		handler{port, arena.data(), arena.size()},
+		dut{"Master", 0xFFFFFFFFUL},
+		hub{true, dut, handler, kMasterAddress, false}
+	{
+		handler.attach(&hub);
+	}
+
+	Bus port;
+	std::vector<uint8_t> arena;
+	Handler handler;
+	DUT dut;
+	Hub hub;
+};
+
+#endif // DRONEDEVICE_TESTS_COMMON_SIMNETWORK_HPP_
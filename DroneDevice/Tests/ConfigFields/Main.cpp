@@ -7,6 +7,7 @@
 
 #include <DroneDevice/ConfigStorage.hpp>
 #include <DroneDevice/Crc32.hpp>
+#include <DroneDevice/Stubs/MockFlashEngine.hpp>
 #include "gtest/gtest.h"
 #include "DUT.hpp"
 #include "MockConfig.hpp"
@@ -357,3 +358,216 @@ TEST(ConfigFieldTest, MemoryErrors)
 		}
 	}
 }
+
+using KeyedConfigMemory = MockMemory<2048>;
+using KeyedConfigType = KeyedConfigStorage<KeyedConfigMemory, Crc32, MockConfig, AlignedConfig, UnalignedConfig>;
+
+// Tests storing and lazy loading of keyed config entries
+TEST(ConfigFieldTest, KeyedLazyLoad)
+{
+	{
+		KeyedConfigType storage;
+
+		// Reset memory, default values will be used
+		KeyedConfigMemory::erase();
+		ASSERT_FALSE(storage.load());
+
+		DUT<KeyedConfigType, AlignedConfig> dut{"DUT", kDeviceVersion, storage};
+
+		const double coeff0Output = 8192.0;
+		const uint32_t coeff1Output = 262144;
+
+		ASSERT_EQ(dut.coeff0Field.write(&coeff0Output), Device::Result::SUCCESS);
+		ASSERT_EQ(dut.coeff1Field.write(&coeff1Output), Device::Result::SUCCESS);
+	}
+
+	{
+		// Entries are loaded on first access
+		KeyedConfigType storage;
+		DUT<KeyedConfigType, AlignedConfig> dut{"DUT", kDeviceVersion, storage};
+
+		ASSERT_EQ(static_cast<double>(dut.coeff0Field), 8192.0);
+		ASSERT_EQ(static_cast<uint32_t>(dut.coeff1Field), 262144);
+		ASSERT_TRUE(storage.isRestored<AlignedConfig>());
+		ASSERT_TRUE(storage.isRestored<MockConfig>());
+	}
+
+	{
+		// Entries that were never accessed survive the next store
+		KeyedConfigType storage;
+		DUT<KeyedConfigType, UnalignedConfig> dut{"DUT", kDeviceVersion, storage};
+
+		const uint32_t coeff1Output = 1024;
+		ASSERT_EQ(dut.coeff1Field.write(&coeff1Output), Device::Result::SUCCESS);
+	}
+
+	{
+		KeyedConfigType storage;
+
+		ASSERT_TRUE(storage.load());
+		ASSERT_EQ(getStorageEntry<AlignedConfig>(storage).coeff0, 8192.0);
+		ASSERT_EQ(getStorageEntry<UnalignedConfig>(storage).coeff1, 1024);
+	}
+}
+
+// Tests that damaged entry does not affect other entries
+TEST(ConfigFieldTest, KeyedMemoryErrors)
+{
+	using Record = KeyedConfigRecord<KeyedConfigMemory, Crc32>;
+
+	// Record consists of 8 bytes header, aligned data and 4 bytes checksum
+	const size_t position = Record::recordSize<MockConfig>();
+
+	for (uint32_t i = 0; i < (sizeof(AlignedConfig) + sizeof(uint32_t)) * 8; ++i) {
+		{
+			KeyedConfigType storage{true};
+
+			getStorageEntry<MockConfig>(storage).coeff1 = i;
+			getStorageEntry<AlignedConfig>(storage).coeff1 = i;
+			getStorageEntry<UnalignedConfig>(storage).coeff1 = i;
+			ASSERT_TRUE(storage.store());
+		}
+
+		const size_t offset = position + sizeof(Record::Header) + (i >> 3);
+		KeyedConfigMemory::arena()[offset] = static_cast<uint8_t>(KeyedConfigMemory::arena()[offset] ^ (1 << (i & 7)));
+
+		{
+			KeyedConfigType storage;
+
+			// Only the damaged entry falls back to default values
+			ASSERT_FALSE(storage.load());
+			ASSERT_TRUE(storage.isRestored<MockConfig>());
+			ASSERT_FALSE(storage.isRestored<AlignedConfig>());
+			ASSERT_TRUE(storage.isRestored<UnalignedConfig>());
+
+			ASSERT_EQ(getStorageEntry<MockConfig>(storage).coeff1, i);
+			ASSERT_EQ(getStorageEntry<AlignedConfig>(storage).coeff1, 131072);
+			ASSERT_EQ(getStorageEntry<UnalignedConfig>(storage).coeff1, i);
+		}
+	}
+}
+
+// Tests that records with damaged length do not extend beyond the memory region
+TEST(ConfigFieldTest, KeyedOversizedLength)
+{
+	using Record = KeyedConfigRecord<KeyedConfigMemory, Crc32>;
+
+	const size_t position = Record::recordSize<MockConfig>();
+	const size_t available = KeyedConfigMemory::capacity() - position - sizeof(Record::Header) - sizeof(uint32_t);
+
+	{
+		KeyedConfigType storage;
+
+		KeyedConfigMemory::erase();
+		ASSERT_TRUE(storage.store());
+	}
+
+	Record::Header header;
+	ASSERT_TRUE(Record::header(position, header));
+	ASSERT_EQ(header.length, sizeof(Record::WrapperType<AlignedConfig>));
+
+	// Record which ends exactly at the end of the region is accepted
+	header.length = static_cast<uint32_t>(available);
+	std::copy_n(reinterpret_cast<const uint8_t *>(&header), sizeof(header), KeyedConfigMemory::arena() + position);
+	ASSERT_TRUE(Record::header(position, header));
+
+	for (uint32_t length : {static_cast<uint32_t>(available + sizeof(uint32_t)), uint32_t{0x7FFFFFFC}, uint32_t{0xFFFFFFFC}}) {
+		header.length = length;
+		std::copy_n(reinterpret_cast<const uint8_t *>(&header), sizeof(header), KeyedConfigMemory::arena() + position);
+		ASSERT_FALSE(Record::header(position, header));
+
+		// Records before the damaged one are still restored
+		KeyedConfigType storage;
+
+		ASSERT_FALSE(storage.load());
+		ASSERT_TRUE(storage.isRestored<MockConfig>());
+		ASSERT_FALSE(storage.isRestored<AlignedConfig>());
+		ASSERT_FALSE(storage.isRestored<UnalignedConfig>());
+	}
+
+	// Headers at the end of the region are not read
+	ASSERT_FALSE(Record::header(KeyedConfigMemory::capacity() - sizeof(uint32_t), header));
+	ASSERT_FALSE(Record::header(KeyedConfigMemory::capacity() + sizeof(uint32_t), header));
+}
+
+// Tests that layout changes keep unchanged entries
+TEST(ConfigFieldTest, KeyedLayoutChange)
+{
+	using OldConfigType = KeyedConfigStorage<KeyedConfigMemory, Crc32, UnalignedConfig, MockConfig>;
+
+	{
+		OldConfigType storage;
+
+		KeyedConfigMemory::erase();
+		getStorageEntry<MockConfig>(storage).coeff2 = 4;
+		getStorageEntry<UnalignedConfig>(storage).coeff2 = 8;
+		ASSERT_TRUE(storage.store());
+	}
+
+	{
+		KeyedConfigType storage;
+
+		// New entry is inserted and the order of entries is changed
+		ASSERT_FALSE(storage.load());
+		ASSERT_TRUE(storage.isRestored<MockConfig>());
+		ASSERT_FALSE(storage.isRestored<AlignedConfig>());
+		ASSERT_TRUE(storage.isRestored<UnalignedConfig>());
+
+		ASSERT_EQ(getStorageEntry<MockConfig>(storage).coeff2, 4);
+		ASSERT_EQ(getStorageEntry<AlignedConfig>(storage).coeff2, 1024);
+		ASSERT_EQ(getStorageEntry<UnalignedConfig>(storage).coeff2, 8);
+	}
+}
+
+// Tests asynchronous store of config values
+TEST(ConfigFieldTest, AsyncStore)
+{
+	Device::MockFlashEngine<ConfigMemory> engine;
+
+	{
+		ConfigType storage;
+		bool completed = false;
+		bool status = false;
+
+		ConfigMemory::erase();
+		storage.load();
+
+		getStorageEntry<AlignedConfig>(storage).coeff1 = 524288;
+		ASSERT_TRUE(storage.store(engine, [&](bool aStatus) { completed = true; status = aStatus; }));
+
+		// Snapshot is taken, later changes are not stored
+		getStorageEntry<AlignedConfig>(storage).coeff1 = 0;
+
+		// Image is busy until the previous request is completed
+		ASSERT_FALSE(storage.store(engine));
+
+		engine.run();
+		ASSERT_TRUE(completed);
+		ASSERT_TRUE(status);
+	}
+
+	{
+		ConfigType storage;
+
+		ASSERT_TRUE(storage.load());
+		ASSERT_EQ(getStorageEntry<AlignedConfig>(storage).coeff1, 524288);
+	}
+
+	Device::MockFlashEngine<KeyedConfigMemory> keyedEngine;
+
+	{
+		KeyedConfigType storage;
+
+		KeyedConfigMemory::erase();
+		getStorageEntry<UnalignedConfig>(storage).coeff2 = 16;
+		ASSERT_TRUE(storage.store(keyedEngine));
+		keyedEngine.run();
+	}
+
+	{
+		KeyedConfigType storage;
+
+		ASSERT_TRUE(storage.load());
+		ASSERT_EQ(getStorageEntry<UnalignedConfig>(storage).coeff2, 16);
+	}
+}
@@ -19,6 +19,21 @@ public:
 	MockMemory(const MockMemory &) = delete;
 	MockMemory &operator=(const MockMemory &) = delete;
 
+	static constexpr uintptr_t address()
+	{
+		return 0;
+	}
+
+	static constexpr size_t capacity()
+	{
+		return size;
+	}
+
+	static bool isWritable()
+	{
+		return true;
+	}
+
 	static void lock()
 	{
 	}
@@ -33,6 +48,16 @@ public:
 		return true;
 	}
 
+	static bool erase(uintptr_t aOffset, size_t aLength)
+	{
+		if (aOffset + aLength <= size) {
+			std::fill(arena() + aOffset, arena() + aOffset + aLength, 0xFF);
+			return true;
+		} else {
+			return false;
+		}
+	}
+
 	static bool read(uintptr_t aOffset, void *aBuffer, size_t aLength)
 	{
 		if (aOffset + aLength <= size) {
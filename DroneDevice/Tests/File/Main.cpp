@@ -9,6 +9,18 @@
 #include <cmath>
 #include "gtest/gtest.h"
 #include "DUT.hpp"
+#include "MockFlash.hpp"
+#include <DroneDevice/DeltaEncoder.hpp>
+#include <DroneDevice/InternalDevice/CompressedFile.hpp>
+#include <DroneDevice/InternalDevice/FlashFile.hpp>
+#include <DroneDevice/InternalDevice/PatchFile.hpp>
+#include <DroneDevice/LzEncoder.hpp>
+#include <DroneDevice/MemoryRegion.hpp>
+#include <DroneDevice/Stubs/MockFlashEngine.hpp>
+#include <DroneDevice/Stubs/SimFlash.hpp>
+#include <atomic>
+#include <random>
+#include <thread>
 
 static constexpr Device::Version kDeviceVersion{{1, 2}, {3, 4, 0xCAFEFEED, 12345}};
 
@@ -130,3 +142,376 @@ TEST(File, DefaultMethods)
 		ASSERT_EQ(true, o1.passed);
 	}
 }
+
+using FileMemory = MockFlash<0x08010000, 4096, 1024>;
+
+// Tests streaming of unaligned chunks into flash
+TEST(File, FlashFileWrite)
+{
+	Device::FlashFile<FileMemory, 0x08010000, 4096, 64> file;
+	std::array<uint8_t, 1000> data;
+
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<uint8_t>(i * 7);
+	}
+
+	FileMemory::writes() = 0;
+	ASSERT_TRUE(file.restartWrite());
+
+	// Write unaligned chunks, the second chunk overlaps the first one
+	ASSERT_TRUE(file.writeChunk(0, data.data(), 13));
+	ASSERT_TRUE(file.writeChunk(5, data.data() + 5, 100));
+	ASSERT_FALSE(file.writeChunk(200, data.data() + 200, 10));
+	ASSERT_TRUE(file.writeChunk(105, data.data() + 105, data.size() - 105));
+
+	// Whole buffers are programmed at once
+	ASSERT_EQ(FileMemory::writes(), data.size() / 64);
+
+	// Data in the write buffer is readable before finalization
+	std::array<uint8_t, 20> chunk;
+	ASSERT_TRUE(file.readChunk(980, chunk.data(), chunk.size()));
+	ASSERT_EQ(0, memcmp(chunk.data(), data.data() + 980, chunk.size()));
+
+	ASSERT_FALSE(file.finalizeWrite(999));
+	ASSERT_TRUE(file.finalizeWrite(static_cast<uint32_t>(data.size())));
+	ASSERT_TRUE(file.isFinalized());
+	ASSERT_TRUE(FileMemory::locked());
+
+	ASSERT_EQ(file.getSize(), data.size());
+	ASSERT_EQ(file.getChecksum(), FastCrc32::update(Device::kFileInitialChecksum, data.data(), data.size()));
+	ASSERT_EQ(0, memcmp(FileMemory::arena(), data.data(), data.size()));
+
+	// Reading past the end of file
+	ASSERT_TRUE(file.readChunk(990, chunk.data(), chunk.size()));
+	ASSERT_EQ(0, memcmp(chunk.data(), data.data() + 990, 10));
+	ASSERT_FALSE(file.readChunk(1000, chunk.data(), chunk.size()));
+
+	// File created over programmed data calculates checksum from memory
+	const Device::FlashFile<FileMemory, 0x08010000, 4096, 64> restored{data.size()};
+	ASSERT_EQ(restored.getChecksum(), file.getChecksum());
+
+	// Rewriting requires erase
+	ASSERT_FALSE(file.writeChunk(0, data.data(), data.size()));
+}
+
+// Tests programming through an asynchronous engine
+TEST(File, FlashFileEngine)
+{
+	Device::FlashFile<FileMemory, 0x08010000, 4096, 64> file;
+	Device::MockFlashEngine<FileMemory> engine{true};
+	std::array<uint8_t, 4096> data;
+
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<uint8_t>(i * 3);
+	}
+
+	file.setEngine(engine);
+
+	ASSERT_TRUE(file.restartWrite());
+	for (size_t i = 0; i < data.size(); i += 100) {
+		ASSERT_TRUE(file.writeChunk(static_cast<uint32_t>(i), data.data() + i, std::min<size_t>(100, data.size() - i)));
+	}
+	ASSERT_FALSE(file.writeChunk(4096, data.data(), 1));
+	ASSERT_TRUE(file.finalizeWrite(static_cast<uint32_t>(data.size())));
+
+	ASSERT_EQ(file.getChecksum(), FastCrc32::update(Device::kFileInitialChecksum, data.data(), data.size()));
+	ASSERT_EQ(0, memcmp(FileMemory::arena(), data.data(), data.size()));
+}
+
+// Tests programming when jobs are completed later from another context
+TEST(File, FlashFileDeferredEngine)
+{
+	Device::FlashFile<FileMemory, 0x08010000, 4096, 64> file;
+	Device::MockFlashEngine<FileMemory> engine{false, 2};
+	std::array<uint8_t, 4096> data;
+
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<uint8_t>(i * 5);
+	}
+
+	file.setEngine(engine);
+
+	// Jobs are not completed before the interrupt handler runs
+	ASSERT_TRUE(file.restartWrite());
+	ASSERT_TRUE(file.writeChunk(0, data.data(), 64));
+	ASSERT_TRUE(engine.isBusy());
+	ASSERT_EQ(engine.getPeakJobs(), 2U);
+	engine.run();
+
+	// Interrupt handler of the flash controller completes jobs with a delay
+	std::atomic<bool> stop{false};
+	std::thread handler{[&engine, &stop]() {
+		while (!stop) {
+			engine.complete();
+			std::this_thread::sleep_for(std::chrono::microseconds{50});
+		}
+	}};
+
+	for (size_t i = 64; i < data.size(); i += 100) {
+		const size_t length = std::min<size_t>(100, data.size() - i);
+		std::array<uint8_t, 100> chunk;
+
+		ASSERT_TRUE(file.writeChunk(static_cast<uint32_t>(i), data.data() + i, length));
+
+		// Reading of programmed data waits for buffers in flight
+		ASSERT_TRUE(file.readChunk(static_cast<uint32_t>(i), chunk.data(), length));
+		ASSERT_EQ(0, memcmp(chunk.data(), data.data() + i, length));
+	}
+	ASSERT_TRUE(file.finalizeWrite(static_cast<uint32_t>(data.size())));
+
+	stop = true;
+	handler.join();
+
+	ASSERT_FALSE(engine.isBusy());
+	ASSERT_EQ(file.getChecksum(), FastCrc32::update(Device::kFileInitialChecksum, data.data(), data.size()));
+	ASSERT_EQ(0, memcmp(FileMemory::arena(), data.data(), data.size()));
+}
+
+// Tests decompression of a compressed stream into flash
+TEST(File, CompressedFile)
+{
+	using Region = Device::MemoryRegion<FileMemory, 0x08010000, 4096, true, true>;
+
+	alignas(8) static uint8_t window[512];
+	Device::CompressedFile<Region> file{window, sizeof(window)};
+	std::mt19937 generator{7};
+	std::vector<uint8_t> data(3000);
+
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = i % 200 < 150 ? static_cast<uint8_t>(i % 50) : static_cast<uint8_t>(generator());
+	}
+
+	const std::vector<uint8_t> stream = LzEncoder<>::compress(data.data(), data.size(), 9);
+	ASSERT_LT(stream.size(), data.size() / 2);
+
+	ASSERT_TRUE(file.restartWrite());
+	for (size_t i = 0; i < stream.size(); i += 100) {
+		const size_t length = std::min<size_t>(100, stream.size() - i);
+
+		ASSERT_TRUE(file.writeChunk(static_cast<uint32_t>(i), stream.data() + i, length));
+
+		// Repeated chunk is skipped
+		ASSERT_TRUE(file.writeChunk(static_cast<uint32_t>(i), stream.data() + i, length));
+	}
+	ASSERT_FALSE(file.finalizeWrite(static_cast<uint32_t>(data.size())));
+	ASSERT_TRUE(file.finalizeWrite(static_cast<uint32_t>(stream.size())));
+	ASSERT_TRUE(file.isFinalized());
+	ASSERT_TRUE(FileMemory::locked());
+
+	ASSERT_EQ(file.getSize(), data.size());
+	ASSERT_EQ(file.getChecksum(), FastCrc32::update(Device::kFileInitialChecksum, data.data(), data.size()));
+	ASSERT_EQ(0, memcmp(FileMemory::arena(), data.data(), data.size()));
+
+	std::array<uint8_t, 20> chunk;
+	ASSERT_TRUE(file.readChunk(2990, chunk.data(), chunk.size()));
+	ASSERT_EQ(0, memcmp(chunk.data(), data.data() + 2990, 10));
+
+	// Image larger than the region is rejected
+	const std::vector<uint8_t> large = LzEncoder<>::compress(std::vector<uint8_t>(5000).data(), 5000, 9);
+	ASSERT_TRUE(file.restartWrite());
+	ASSERT_FALSE(file.writeChunk(0, large.data(), large.size()));
+
+	// Stream with a damaged CRC is not finalized
+	std::vector<uint8_t> damaged = stream;
+	damaged[offsetof(LzHeader, crc)] ^= 0x01;
+	ASSERT_TRUE(file.restartWrite());
+	ASSERT_TRUE(file.writeChunk(0, damaged.data(), damaged.size()));
+	ASSERT_FALSE(file.finalizeWrite(static_cast<uint32_t>(damaged.size())));
+	ASSERT_FALSE(file.isFinalized());
+}
+
+using SourceMemory = MockFlash<0x08000000, 32768, 1024>;
+using StagingMemory = MockFlash<0x08008000, 32768, 1024>;
+
+// Tests applying a patch against the current image into a staging region
+TEST(File, PatchFile)
+{
+	using SourceRegion = Device::MemoryRegion<SourceMemory, 0x08000000, 32768, true, true>;
+	using StagingRegion = Device::MemoryRegion<StagingMemory, 0x08008000, 32768, true, true>;
+
+	std::mt19937 generator{44};
+	std::vector<uint8_t> source(20000);
+
+	for (auto &value : source) {
+		value = static_cast<uint8_t>(generator() % 16);
+	}
+	std::copy(source.begin(), source.end(), SourceMemory::arena());
+
+	// Insertion shifts the following code, absolute addresses in literal pools change
+	std::vector<uint8_t> target = source;
+	target.insert(target.begin() + 3000, 40, 0x5A);
+	for (size_t i = 3040; i < target.size(); i += 64) {
+		target[i] = static_cast<uint8_t>(target[i] + 40);
+	}
+	std::fill(target.begin() + 8000, target.begin() + 8010, 0xA5);
+	target.erase(target.begin() + 12000, target.begin() + 12100);
+
+	const std::vector<uint8_t> patch = DeltaEncoder<>::diff(source, target);
+	ASSERT_LT(patch.size(), target.size() / 10);
+
+	alignas(8) static uint8_t buffer[256];
+	Device::PatchFile<SourceRegion, StagingRegion> file{buffer, sizeof(buffer)};
+
+	ASSERT_TRUE(file.restartWrite());
+	for (size_t position = 0; position < patch.size();) {
+		const size_t length = std::min<size_t>(1 + generator() % 64, patch.size() - position);
+
+		ASSERT_TRUE(file.writeChunk(static_cast<uint32_t>(position), patch.data() + position, length));
+		position += length;
+	}
+	ASSERT_TRUE(file.finalizeWrite(static_cast<uint32_t>(patch.size())));
+	ASSERT_TRUE(file.isFinalized());
+	ASSERT_TRUE(StagingMemory::locked());
+
+	ASSERT_EQ(file.getSize(), target.size());
+	ASSERT_EQ(file.getChecksum(), FastCrc32::update(Device::kFileInitialChecksum, target.data(), target.size()));
+	ASSERT_EQ(0, memcmp(StagingMemory::arena(), target.data(), target.size()));
+
+	// Current image is not changed
+	ASSERT_EQ(0, memcmp(SourceMemory::arena(), source.data(), source.size()));
+
+	// Source image is not read when the header is received
+	const size_t sourceReads = SourceMemory::reads();
+	ASSERT_TRUE(file.restartWrite());
+	ASSERT_TRUE(file.writeChunk(0, patch.data(), sizeof(DeltaHeader)));
+	ASSERT_EQ(SourceMemory::reads(), sourceReads);
+
+	// Patch for another image is rejected once the source image is read
+	SourceMemory::arena()[100] ^= 0x01;
+	ASSERT_TRUE(file.restartWrite());
+	ASSERT_FALSE(file.writeChunk(0, patch.data(), patch.size())
+		&& file.finalizeWrite(static_cast<uint32_t>(patch.size())));
+	ASSERT_FALSE(file.isFinalized());
+	SourceMemory::arena()[100] ^= 0x01;
+
+	// Damaged patch is rejected either by the patcher or by the CRC
+	std::vector<uint8_t> damaged = patch;
+	damaged[damaged.size() - 1] ^= 0x01;
+	ASSERT_TRUE(file.restartWrite());
+	ASSERT_FALSE(file.writeChunk(0, damaged.data(), damaged.size())
+		&& file.finalizeWrite(static_cast<uint32_t>(damaged.size())));
+	ASSERT_FALSE(file.isFinalized());
+
+	// Truncated patch is not finalized
+	ASSERT_TRUE(file.restartWrite());
+	ASSERT_TRUE(file.writeChunk(0, patch.data(), patch.size() - 1));
+	ASSERT_FALSE(file.finalizeWrite(static_cast<uint32_t>(patch.size() - 1)));
+}
+
+// Tests programming rules, counters and power cuts of the simulated flash
+TEST(File, SimFlash)
+{
+	using HalfWordFlash = Device::SimFlash<1024, 4, Device::SimFlashF1, 0x08000000>;
+	using ByteFlash = Device::SimFlash<1024, 4, Device::SimFlashF4, 0x08000000>;
+
+	const uint8_t pattern[8] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0};
+
+	HalfWordFlash::format();
+	ASSERT_FALSE(HalfWordFlash::write(0x08000000, pattern, 2));
+	HalfWordFlash::unlock();
+
+	// Half-words are aligned and programmed once after erase
+	ASSERT_FALSE(HalfWordFlash::write(0x08000001, pattern, 2));
+	ASSERT_FALSE(HalfWordFlash::write(0x08000000, pattern, 3));
+	ASSERT_TRUE(HalfWordFlash::write(0x08000000, pattern, 4));
+	ASSERT_FALSE(HalfWordFlash::write(0x08000002, "\0\0", 2));
+	ASSERT_FALSE(HalfWordFlash::write(0x08000FFE, pattern, 4));
+	ASSERT_EQ(HalfWordFlash::counters().programs, 1);
+	ASSERT_EQ(HalfWordFlash::counters().programmedBytes, 4);
+	ASSERT_EQ(HalfWordFlash::counters().errors, 5);
+
+	// Pages are erased as a whole
+	ASSERT_FALSE(HalfWordFlash::erase(0x08000200, 1024));
+	ASSERT_TRUE(HalfWordFlash::erase(0x08000000, 2048));
+	ASSERT_TRUE(HalfWordFlash::erase(0x08000000, 1024));
+	ASSERT_EQ(HalfWordFlash::eraseCycles(0), 2);
+	ASSERT_EQ(HalfWordFlash::eraseCycles(1), 1);
+	ASSERT_EQ(HalfWordFlash::maxEraseCycles(), 2);
+	ASSERT_EQ(HalfWordFlash::data()[0], 0xFF);
+	HalfWordFlash::lock();
+
+	// Bits of programmed bytes may be cleared but not set
+	ByteFlash::format();
+	ByteFlash::unlock();
+	ASSERT_TRUE(ByteFlash::write(0x08000001, pattern, 1));
+	ASSERT_TRUE(ByteFlash::write(0x08000001, "\x02", 1));
+	ASSERT_FALSE(ByteFlash::write(0x08000001, "\x13", 1));
+	ASSERT_EQ(ByteFlash::data()[1], 0x02);
+
+	// Interrupted operation is incomplete and the memory is unavailable until the power is restored
+	ByteFlash::cutPowerAfter(5);
+	ASSERT_FALSE(ByteFlash::write(0x08000100, pattern, sizeof(pattern)));
+	ASSERT_FALSE(ByteFlash::isPowered());
+	ASSERT_EQ(0, memcmp(ByteFlash::data() + 0x100, pattern, 5));
+	ASSERT_EQ(ByteFlash::data()[0x105], 0xFF);
+
+	uint8_t value;
+	ASSERT_FALSE(ByteFlash::read(0x08000100, &value, 1));
+	ByteFlash::restorePower();
+	ASSERT_TRUE(ByteFlash::read(0x08000100, &value, 1));
+	ASSERT_EQ(value, pattern[0]);
+
+	const std::vector<uint8_t> zeros(1024, 0);
+	ASSERT_TRUE(ByteFlash::write(0x08000400, zeros.data(), zeros.size()));
+	ByteFlash::cutPowerAfter(1500);
+	ASSERT_FALSE(ByteFlash::erase(0x08000000, 2048));
+	ASSERT_EQ(ByteFlash::data()[1499], 0xFF);
+	ASSERT_EQ(ByteFlash::data()[1500], 0x00);
+	ByteFlash::restorePower();
+	ByteFlash::lock();
+
+	// Content of the file-backed memory survives remapping
+	const std::string path = ::testing::TempDir() + "SimFlash.bin";
+	unlink(path.c_str());
+
+	ASSERT_TRUE(ByteFlash::open(path.c_str()));
+	ASSERT_EQ(ByteFlash::data()[0], 0xFF);
+	ByteFlash::unlock();
+	ASSERT_TRUE(ByteFlash::write(0x08000010, pattern, sizeof(pattern)));
+	ByteFlash::lock();
+	ByteFlash::close();
+	ASSERT_NE(0, memcmp(ByteFlash::data() + 0x10, pattern, sizeof(pattern)));
+
+	ASSERT_TRUE(ByteFlash::open(path.c_str()));
+	ASSERT_EQ(0, memcmp(ByteFlash::data() + 0x10, pattern, sizeof(pattern)));
+	ByteFlash::close();
+	unlink(path.c_str());
+}
+
+// Tests that an update interrupted by a power cut at any point can be restarted
+TEST(File, FlashFilePowerCut)
+{
+	using Flash = Device::SimFlash<1024, 4, Device::SimFlashL4, 0x08010000>;
+
+	std::vector<uint8_t> data(3000);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<uint8_t>(i * 13);
+	}
+
+	for (size_t cut = 0; cut < 4096 + data.size(); cut += 97) {
+		Device::FlashFile<Flash, 0x08010000, 4096, 64> file;
+
+		Flash::format();
+		Flash::cutPowerAfter(cut);
+
+		bool result = file.restartWrite();
+		for (size_t i = 0; result && i < data.size(); i += 100) {
+			result = file.writeChunk(static_cast<uint32_t>(i), data.data() + i, std::min<size_t>(100, data.size() - i));
+		}
+		result = result && file.finalizeWrite(static_cast<uint32_t>(data.size()));
+
+		ASSERT_EQ(result, Flash::isPowered());
+		Flash::restorePower();
+
+		// Device restarts and the update is repeated from the beginning
+		Device::FlashFile<Flash, 0x08010000, 4096, 64> restarted;
+
+		ASSERT_TRUE(restarted.restartWrite());
+		ASSERT_TRUE(restarted.writeChunk(0, data.data(), data.size()));
+		ASSERT_TRUE(restarted.finalizeWrite(static_cast<uint32_t>(data.size())));
+		ASSERT_EQ(0, memcmp(Flash::data(), data.data(), data.size()));
+	}
+
+	// Whole region is erased once per attempt
+	ASSERT_EQ(Flash::maxEraseCycles(), 2);
+}
@@ -0,0 +1,106 @@
+//
+// MockFlash.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef DRONEDEVICE_TESTS_FILE_MOCKFLASH_HPP_
+#define DRONEDEVICE_TESTS_FILE_MOCKFLASH_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+//!
+//! Memory interface with absolute addressing and NOR semantics:
+//! programming can only clear bits of erased memory.
+//!
+template<uintptr_t base, size_t size, size_t pageSize>
+class MockFlash {
+public:
+	MockFlash() = delete;
+	MockFlash(const MockFlash &) = delete;
+	MockFlash &operator=(const MockFlash &) = delete;
+
+	static bool isProtected()
+	{
+		return false;
+	}
+
+	static void lock()
+	{
+		locked() = true;
+	}
+
+	static void unlock()
+	{
+		locked() = false;
+	}
+
+	static bool erase(uintptr_t aOffset, size_t aLength)
+	{
+		if (locked() || aOffset < base || aOffset + aLength > base + size || (aOffset - base) % pageSize != 0) {
+			return false;
+		}
+
+		std::fill(arena() + (aOffset - base), arena() + (aOffset - base + aLength), 0xFF);
+		return true;
+	}
+
+	static bool read(uintptr_t aOffset, void *aBuffer, size_t aLength)
+	{
+		if (aOffset < base || aOffset + aLength > base + size) {
+			return false;
+		}
+
+		std::copy(arena() + (aOffset - base), arena() + (aOffset - base + aLength), static_cast<uint8_t *>(aBuffer));
+		++reads();
+		return true;
+	}
+
+	static bool write(uintptr_t aOffset, const void *aBuffer, size_t aLength)
+	{
+		if (locked() || aOffset < base || aOffset + aLength > base + size || aLength % sizeof(uint32_t) != 0) {
+			return false;
+		}
+
+		const uint8_t * const buffer = static_cast<const uint8_t *>(aBuffer);
+		uint8_t * const memory = arena() + (aOffset - base);
+
+		for (size_t i = 0; i < aLength; ++i) {
+			if ((memory[i] & buffer[i]) != buffer[i]) {
+				return false;
+			}
+			memory[i] = buffer[i];
+		}
+
+		++writes();
+		return true;
+	}
+
+	static uint8_t *arena()
+	{
+		static uint8_t memory[size];
+		return memory;
+	}
+
+	static bool &locked()
+	{
+		static bool state{true};
+		return state;
+	}
+
+	static size_t &writes()
+	{
+		static size_t count{0};
+		return count;
+	}
+
+	static size_t &reads()
+	{
+		static size_t count{0};
+		return count;
+	}
+};
+
+#endif // DRONEDEVICE_TESTS_FILE_MOCKFLASH_HPP_
@@ -6,13 +6,83 @@
 //
 
 #include "gtest/gtest.h"
+#include <DroneDevice/AcceleratedCrc32.hpp>
+#include <DroneDevice/Aes.hpp>
 #include <DroneDevice/Crc16.hpp>
 #include <DroneDevice/Crc32.hpp>
 #include <DroneDevice/FastCrc16.hpp>
 #include <DroneDevice/FastCrc32.hpp>
+#include <DroneDevice/FastCrc8.hpp>
+#include <DroneDevice/FirmwareTrailer.hpp>
+#include <DroneDevice/HostCrc32.hpp>
+#include <DroneDevice/InplaceFunction.hpp>
+#include <DroneDevice/LzDecoder.hpp>
+#include <DroneDevice/LzEncoder.hpp>
+#include <DroneDevice/Oversampling.hpp>
+#include <DroneDevice/PlatformCrc32.hpp>
+#include <DroneDevice/SliceCrc16.hpp>
+#include <DroneDevice/SliceCrc32.hpp>
+#include <DroneDevice/SliceCrc8.hpp>
 
 #include <DroneDevice/RefCounter.hpp>
 #include <DroneDevice/RequestPool.hpp>
+#include <DroneDevice/Sha256.hpp>
+#include <DroneDevice/TaskQueue.hpp>
+#include <DroneDevice/TimerWheel.hpp>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Software model of the hardware CRC unit
+class MockCrc32Unit {
+public:
+	static void reset()
+	{
+		value() = 0xFFFFFFFFUL;
+	}
+
+	static uint32_t state()
+	{
+		return value();
+	}
+
+	static void feed(const uint32_t *aData, size_t aCount)
+	{
+		words() += aCount;
+
+		while (aCount--) {
+			value() = ~Crc32::update(~value(), aData++, sizeof(uint32_t));
+		}
+	}
+
+	static uint32_t &value()
+	{
+		static uint32_t state{0};
+		return state;
+	}
+
+	static size_t &words()
+	{
+		static size_t count{0};
+		return count;
+	}
+};
+
+struct InitCountingCrc32 : AcceleratedCrc32<MockCrc32Unit> {
+	static void init()
+	{
+		++inits();
+	}
+
+	static size_t &inits()
+	{
+		static size_t count{0};
+		return count;
+	}
+};
 
 // Tests reading of default values from generic volatile fields
 TEST(UtilsTest, Crc)
@@ -38,6 +108,678 @@ TEST(UtilsTest, Crc)
 	ASSERT_EQ(FastCrc32::update(0, "123456789", 9), 0xCBF43926);
 }
 
+// Tests accelerated CRC32 against software implementations
+TEST(UtilsTest, AcceleratedCrc)
+{
+	using TestCrc32 = AcceleratedCrc32<MockCrc32Unit>;
+
+	ASSERT_EQ(TestCrc32::update(0xFFFF, "123456789", 9), 0xA4F0338B);
+	ASSERT_EQ(TestCrc32::update(0, "123456789012345678901234567890", 30),
+		Crc32::update(0, "123456789012345678901234567890", 30));
+
+	std::mt19937 generator{12345};
+	std::vector<uint8_t> data(4096 + 3);
+
+	for (auto &value : data) {
+		value = static_cast<uint8_t>(generator());
+	}
+
+	MockCrc32Unit::words() = 0;
+
+	for (size_t iteration = 0; iteration < 200; ++iteration) {
+		const size_t offset = generator() % 4;
+		const size_t length = generator() % (data.size() - offset);
+		const uint32_t seed = iteration % 3 == 0 ? 0 : static_cast<uint32_t>(generator());
+
+		const uint32_t expected = Crc32::update(seed, data.data() + offset, length);
+		ASSERT_EQ(FastCrc32::update(seed, data.data() + offset, length), expected);
+		ASSERT_EQ(TestCrc32::update(seed, data.data() + offset, length), expected);
+
+		// Calculation split into several parts
+		const size_t split = length / 3;
+		uint32_t checksum = TestCrc32::update(seed, data.data() + offset, split);
+		checksum = TestCrc32::update(checksum, data.data() + offset + split, length - split);
+		ASSERT_EQ(checksum, expected);
+	}
+
+	// Most of the data should be processed by the unit
+	ASSERT_GT(MockCrc32Unit::words(), 100 * 1024);
+
+	// Unit of the default checksum is enabled once before the first checksum
+	using LazyCrc32 = AutoInitCrc32<InitCountingCrc32>;
+
+	ASSERT_EQ(InitCountingCrc32::inits(), 0U);
+	ASSERT_EQ(LazyCrc32::update(0, "123456789", 9), 0xCBF43926);
+	ASSERT_EQ(LazyCrc32::update(0, data.data(), data.size()), Crc32::update(0, data.data(), data.size()));
+	ASSERT_EQ(InitCountingCrc32::inits(), 1U);
+
+	// Build host has no calculation unit
+	ASSERT_TRUE((std::is_same<PlatformCrc32, FastCrc32>::value));
+}
+
+// Tests slice-by-8 and host accelerated CRC against table implementations
+TEST(UtilsTest, SliceCrc)
+{
+	ASSERT_EQ(SliceCrc16::update(0xFFFF, "123456789", 9), 0x29B1);
+	ASSERT_EQ(SliceCrc32::update(0, "123456789", 9), 0xCBF43926);
+	ASSERT_EQ(HostCrc32::update(0, "123456789", 9), 0xCBF43926);
+
+	std::mt19937 generator{54321};
+	std::vector<uint8_t> data(65536 + 7);
+
+	for (auto &value : data) {
+		value = static_cast<uint8_t>(generator());
+	}
+
+	for (size_t iteration = 0; iteration < 200; ++iteration) {
+		const size_t offset = generator() % 8;
+		const size_t length = iteration < 100 ? generator() % 300 : generator() % (data.size() - offset);
+		const uint8_t * const buffer = data.data() + offset;
+		const uint32_t seed = static_cast<uint32_t>(generator());
+
+		ASSERT_EQ(SliceCrc8::update(static_cast<uint8_t>(seed), buffer, length),
+			FastCrc8::update(static_cast<uint8_t>(seed), buffer, length));
+		ASSERT_EQ(SliceCrc16::update(static_cast<uint16_t>(seed), buffer, length),
+			FastCrc16::update(static_cast<uint16_t>(seed), buffer, length));
+
+		const uint32_t expected = FastCrc32::update(seed, buffer, length);
+		ASSERT_EQ(SliceCrc32::update(seed, buffer, length), expected);
+		ASSERT_EQ(HostCrc32::update(seed, buffer, length), expected);
+	}
+}
+
+static std::string toHex(const std::array<uint8_t, 32> &aHash)
+{
+	static const char digits[] = "0123456789abcdef";
+	std::string result;
+
+	for (auto value : aHash) {
+		result += digits[value >> 4];
+		result += digits[value & 0x0F];
+	}
+
+	return result;
+}
+
+// Tests SHA-256 with reference vectors and with buffers split at arbitrary positions
+TEST(UtilsTest, Sha256)
+{
+	Sha256 sha;
+
+	ASSERT_EQ(toHex(sha.finalize()), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+	sha.reset();
+	sha.update(reinterpret_cast<const uint8_t *>("abc"), 3);
+	ASSERT_EQ(toHex(sha.finalize()), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+	static const char message[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+	sha.reset();
+	sha.update(reinterpret_cast<const uint8_t *>(message), sizeof(message) - 1);
+	ASSERT_EQ(toHex(sha.finalize()), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+	const std::vector<uint8_t> million(1000000, 'a');
+	sha.reset();
+	sha.update(million.data(), million.size());
+	ASSERT_EQ(toHex(sha.finalize()), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+	std::mt19937 generator{12345};
+	std::vector<uint8_t> data(4096 + 3);
+
+	for (auto &value : data) {
+		value = static_cast<uint8_t>(generator());
+	}
+
+	for (size_t iteration = 0; iteration < 100; ++iteration) {
+		const size_t offset = generator() % 4;
+		const size_t length = generator() % (data.size() - offset);
+		const uint8_t * const buffer = data.data() + offset;
+
+		sha.reset();
+		sha.update(buffer, length);
+		const auto expected = sha.finalize();
+
+		sha.reset();
+		for (size_t position = 0; position < length;) {
+			const size_t chunk = std::min<size_t>(generator() % 150, length - position);
+
+			sha.update(buffer + position, chunk);
+			position += chunk;
+		}
+		ASSERT_EQ(sha.finalize(), expected);
+	}
+}
+
+static std::vector<uint8_t> fromHex(const char *aText)
+{
+	std::vector<uint8_t> result;
+
+	for (; aText[0] && aText[1]; aText += 2) {
+		result.push_back(static_cast<uint8_t>(std::stoul(std::string{aText, 2}, nullptr, 16)));
+	}
+
+	return result;
+}
+
+// Tests AES-128 block cipher and modes with vectors from FIPS-197 and SP 800-38A
+TEST(UtilsTest, Aes)
+{
+	const auto fipsKey = fromHex("000102030405060708090a0b0c0d0e0f");
+	const auto fipsPlain = fromHex("00112233445566778899aabbccddeeff");
+	const auto fipsCipher = fromHex("69c4e0d86a7b0430d8cdb78070b4c55a");
+	const AesCipher cipher{fipsKey.data()};
+	uint8_t block[AesCipher::kBlockSize];
+
+	cipher.encryptBlock(fipsPlain.data(), block);
+	ASSERT_TRUE(std::equal(fipsCipher.begin(), fipsCipher.end(), block));
+	cipher.decryptBlock(block, block);
+	ASSERT_TRUE(std::equal(fipsPlain.begin(), fipsPlain.end(), block));
+
+	static const char key[] = "2B7E151628AED2A6ABF7158809CF4F3C";
+	const auto plain = fromHex("6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+		"30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+	const auto cbcIv = fromHex("000102030405060708090a0b0c0d0e0f");
+	const auto cbcCipher = fromHex("7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2"
+		"73bed6b8e3c1743b7116e69e222295163ff1caa1681fac09120eca307586e1a7");
+	const auto ctrCounter = fromHex("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+	const auto ctrCipher = fromHex("874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+		"5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee");
+
+	// CBC with bulk and block by block processing
+	Aes cbc{key};
+	std::vector<uint8_t> data = plain;
+
+	cbc.reset(cbcIv.data());
+	cbc.encrypt(data.data(), data.size());
+	ASSERT_EQ(data, cbcCipher);
+
+	cbc.reset(cbcIv.data());
+	cbc.decrypt(data.data(), 32);
+	cbc.decrypt(data.data() + 32);
+	cbc.decrypt(data.data() + 48);
+	ASSERT_EQ(data, plain);
+
+	// CTR with chunks of arbitrary length
+	AesCtr ctr{key, ctrCounter.data()};
+
+	data = plain;
+	ctr.process(data.data(), data.size());
+	ASSERT_EQ(data, ctrCipher);
+
+	ctr.reset(ctrCounter.data());
+	ctr.process(data.data(), 5);
+	ctr.process(data.data() + 5, 16);
+	ctr.process(data.data() + 21, 0);
+	ctr.process(data.data() + 21, 43);
+	ASSERT_EQ(data, plain);
+
+	// Counter overflow is carried through all bytes
+	const uint8_t counter[AesCipher::kBlockSize] = {
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF
+	};
+	const uint8_t carried[AesCipher::kBlockSize] = {
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00
+	};
+	uint8_t zeros[AesCipher::kBlockSize * 2] = {};
+
+	ctr.reset(counter);
+	ctr.process(zeros, sizeof(zeros));
+	cbc.encryptBlock(carried, block);
+	ASSERT_TRUE(std::equal(block, block + sizeof(block), zeros + AesCipher::kBlockSize));
+}
+
+class MockClock {
+public:
+	static std::chrono::microseconds microseconds()
+	{
+		return time();
+	}
+
+	static void wakeAt(std::chrono::microseconds aDeadline)
+	{
+		wakeUp() = aDeadline;
+	}
+
+	static std::chrono::microseconds &time()
+	{
+		static std::chrono::microseconds value{0};
+		return value;
+	}
+
+	static std::chrono::microseconds &wakeUp()
+	{
+		static std::chrono::microseconds value{0};
+		return value;
+	}
+};
+
+// Tests timer wheel against a simple list of deadlines
+TEST(UtilsTest, TimerWheel)
+{
+	using Wheel = TimerWheel<MockClock, 1000, 2>;
+	using std::chrono::microseconds;
+
+	static constexpr size_t kTimers{64};
+
+	Wheel wheel;
+	std::mt19937 generator{777};
+	std::vector<std::unique_ptr<Wheel::Timer>> timers;
+	std::map<size_t, microseconds> expected;
+	std::vector<size_t> fired;
+
+	MockClock::time() = microseconds{0};
+	ASSERT_EQ(wheel.poll(), microseconds::max());
+
+	for (size_t i = 0; i < kTimers; ++i) {
+		timers.emplace_back(new Wheel::Timer{[i, &fired]() { fired.push_back(i); }});
+	}
+
+	for (size_t iteration = 0; iteration < 20000; ++iteration) {
+		const size_t index = generator() % kTimers;
+
+		switch (generator() % 4) {
+			case 0:
+			case 1: {
+				// Short, long and overflowing delays with two levels of 32 slots
+				static const uint32_t kRanges[] = {40, 1100, 5000000};
+				const auto deadline = MockClock::time()
+					+ microseconds{static_cast<int64_t>(generator() % kRanges[generator() % 3]) * 1000};
+
+				wheel.arm(*timers[index], deadline);
+				expected[index] = deadline;
+				break;
+			}
+
+			case 2:
+				wheel.cancel(*timers[index]);
+				expected.erase(index);
+				break;
+
+			default: {
+				// Jump to the next deadline or to a random time
+				const auto next = wheel.nextDeadline();
+				microseconds step{static_cast<int64_t>(generator() % 3000000)};
+
+				if (next != microseconds::max() && generator() % 2) {
+					step = next - MockClock::time();
+				}
+
+				MockClock::time() += step;
+				fired.clear();
+				wheel.poll();
+
+				std::vector<size_t> due;
+				for (auto entry = expected.begin(); entry != expected.end();) {
+					if (entry->second <= MockClock::time()) {
+						due.push_back(entry->first);
+						entry = expected.erase(entry);
+					} else {
+						++entry;
+					}
+				}
+
+				std::sort(fired.begin(), fired.end());
+				ASSERT_EQ(fired, due);
+				break;
+			}
+		}
+
+		for (size_t i = 0; i < kTimers; ++i) {
+			ASSERT_EQ(timers[i]->armed(), expected.count(i) != 0);
+		}
+
+		// Next deadline should not be later than the earliest timer rounded up to ticks
+		microseconds earliest = microseconds::max();
+		for (const auto &entry : expected) {
+			earliest = std::min(earliest, (entry.second + microseconds{999}) / 1000 * 1000);
+		}
+		ASSERT_LE(wheel.nextDeadline(), earliest);
+	}
+
+	// Callbacks are able to rearm timers
+	Wheel::Timer periodic;
+	size_t count = 0;
+
+	periodic.setCallback([&]() {
+		if (++count < 5) {
+			wheel.arm(periodic, MockClock::time() + microseconds{10000});
+		}
+	});
+	wheel.arm(periodic, MockClock::time() + microseconds{10000});
+
+	while (periodic.armed()) {
+		MockClock::time() = wheel.poll();
+	}
+	ASSERT_EQ(count, 5);
+
+	// Timer rearmed with an elapsed deadline expires once per tick
+	Wheel::Timer overdue;
+	Wheel::Timer cancelled{[&]() { ++count; }};
+	count = 0;
+
+	overdue.setCallback([&]() {
+		++count;
+		wheel.cancel(cancelled);
+		wheel.arm(overdue, MockClock::time() - microseconds{5000});
+	});
+
+	// Both timers are placed into the current slot, the last armed timer expires first
+	wheel.poll();
+	wheel.arm(cancelled, MockClock::time());
+	wheel.arm(overdue, MockClock::time());
+
+	ASSERT_EQ(wheel.poll(), MockClock::time() + microseconds{1000});
+	ASSERT_EQ(count, 1);
+	ASSERT_FALSE(cancelled.armed());
+
+	MockClock::time() += microseconds{3000};
+	wheel.poll();
+	ASSERT_EQ(count, 4);
+	wheel.cancel(overdue);
+
+	// Deadline of an armed timer is only moved towards the current time
+	wheel.armEarlier(periodic, MockClock::time() + microseconds{20000});
+	wheel.armEarlier(periodic, MockClock::time() + microseconds{30000});
+	ASSERT_EQ(periodic.deadline(), MockClock::time() + microseconds{20000});
+	wheel.armEarlier(periodic, MockClock::time() + microseconds{10000});
+	ASSERT_EQ(periodic.deadline(), MockClock::time() + microseconds{10000});
+	wheel.cancel(periodic);
+
+	// Timers outliving the wheel are released
+	{
+		Wheel temporary;
+		temporary.arm(periodic, MockClock::time() + microseconds{1000});
+		temporary.arm(overdue, MockClock::time() + microseconds{100000000});
+	}
+	ASSERT_FALSE(periodic.armed());
+	ASSERT_FALSE(overdue.armed());
+
+	// Timer is removed from the wheel during destruction
+	{
+		Wheel::Timer temporary;
+		wheel.arm(temporary, MockClock::time() + microseconds{1000});
+	}
+	timers.clear();
+	MockClock::time() += microseconds{100000000};
+	ASSERT_EQ(wheel.poll(), microseconds::max());
+
+	wheel.scheduleWakeUp();
+	ASSERT_EQ(MockClock::wakeUp(), microseconds::max());
+}
+
+// Tests creation and checking of firmware trailers
+TEST(UtilsTest, FirmwareTrailer)
+{
+	std::mt19937 generator{2026};
+	std::vector<uint8_t> image(10000);
+
+	for (auto &value : image) {
+		value = static_cast<uint8_t>(generator());
+	}
+
+	// Image is written in chunks of random length
+	FirmwareTrailerBuilder<SliceCrc32> builder;
+
+	for (size_t position = 0; position < image.size();) {
+		const size_t length = std::min<size_t>(generator() % 700, image.size() - position);
+
+		builder.update(image.data() + position, length);
+		position += length;
+	}
+
+	const FirmwareTrailer trailer = builder.finalize(0x12345678);
+	Sha256 sha;
+
+	sha.update(image.data(), image.size());
+	const auto digest = sha.finalize();
+
+	ASSERT_EQ(trailer.size, image.size());
+	ASSERT_EQ(trailer.buildId, 0x12345678);
+	ASSERT_EQ(trailer.crc, Crc32::update(0, image.data(), image.size()));
+	ASSERT_EQ(memcmp(trailer.digest, digest.data(), digest.size()), 0);
+
+	ASSERT_TRUE(trailer.isValid(image.size()));
+	ASSERT_FALSE(trailer.isValid(image.size() - 1));
+	ASSERT_TRUE(trailer.verify(image.data()));
+	ASSERT_TRUE(trailer.verify<HostCrc32>(image.data()));
+	ASSERT_TRUE(trailer.verifyDigest(image.data()));
+
+	// Changes of the image are detected by both checks
+	image[5000] ^= 0x01;
+	ASSERT_FALSE(trailer.verify(image.data()));
+	ASSERT_FALSE(trailer.verifyDigest(image.data()));
+
+	// Changes of the trailer are detected without reading the image
+	FirmwareTrailer damaged = trailer;
+	damaged.buildId ^= 1;
+	ASSERT_FALSE(damaged.isValid(image.size()));
+
+	FirmwareTrailer erased;
+	memset(&erased, 0xFF, sizeof(erased));
+	ASSERT_FALSE(erased.isValid(SIZE_MAX));
+}
+
+// Tests streaming decompression of chunks of random length
+TEST(UtilsTest, LzDecoder)
+{
+	std::mt19937 generator{43};
+	std::vector<uint8_t> image;
+
+	// Recent fragments repeated with random changes resemble machine code
+	while (image.size() < 20000) {
+		if (image.size() > 64 && generator() % 3) {
+			const size_t source = image.size() - 32 - generator() % std::min<size_t>(image.size() - 32, 1500);
+			const size_t length = 4 + generator() % 28;
+
+			image.insert(image.end(), image.begin() + static_cast<ptrdiff_t>(source),
+				image.begin() + static_cast<ptrdiff_t>(source + length));
+		} else {
+			image.push_back(static_cast<uint8_t>(generator()));
+		}
+	}
+	image.insert(image.end(), 700, 0xFF);
+
+	const std::vector<uint8_t> stream = LzEncoder<>::compress(image.data(), image.size(), 11);
+	ASSERT_LT(stream.size(), image.size() / 2);
+
+	alignas(8) uint8_t window[2048];
+	std::vector<uint8_t> output;
+	LzDecoder<SliceCrc32> decoder{window, sizeof(window), [&output](size_t aPosition, const void *aBuffer,
+		size_t aLength) {
+		// Blocks are sequential and aligned
+		EXPECT_EQ(aPosition, output.size());
+		EXPECT_EQ(aLength % 8, 0);
+		output.insert(output.end(), static_cast<const uint8_t *>(aBuffer),
+			static_cast<const uint8_t *>(aBuffer) + aLength);
+		return true;
+	}};
+
+	auto feed = [&generator, &decoder](const std::vector<uint8_t> &aStream) {
+		for (size_t position = 0; position < aStream.size();) {
+			const size_t length = std::min<size_t>(1 + generator() % 300, aStream.size() - position);
+
+			if (!decoder.update(aStream.data() + position, length)) {
+				return false;
+			}
+			position += length;
+		}
+		return true;
+	};
+
+	ASSERT_TRUE(feed(stream));
+	ASSERT_TRUE(decoder.isComplete());
+	ASSERT_TRUE(decoder.finalize());
+	ASSERT_EQ(decoder.getFlushed(), image.size());
+	ASSERT_EQ(decoder.getChecksum(), Crc32::update(0, image.data(), image.size()));
+
+	// Last block is padded with the erased value
+	ASSERT_EQ(output.size() % 8, 0);
+	ASSERT_TRUE(std::equal(image.begin(), image.end(), output.begin()));
+	ASSERT_TRUE(std::all_of(output.begin() + static_cast<ptrdiff_t>(image.size()), output.end(),
+		[](uint8_t aValue) { return aValue == 0xFF; }));
+
+	// Data after the end of the stream is rejected
+	ASSERT_FALSE(decoder.update(stream.data(), 1));
+
+	// Truncated stream is not finalized
+	decoder.reset();
+	output.clear();
+	ASSERT_TRUE(feed(std::vector<uint8_t>(stream.begin(), stream.end() - 1)));
+	ASSERT_FALSE(decoder.finalize());
+
+	// Damaged stream is rejected either by the decoder or by the CRC
+	std::vector<uint8_t> damaged = stream;
+	damaged[stream.size() / 2] ^= 0x01;
+	decoder.reset();
+	output.clear();
+	ASSERT_FALSE(feed(damaged) && decoder.finalize());
+
+	// Stream with a window larger than the buffer is rejected
+	const std::vector<uint8_t> wide = LzEncoder<>::compress(image.data(), image.size(), 12);
+	decoder.reset();
+	ASSERT_FALSE(decoder.update(wide.data(), wide.size()));
+
+	// Empty stream
+	const std::vector<uint8_t> empty = LzEncoder<>::compress(nullptr, 0);
+	decoder.reset();
+	output.clear();
+	ASSERT_TRUE(decoder.update(empty.data(), empty.size()));
+	ASSERT_TRUE(decoder.finalize());
+	ASSERT_TRUE(output.empty());
+}
+
+// Tests in-place averaging of interleaved samples
+TEST(UtilsTest, Oversampling)
+{
+	uint16_t buffer[24];
+	std::mt19937 generator{123};
+
+	for (auto &sample : buffer) {
+		sample = static_cast<uint16_t>(generator() & 0x0FFF);
+	}
+
+	// Reference averages of three channels with the ratio of four
+	std::vector<uint16_t> expected;
+	for (size_t group = 0; group < 2; ++group) {
+		for (size_t channel = 0; channel < 3; ++channel) {
+			uint32_t sum = 0;
+
+			for (size_t sequence = 0; sequence < 4; ++sequence) {
+				sum += buffer[group * 12 + sequence * 3 + channel];
+			}
+			expected.push_back(static_cast<uint16_t>((sum + 2) / 4));
+		}
+	}
+
+	ASSERT_EQ((Oversampling<3, 4>::reduce(buffer, 24)), 6);
+	ASSERT_EQ(std::vector<uint16_t>(buffer, buffer + 6), expected);
+
+	// Samples are kept without oversampling
+	ASSERT_EQ((Oversampling<3, 1>::reduce(buffer, 6)), 6);
+	ASSERT_EQ(std::vector<uint16_t>(buffer, buffer + 6), expected);
+
+	// Full scale values do not overflow
+	uint16_t full[2 * 256];
+	std::fill(std::begin(full), std::end(full), 0xFFFF);
+	ASSERT_EQ((Oversampling<2, 256>::reduce(full, 512)), 2);
+	ASSERT_EQ(full[0], 0xFFFF);
+	ASSERT_EQ(full[1], 0xFFFF);
+}
+
+// Tests copying and destruction of captures stored inside of the function object
+TEST(UtilsTest, InplaceFunction)
+{
+	using Function = InplaceFunction<int (int), 4 * sizeof(void *)>;
+
+	auto counter = std::make_shared<int>(10);
+	Function empty;
+	ASSERT_FALSE(empty);
+	ASSERT_TRUE(empty == nullptr);
+
+	{
+		Function add{[counter](int aValue) { return *counter + aValue; }};
+		ASSERT_TRUE(add != nullptr);
+		ASSERT_EQ(counter.use_count(), 2);
+		ASSERT_EQ(add(5), 15);
+
+		Function copy{add};
+		ASSERT_EQ(counter.use_count(), 3);
+		ASSERT_EQ(copy(1), 11);
+
+		empty = copy;
+		ASSERT_EQ(counter.use_count(), 4);
+
+		copy = [](int aValue) { return -aValue; };
+		ASSERT_EQ(counter.use_count(), 3);
+		ASSERT_EQ(copy(7), -7);
+
+		add = nullptr;
+		ASSERT_FALSE(add);
+		ASSERT_EQ(counter.use_count(), 2);
+	}
+
+	ASSERT_EQ(empty(0), 10);
+	empty = empty;
+	ASSERT_EQ(counter.use_count(), 2);
+
+	// Moved captures are not copied and the source is left empty
+	Function moved{std::move(empty)};
+	ASSERT_FALSE(empty);
+	ASSERT_EQ(counter.use_count(), 2);
+	ASSERT_EQ(moved(1), 11);
+	empty = std::move(moved);
+	ASSERT_FALSE(moved);
+	ASSERT_EQ(counter.use_count(), 2);
+
+	empty = nullptr;
+	ASSERT_EQ(counter.use_count(), 1);
+
+	// Plain functions are supported too
+	Function negate{static_cast<int (*)(int)>([](int aValue) { return -aValue; })};
+	ASSERT_EQ(negate(3), -3);
+}
+
+// Tests the order of tasks with different priorities
+TEST(UtilsTest, TaskQueue)
+{
+	using Task = InplaceFunction<void ()>;
+
+	TaskQueue<Task, 4, 3> queue;
+	std::vector<int> order;
+	Task task;
+
+	ASSERT_TRUE(queue.empty());
+	ASSERT_FALSE(queue.pop(task));
+
+	for (int i = 0; i < 4; ++i) {
+		ASSERT_TRUE(queue.push([i, &order]() { order.push_back(20 + i); }, 2));
+	}
+	ASSERT_TRUE(queue.full(2));
+	ASSERT_FALSE(queue.push([]() {}, 2));
+	ASSERT_TRUE(queue.push([&order]() { order.push_back(10); }, 1));
+
+	// Higher priority tasks added during the execution are taken first
+	while (queue.pop(task)) {
+		task();
+
+		if (order.size() == 2) {
+			ASSERT_TRUE(queue.push([&order]() { order.push_back(0); }, 0));
+			ASSERT_TRUE(queue.push([&order]() { order.push_back(11); }, 1));
+		}
+	}
+
+	ASSERT_TRUE(queue.empty());
+	ASSERT_EQ(order, (std::vector<int>{10, 20, 0, 11, 21, 22, 23}));
+
+	// Captures are released when tasks are removed from the queue
+	auto resource = std::make_shared<int>(0);
+
+	queue.push([resource]() {}, 0);
+	ASSERT_EQ(resource.use_count(), 2);
+	queue.pop(task);
+	task = nullptr;
+	ASSERT_EQ(resource.use_count(), 1);
+}
+
 // Tests reading of default values from generic volatile fields
 TEST(UtilsTest, RequestPool)
 {
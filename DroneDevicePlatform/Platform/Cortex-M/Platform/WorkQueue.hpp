@@ -8,42 +8,80 @@
 #ifndef PLATFORM_CORTEX_M_WORKQUEUE_HPP_
 #define PLATFORM_CORTEX_M_WORKQUEUE_HPP_
 
-#include "Irq.hpp"
-#include <DroneDevice/Queue.hpp>
+#include <DroneDevice/InplaceFunction.hpp>
+#include <DroneDevice/TaskQueue.hpp>
+#include <Platform/AsmHelpers.hpp>
+#include <Platform/Irq.hpp>
 #include <cassert>
+#include <chrono>
 #include <functional>
 
-template<size_t size>
+//!
+//! Placeholder for work queues without timers.
+//!
+struct NoTimers {
+	std::chrono::microseconds poll()
+	{
+		return std::chrono::microseconds::max();
+	}
+
+	void scheduleWakeUp() const
+	{
+	}
+};
+
+//!
+//! Queue of tasks executed in the main loop.
+//! \tparam size Capacity of the queue of each priority, the total number of pending tasks is size * priorities.
+//! \tparam Timers Timer wheel polled before the tasks, expired timers are handled in the main loop too.
+//! The core sleeps until the earliest deadline when there are no tasks.
+//! \tparam priorities Number of priority levels, zero is the highest priority.
+//! \tparam taskSize Size of the storage for captures of a task, tasks never allocate memory.
+//! Tasks run to completion, the queue is checked for tasks with higher priority after each task,
+//! so the latency of a task is bounded by the longest task with lower priority.
+//!
+template<size_t size, class Timers = NoTimers, size_t priorities = 1, size_t taskSize = 4 * sizeof(void *)>
 class WorkQueue {
 public:
+	using Task = InplaceFunction<void (), taskSize>;
+
 	WorkQueue(std::function<void ()> aIdleTask = nullptr) :
 		idle{aIdleTask}
 	{
 	}
 
-	bool add(std::function<void ()> aTask)
+	Timers &timers()
 	{
-		bool result = false;
-		irqDisable();
+		return wheel;
+	}
 
-		if (!tasks.full()) {
-			tasks.push(aTask);
-			result = true;
-		}
+	//!
+	//! Add the task to the queue, the function may be called from interrupts.
+	//! \param task Task to be executed in the main loop.
+	//! \param priority Priority of the task, the lowest priority is used by default.
+	//! \return True when the task was added.
+	//!
+	bool add(const Task &aTask, size_t aPriority = priorities - 1)
+	{
+		const IrqState state = irqSave();
+		const bool result = tasks.push(aTask, aPriority);
 
-		irqEnable();
+		irqRestore(state);
 		return result;
 	}
 
 	void run()
 	{
 		while (true) {
+			wheel.poll();
+
 #ifdef NDEBUG
 			if (idle != nullptr) {
 				idle();
 			} else {
 				irqDisable();
 				if (tasks.empty()) {
+					wheel.scheduleWakeUp();
 					sleep();
 				}
 				irqEnable();
@@ -58,19 +96,27 @@ public:
 			}
 #endif
 
-			while (!tasks.empty()) {
+			Task task;
+
+			while (true) {
 				irqDisable();
-				auto task = tasks.pop();
+				const bool ready = tasks.pop(task);
 				irqEnable();
 
+				if (!ready) {
+					break;
+				}
+
 				task();
+				task = nullptr;
 			}
 		}
 	}
 
 private:
-	Queue<std::function<void ()>, size> tasks;
+	TaskQueue<Task, size, priorities> tasks;
 	std::function<void ()> idle;
+	Timers wheel;
 };
 
 #endif // PLATFORM_CORTEX_M_WORKQUEUE_HPP_
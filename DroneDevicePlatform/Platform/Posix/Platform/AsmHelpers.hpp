@@ -0,0 +1,42 @@
+//
+// AsmHelpers.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_POSIX_ASMHELPERS_HPP_
+#define PLATFORM_POSIX_ASMHELPERS_HPP_
+
+#include "IrqThread.hpp"
+#include <unistd.h>
+#include <cstdint>
+
+#define barrier() __asm__ volatile ("" : : : "memory")
+
+//!
+//! Counterpart of WFI, overloads sleep(unsigned int) of the C library.
+//!
+static inline void sleep()
+{
+	IrqThread::waitForInterrupt();
+}
+
+static inline uint32_t countTrailingZeros32(uint32_t value)
+{
+	return static_cast<uint32_t>(__builtin_ctz(value));
+}
+
+static inline uint32_t countLeadingZeros32(uint32_t value)
+{
+	return static_cast<uint32_t>(__builtin_clz(value));
+}
+
+static inline uint32_t reverseBits32(uint32_t value)
+{
+	value = ((value >> 1) & 0x55555555UL) | ((value & 0x55555555UL) << 1);
+	value = ((value >> 2) & 0x33333333UL) | ((value & 0x33333333UL) << 2);
+	value = ((value >> 4) & 0x0F0F0F0FUL) | ((value & 0x0F0F0F0FUL) << 4);
+	return __builtin_bswap32(value);
+}
+
+#endif // PLATFORM_POSIX_ASMHELPERS_HPP_
@@ -0,0 +1,235 @@
+//
+// Can.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_POSIX_CAN_HPP_
+#define PLATFORM_POSIX_CAN_HPP_
+
+#include "Irq.hpp"
+#include "IrqThread.hpp"
+#include "LocalTime.hpp"
+#include <DroneDevice/Can.hpp>
+#include <DroneDevice/Queue.hpp>
+#include <fcntl.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <socketcan.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+//!
+//! CAN interface over SocketCAN, virtual interfaces (vcan) connect several processes into one bus.
+//! The interface name is taken from the CAN<number> environment variable, vcan<number - 1> by default.
+//! The bit rate is configured on the host, the interface template is compatible with the STM32 version.
+//!
+template<unsigned int number, size_t rxSize, size_t txSize, unsigned int tseg1 = 0, unsigned int tseg2 = 0,
+	typename Time = LocalTime>
+class Can {
+protected:
+	Queue<CanMessage, rxSize> rxQueue;
+	Queue<CanMessage, txSize> txQueue;
+	std::function<void ()> callback;
+	CanStatistics stats;
+	SocketCANInstance socket;
+
+public:
+	Can(uint32_t /*aRate*/, std::function<void ()> aCallback = nullptr) :
+		rxQueue{},
+		txQueue{},
+		callback{aCallback},
+		stats{},
+		socket{-1}
+	{
+		const char * const name = interfaceName();
+
+		if (socketcanInit(&socket, name) < 0) {
+			fprintf(stderr, "CAN%u: interface %s is not available\n", number, name);
+			socket.fd = -1;
+			return;
+		}
+
+		fcntl(socket.fd, F_SETFL, fcntl(socket.fd, F_GETFL) | O_NONBLOCK);
+		IrqThread::attach(socket.fd, POLLIN, [this](short aEvents) { handler(aEvents); });
+	}
+
+	Can(const Can &) = delete;
+	Can &operator=(const Can &) = delete;
+
+	~Can()
+	{
+		if (isOpen()) {
+			IrqThread::detach(socket.fd);
+			socketcanClose(&socket);
+		}
+	}
+
+	bool isOpen() const
+	{
+		return socket.fd >= 0;
+	}
+
+	CanStatistics getStatistics() const
+	{
+		return stats;
+	}
+
+	void setCallback(std::function<void ()> aCallback)
+	{
+		callback = aCallback;
+	}
+
+	void setFilters(const CanFilter *aFilters, size_t aCount)
+	{
+		if (!isOpen() || !aCount) {
+			return;
+		}
+
+		std::vector<can_filter> filters(aCount);
+
+		// Masks of STM32 filters do not include the frame format, extended frames are selected by width
+		for (size_t i = 0; i < aCount; ++i) {
+			filters[i].can_id = aFilters[i].id | (aFilters[i].id > CAN_SFF_MASK ? CAN_EFF_FLAG : 0);
+			filters[i].can_mask = aFilters[i].mask;
+		}
+
+		setsockopt(socket.fd, SOL_CAN_RAW, CAN_RAW_FILTER, filters.data(),
+			static_cast<socklen_t>(filters.size() * sizeof(can_filter)));
+	}
+
+	size_t read(CanMessage *aBuffer, size_t aLength)
+	{
+		const IrqState state = irqSave();
+		const size_t initialLength = aLength;
+
+		while (!rxQueue.empty() && aLength) {
+			*aBuffer++ = rxQueue.pop();
+			--aLength;
+		}
+
+		irqRestore(state);
+		return initialLength - aLength;
+	}
+
+	size_t write(const CanMessage *aBuffer, size_t aLength)
+	{
+		if (!isOpen()) {
+			return 0;
+		}
+
+		const IrqState state = irqSave();
+		const size_t initialLength = aLength;
+
+		// Messages are queued only when the socket buffer is full
+		while (txQueue.empty() && aLength && transmit(*aBuffer)) {
+			++aBuffer;
+			--aLength;
+		}
+
+		while (!txQueue.full() && aLength) {
+			txQueue.push(*aBuffer++);
+			--aLength;
+		}
+
+		if (!txQueue.empty()) {
+			IrqThread::modify(socket.fd, POLLIN | POLLOUT);
+		}
+
+		irqRestore(state);
+		return initialLength - aLength;
+	}
+
+protected:
+	void handler(short aEvents)
+	{
+		if (aEvents & POLLIN) {
+			CanardCANFrame frame;
+			bool received = false;
+
+			while (socketcanReceive(&socket, &frame, 0) > 0) {
+				if (frame.id & CANARD_CAN_FRAME_ERR) {
+					++stats.errors;
+					continue;
+				}
+
+				CanMessage message;
+
+				message.timestamp = static_cast<uint64_t>(Time::microseconds().count());
+				message.id = frame.id & CANARD_CAN_EXT_ID_MASK;
+				message.flags = static_cast<uint8_t>(((frame.id & CANARD_CAN_FRAME_EFF) ? CanMessage::EXT : 0)
+					| ((frame.id & CANARD_CAN_FRAME_RTR) ? CanMessage::RTR : 0));
+				message.length = frame.data_len;
+				std::copy(frame.data, frame.data + frame.data_len, message.data);
+
+				if (!rxQueue.full()) {
+					rxQueue.push(message);
+					++stats.rx;
+					received = true;
+				} else {
+					++stats.errors;
+				}
+			}
+
+			if (received && callback != nullptr) {
+				callback();
+			}
+		}
+
+		if (aEvents & POLLOUT) {
+			while (!txQueue.empty() && transmit(txQueue.front())) {
+				txQueue.pop();
+			}
+
+			if (txQueue.empty()) {
+				IrqThread::modify(socket.fd, POLLIN);
+			}
+		}
+
+		if (aEvents & (POLLERR | POLLHUP)) {
+			++stats.errors;
+		}
+	}
+
+private:
+	static const char *interfaceName()
+	{
+		static char name[16];
+
+		snprintf(name, sizeof(name), "CAN%u", number);
+
+		const char * const variable = getenv(name);
+
+		if (variable != nullptr) {
+			return variable;
+		}
+
+		snprintf(name, sizeof(name), "vcan%u", number - 1);
+		return name;
+	}
+
+	bool transmit(const CanMessage &aMessage)
+	{
+		CanardCANFrame frame;
+
+		frame.id = aMessage.id
+			| ((aMessage.flags & CanMessage::EXT) ? CANARD_CAN_FRAME_EFF : 0)
+			| ((aMessage.flags & CanMessage::RTR) ? CANARD_CAN_FRAME_RTR : 0);
+		frame.data_len = aMessage.length;
+		std::copy(aMessage.data, aMessage.data + aMessage.length, frame.data);
+
+		if (socketcanTransmit(&socket, &frame, 0) > 0) {
+			++stats.tx;
+			return true;
+		} else {
+			return false;
+		}
+	}
+};
+
+#endif // PLATFORM_POSIX_CAN_HPP_
@@ -0,0 +1,43 @@
+//
+// Flash.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_POSIX_FLASH_HPP_
+#define PLATFORM_POSIX_FLASH_HPP_
+
+#include <DroneDevice/Stubs/SimFlash.hpp>
+#include <cstdlib>
+
+//!
+//! Internal flash of the host build backed by a file, so the firmware region and
+//! the configuration survive restarts. The file name is taken from the FLASH environment variable,
+//! the memory is kept in RAM when it is not set. Addresses match the STM32 memory map.
+//! \tparam PAGE_SIZE Size of an erase page.
+//! \tparam SIZE Size of the memory.
+//! \tparam BASE Absolute address of the memory.
+//!
+template<size_t PAGE_SIZE, size_t SIZE = 1024 * 1024, uintptr_t BASE = 0x08000000>
+class Flash : public Device::SimFlash<PAGE_SIZE, SIZE / PAGE_SIZE, Device::SimFlashF4, BASE> {
+	using BaseType = Device::SimFlash<PAGE_SIZE, SIZE / PAGE_SIZE, Device::SimFlashF4, BASE>;
+
+public:
+	static constexpr size_t kProgramUnit = Device::SimFlashF4::kUnit;
+
+	Flash() = delete;
+	Flash(const Flash &) = delete;
+	Flash &operator=(const Flash &) = delete;
+
+	//!
+	//! Map the memory to the file from the environment.
+	//! \return True when the memory is backed by a file.
+	//!
+	static bool init()
+	{
+		const char * const path = getenv("FLASH");
+		return path != nullptr && BaseType::open(path);
+	}
+};
+
+#endif // PLATFORM_POSIX_FLASH_HPP_
@@ -0,0 +1,114 @@
+//
+// I2c.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_POSIX_I2C_HPP_
+#define PLATFORM_POSIX_I2C_HPP_
+
+#include <fcntl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+//!
+//! I2C master on the Linux i2c-dev interface, for example a USB adapter or a bus of a single-board computer.
+//! The device is taken from the I2C<number> environment variable, /dev/i2c-<number> by default.
+//! The bus rate is configured on the host.
+//!
+template<unsigned int number>
+class I2c {
+	using Callback = std::function<void (bool)>;
+
+public:
+	I2c(const I2c &) = delete;
+	I2c &operator=(const I2c &) = delete;
+
+	I2c(uint32_t /*aRate*/, Callback aCallback = nullptr) :
+		callback{aCallback},
+		descriptor{-1}
+	{
+		reset();
+	}
+
+	~I2c()
+	{
+		if (descriptor >= 0) {
+			close(descriptor);
+		}
+	}
+
+	void setCallback(Callback aCallback)
+	{
+		callback = aCallback;
+	}
+
+	//!
+	//! Reopen the device.
+	//!
+	void reset()
+	{
+		char path[32];
+		const char *name = getenv(variable());
+
+		if (name == nullptr) {
+			snprintf(path, sizeof(path), "/dev/i2c-%u", number);
+			name = path;
+		}
+
+		if (descriptor >= 0) {
+			close(descriptor);
+		}
+		descriptor = open(name, O_RDWR);
+	}
+
+	bool send(const uint8_t aAddr, const void *aTxData, size_t aTxSize)
+	{
+		return exchange(aAddr, aTxData, aTxSize, nullptr, 0);
+	}
+
+	//!
+	//! Write and read data in one combined transaction with a repeated start condition.
+	//!
+	bool exchange(const uint8_t aAddr, const void *aTxData, size_t aTxSize, void *aRxBuf, size_t aRxSize)
+	{
+		i2c_msg messages[2];
+		i2c_rdwr_ioctl_data transaction{messages, 0};
+
+		if (aTxSize) {
+			messages[transaction.nmsgs++] = i2c_msg{aAddr, 0, static_cast<__u16>(aTxSize),
+				static_cast<__u8 *>(const_cast<void *>(aTxData))};
+		}
+		if (aRxSize) {
+			messages[transaction.nmsgs++] = i2c_msg{aAddr, I2C_M_RD, static_cast<__u16>(aRxSize),
+				static_cast<__u8 *>(aRxBuf)};
+		}
+
+		const bool result = descriptor >= 0 && transaction.nmsgs > 0 && ioctl(descriptor, I2C_RDWR, &transaction) >= 0;
+
+		if (callback != nullptr) {
+			callback(result);
+		}
+
+		return result;
+	}
+
+private:
+	Callback callback;
+	int descriptor;
+
+	static const char *variable()
+	{
+		static char name[16];
+
+		snprintf(name, sizeof(name), "I2C%u", number);
+		return name;
+	}
+};
+
+#endif // PLATFORM_POSIX_I2C_HPP_
@@ -0,0 +1,37 @@
+//
+// Irq.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_POSIX_IRQ_HPP_
+#define PLATFORM_POSIX_IRQ_HPP_
+
+#include "IrqThread.hpp"
+#include <cstdint>
+
+//! Interrupts are masked by holding the lock of IrqThread, nested sections only count the depth.
+using IrqState = uint32_t;
+
+static inline void irqDisable()
+{
+	IrqThread::lock();
+}
+
+static inline void irqEnable()
+{
+	IrqThread::unlock();
+}
+
+static inline IrqState irqSave()
+{
+	IrqThread::lock();
+	return 0;
+}
+
+static inline void irqRestore(IrqState)
+{
+	IrqThread::unlock();
+}
+
+#endif // PLATFORM_POSIX_IRQ_HPP_
@@ -0,0 +1,233 @@
+//
+// IrqThread.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "IrqThread.hpp"
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Entry {
+	int fd;
+	short events;
+	IrqThread::Handler handler;
+};
+
+//!
+//! Interrupt lock is a plain mutex with the owner and the nesting depth tracked separately,
+//! so that the wait releases the mutex completely even inside nested critical sections.
+//!
+struct Context {
+	std::mutex mutex;
+	std::condition_variable event;
+	std::atomic<std::thread::id> owner{};
+	unsigned int depth{0};
+	std::vector<Entry> entries;
+	std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()};
+	bool pending{false};
+	bool started{false};
+	int wakeup[2]{-1, -1};
+};
+
+// Context is never destroyed, the detached thread may use it until the process exits
+Context &context()
+{
+	static Context * const object = new Context;
+	return *object;
+}
+
+// Critical section of internal functions, nested into the sections of callers and handlers
+class Guard {
+public:
+	Guard()
+	{
+		IrqThread::lock();
+	}
+
+	~Guard()
+	{
+		IrqThread::unlock();
+	}
+
+	Guard(const Guard &) = delete;
+	Guard &operator=(const Guard &) = delete;
+};
+
+// Interrupt the poll call, so that the thread picks up changes of descriptors
+void notifyThread(Context &aContext)
+{
+	if (aContext.wakeup[1] >= 0) {
+		const uint8_t value = 0;
+		(void)!write(aContext.wakeup[1], &value, sizeof(value));
+	}
+}
+
+void threadLoop()
+{
+	Context &current = context();
+	std::vector<pollfd> fds;
+
+	for (;;) {
+		{
+			Guard guard;
+
+			fds.clear();
+			fds.push_back(pollfd{current.wakeup[0], POLLIN, 0});
+			for (const auto &entry : current.entries) {
+				fds.push_back(pollfd{entry.fd, entry.events, 0});
+			}
+		}
+
+		if (poll(fds.data(), fds.size(), -1) <= 0) {
+			continue;
+		}
+
+		if (fds[0].revents & POLLIN) {
+			uint8_t buffer[64];
+			while (read(current.wakeup[0], buffer, sizeof(buffer)) > 0);
+		}
+
+		Guard guard;
+
+		for (size_t i = 1; i < fds.size(); ++i) {
+			if (!fds[i].revents) {
+				continue;
+			}
+
+			// Descriptor could be detached while the thread was polling
+			const auto iter = std::find_if(current.entries.begin(), current.entries.end(),
+				[&fds, i](const Entry &aEntry) { return aEntry.fd == fds[i].fd; });
+
+			if (iter != current.entries.end()) {
+				const IrqThread::Handler handler = iter->handler;
+
+				handler(fds[i].revents);
+				current.pending = true;
+			}
+		}
+
+		current.event.notify_all();
+	}
+}
+
+} // namespace
+
+void IrqThread::attach(int aFd, short aEvents, Handler aHandler)
+{
+	Context &current = context();
+	Guard guard;
+
+	if (!current.started) {
+		if (pipe(current.wakeup) == 0) {
+			fcntl(current.wakeup[0], F_SETFL, O_NONBLOCK);
+			fcntl(current.wakeup[1], F_SETFL, O_NONBLOCK);
+		}
+
+		std::thread{threadLoop}.detach();
+		current.started = true;
+	}
+
+	current.entries.push_back(Entry{aFd, aEvents, aHandler});
+	notifyThread(current);
+}
+
+void IrqThread::modify(int aFd, short aEvents)
+{
+	Context &current = context();
+	Guard guard;
+
+	for (auto &entry : current.entries) {
+		if (entry.fd == aFd && entry.events != aEvents) {
+			entry.events = aEvents;
+			notifyThread(current);
+		}
+	}
+}
+
+void IrqThread::detach(int aFd)
+{
+	Context &current = context();
+	Guard guard;
+
+	current.entries.erase(std::remove_if(current.entries.begin(), current.entries.end(),
+		[aFd](const Entry &aEntry) { return aEntry.fd == aFd; }), current.entries.end());
+	notifyThread(current);
+}
+
+void IrqThread::lock()
+{
+	Context &current = context();
+	const std::thread::id self = std::this_thread::get_id();
+
+	// Nested sections of the owner only count the depth
+	if (current.owner.load(std::memory_order_relaxed) != self) {
+		current.mutex.lock();
+		current.owner.store(self, std::memory_order_relaxed);
+	}
+
+	++current.depth;
+}
+
+void IrqThread::unlock()
+{
+	Context &current = context();
+
+	if (--current.depth == 0) {
+		current.owner.store(std::thread::id{}, std::memory_order_relaxed);
+		current.mutex.unlock();
+	}
+}
+
+void IrqThread::waitForInterrupt()
+{
+	Context &current = context();
+
+	if (!current.pending) {
+		// Mutex is held by the caller, the wait releases it regardless of the nesting depth
+		std::unique_lock<std::mutex> guard{current.mutex, std::adopt_lock};
+		const unsigned int depth = current.depth;
+
+		current.depth = 0;
+		current.owner.store(std::thread::id{}, std::memory_order_relaxed);
+
+		if (current.deadline == std::chrono::steady_clock::time_point::max()) {
+			current.event.wait(guard, [&current]() { return current.pending; });
+		} else {
+			current.event.wait_until(guard, current.deadline, [&current]() { return current.pending; });
+		}
+
+		current.owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+		current.depth = depth;
+		guard.release();
+	}
+
+	current.pending = false;
+	current.deadline = std::chrono::steady_clock::time_point::max();
+}
+
+void IrqThread::wakeAt(std::chrono::steady_clock::time_point aDeadline)
+{
+	Context &current = context();
+	Guard guard;
+
+	current.deadline = std::min(current.deadline, aDeadline);
+}
+
+void IrqThread::raise()
+{
+	Context &current = context();
+	Guard guard;
+
+	current.pending = true;
+	current.event.notify_all();
+}
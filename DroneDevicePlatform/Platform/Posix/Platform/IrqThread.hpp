@@ -0,0 +1,68 @@
+//
+// IrqThread.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_POSIX_IRQTHREAD_HPP_
+#define PLATFORM_POSIX_IRQTHREAD_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+//!
+//! Emulation of the interrupt controller. Peripherals attach file descriptors with handlers,
+//! a single thread polls the descriptors and calls handlers with the global interrupt lock held,
+//! so handlers are atomic relative to critical sections of the main thread just like interrupts.
+//! Each handler call is an interrupt which wakes up the main thread sleeping in sleep().
+//!
+class IrqThread {
+public:
+	//! Handler of poll events of the descriptor.
+	using Handler = std::function<void (short)>;
+
+	IrqThread() = delete;
+	IrqThread(const IrqThread &) = delete;
+	IrqThread &operator=(const IrqThread &) = delete;
+
+	//!
+	//! Start polling the descriptor, the thread is started with the first descriptor.
+	//! \param fd Descriptor in non-blocking mode.
+	//! \param events Poll events, for example POLLIN.
+	//! \param handler Handler called in the interrupt context.
+	//!
+	static void attach(int aFd, short aEvents, Handler aHandler);
+
+	//!
+	//! Change poll events of the attached descriptor, may be called from handlers.
+	//!
+	static void modify(int aFd, short aEvents);
+
+	//!
+	//! Stop polling the descriptor, the handler is not called after the function returns.
+	//!
+	static void detach(int aFd);
+
+	static void lock();
+	static void unlock();
+
+	//!
+	//! Wait for an interrupt or for the deadline set with wakeAt(), should be called
+	//! with the interrupt lock held, the lock is released while waiting.
+	//!
+	static void waitForInterrupt();
+
+	//!
+	//! Limit the next wait, the limit is cleared when the wait ends.
+	//! \param deadline Time point of the monotonic clock.
+	//!
+	static void wakeAt(std::chrono::steady_clock::time_point aDeadline);
+
+	//!
+	//! Mark an interrupt as pending, for example after a software event.
+	//!
+	static void raise();
+};
+
+#endif // PLATFORM_POSIX_IRQTHREAD_HPP_
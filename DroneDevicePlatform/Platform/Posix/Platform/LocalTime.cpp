@@ -0,0 +1,24 @@
+//
+// LocalTime.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "LocalTime.hpp"
+#include <thread>
+
+std::chrono::steady_clock::time_point LocalTime::origin = std::chrono::steady_clock::now();
+
+void LocalTime::init()
+{
+	origin = std::chrono::steady_clock::now();
+}
+
+void LocalTime::deinit()
+{
+}
+
+void LocalTime::delay(std::chrono::microseconds aValue)
+{
+	std::this_thread::sleep_for(aValue);
+}
@@ -0,0 +1,63 @@
+//
+// LocalTime.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_POSIX_LOCALTIME_HPP_
+#define PLATFORM_POSIX_LOCALTIME_HPP_
+
+#include "IrqThread.hpp"
+#include <chrono>
+#include <cstdint>
+
+//!
+//! Time since the initialization based on the monotonic clock of the host.
+//! The interface is compatible with the Cortex-M version, delays put the thread to sleep.
+//!
+class LocalTime {
+public:
+	LocalTime() = delete;
+	LocalTime(const LocalTime &) = delete;
+	LocalTime &operator=(const LocalTime &) = delete;
+
+	static void init();
+	static void deinit();
+
+	static std::chrono::microseconds microseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - origin);
+	}
+
+	static std::chrono::milliseconds milliseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(microseconds());
+	}
+
+	static std::chrono::seconds seconds()
+	{
+		return std::chrono::duration_cast<std::chrono::seconds>(microseconds());
+	}
+
+	//!
+	//! Limit the next sleep of the main loop, there is no periodic tick to wake it up.
+	//! \param deadline Time since the initialization, values beyond the range of the host clock,
+	//! including microseconds::max() for an empty timer wheel, leave the sleep unlimited.
+	//!
+	static void wakeAt(std::chrono::microseconds aDeadline)
+	{
+		const auto limit = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::time_point::max() - origin);
+
+		if (aDeadline < limit) {
+			IrqThread::wakeAt(origin + aDeadline);
+		}
+	}
+
+	static void delay(std::chrono::microseconds aValue);
+
+private:
+	static std::chrono::steady_clock::time_point origin;
+};
+
+#endif // PLATFORM_POSIX_LOCALTIME_HPP_
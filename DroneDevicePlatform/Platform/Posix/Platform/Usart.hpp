@@ -0,0 +1,220 @@
+//
+// Usart.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_POSIX_USART_HPP_
+#define PLATFORM_POSIX_USART_HPP_
+
+#include "Irq.hpp"
+#include "IrqThread.hpp"
+#include <DroneDevice/Queue.hpp>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#include <cstdio>
+#include <functional>
+
+enum class UsartParityType : uint8_t {
+	None,
+	Even,
+	Odd
+};
+
+//!
+//! Serial port on a pseudo-terminal, host tools open the slave side like a USB-UART adapter.
+//! The name of the slave device is printed on startup, a symbolic link with a stable name is created
+//! when the USART<number> environment variable is set. Line settings do not affect the pseudo-terminal.
+//!
+template<unsigned int number, size_t rxSize, size_t txSize>
+class Usart {
+protected:
+	Queue<uint8_t, rxSize> rxQueue;
+	Queue<uint8_t, txSize> txQueue;
+	std::function<void ()> callback;
+	int master;
+	int slave;
+	uint8_t chunk[64]; //!< Data taken from the queue and not yet accepted by the terminal
+	size_t chunkOffset;
+	size_t chunkLength;
+
+public:
+	Usart(uint32_t /*aRate*/, std::function<void ()> aCallback = nullptr) :
+		rxQueue{},
+		txQueue{},
+		callback{aCallback},
+		master{-1},
+		slave{-1},
+		chunk{},
+		chunkOffset{0},
+		chunkLength{0}
+	{
+		master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+		if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+			fprintf(stderr, "USART%u: pseudo-terminal is not available\n", number);
+			close();
+			return;
+		}
+
+		const char *name = ptsname(master);
+
+		// Slave side is kept open, otherwise the master reports hang-up until a client connects
+		slave = ::open(name, O_RDWR | O_NOCTTY);
+		if (slave >= 0) {
+			termios attributes;
+
+			tcgetattr(slave, &attributes);
+			cfmakeraw(&attributes);
+			tcsetattr(slave, TCSANOW, &attributes);
+		}
+
+		char variable[16];
+		snprintf(variable, sizeof(variable), "USART%u", number);
+
+		const char * const link = getenv(variable);
+
+		if (link != nullptr) {
+			unlink(link);
+			if (symlink(name, link) == 0) {
+				name = link;
+			}
+		}
+
+		fprintf(stderr, "USART%u: %s\n", number, name);
+		IrqThread::attach(master, POLLIN, [this](short aEvents) { handler(aEvents); });
+	}
+
+	Usart(const Usart &) = delete;
+	Usart &operator=(const Usart &) = delete;
+
+	~Usart()
+	{
+		if (master >= 0) {
+			IrqThread::detach(master);
+		}
+		close();
+	}
+
+	void setBaudrate(uint32_t)
+	{
+	}
+
+	void setCallback(std::function<void ()> aCallback)
+	{
+		callback = aCallback;
+	}
+
+	void setParity(UsartParityType)
+	{
+	}
+
+	size_t read(void *aBuffer, size_t aLength)
+	{
+		uint8_t *buffer = static_cast<uint8_t *>(aBuffer);
+		const IrqState state = irqSave();
+
+		while (!rxQueue.empty() && aLength--) {
+			*buffer++ = rxQueue.pop();
+		}
+
+		irqRestore(state);
+		return static_cast<size_t>(buffer - static_cast<uint8_t *>(aBuffer));
+	}
+
+	size_t write(const void *aBuffer, size_t aLength)
+	{
+		if (master < 0) {
+			return 0;
+		}
+
+		const uint8_t *buffer = static_cast<const uint8_t *>(aBuffer);
+		const IrqState state = irqSave();
+
+		while (!txQueue.full() && aLength--) {
+			txQueue.push(*buffer++);
+		}
+		flush();
+
+		irqRestore(state);
+		return static_cast<size_t>(buffer - static_cast<const uint8_t *>(aBuffer));
+	}
+
+	void startLineBreak()
+	{
+	}
+
+	void stopLineBreak()
+	{
+	}
+
+protected:
+	void handler(short aEvents)
+	{
+		if (aEvents & POLLIN) {
+			uint8_t buffer[64];
+			ssize_t count;
+			bool event = false;
+
+			while ((count = ::read(master, buffer, sizeof(buffer))) > 0) {
+				for (ssize_t i = 0; i < count && !rxQueue.full(); ++i) {
+					rxQueue.push(buffer[i]);
+				}
+				event = true;
+			}
+
+			if (event && callback != nullptr) {
+				callback();
+			}
+		}
+
+		if (aEvents & POLLOUT) {
+			flush();
+		}
+	}
+
+private:
+	void close()
+	{
+		if (slave >= 0) {
+			::close(slave);
+			slave = -1;
+		}
+		if (master >= 0) {
+			::close(master);
+			master = -1;
+		}
+	}
+
+	//!
+	//! Move queued data to the pseudo-terminal, the rest is sent when the terminal becomes writable.
+	//!
+	void flush()
+	{
+		for (;;) {
+			if (chunkOffset == chunkLength) {
+				chunkOffset = 0;
+				chunkLength = txQueue.pop(chunk, sizeof(chunk));
+
+				if (!chunkLength) {
+					break;
+				}
+			}
+
+			const ssize_t written = ::write(master, chunk + chunkOffset, chunkLength - chunkOffset);
+
+			if (written <= 0) {
+				break;
+			}
+			chunkOffset += static_cast<size_t>(written);
+		}
+
+		const bool idle = chunkOffset == chunkLength && txQueue.empty();
+		IrqThread::modify(master, static_cast<short>(idle ? POLLIN : POLLIN | POLLOUT));
+	}
+};
+
+#endif // PLATFORM_POSIX_USART_HPP_
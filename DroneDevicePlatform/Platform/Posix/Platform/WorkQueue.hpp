@@ -0,0 +1,13 @@
+//
+// WorkQueue.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_POSIX_WORKQUEUE_HPP_
+#define PLATFORM_POSIX_WORKQUEUE_HPP_
+
+// Work queue is shared with Cortex-M, interrupt masking and sleep are provided by this platform
+#include "../../Cortex-M/Platform/WorkQueue.hpp"
+
+#endif // PLATFORM_POSIX_WORKQUEUE_HPP_
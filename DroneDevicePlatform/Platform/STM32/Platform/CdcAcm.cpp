@@ -5,8 +5,13 @@
 //      Author: Alexander
 //
 
+#include <libopencm3/cm3/nvic.h>
 #include <libopencm3/usb/dwc/otg_fs.h>
+#include <Platform/Irq.hpp>
 #include "CdcAcm.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 
 const CdcAcmFunctionalDescriptors CdcAcm::kFunctionalDescriptors{};
 
@@ -164,9 +169,9 @@ constexpr CdcAcmFunctionalDescriptors::CdcAcmFunctionalDescriptors() :
 }
 // clang-format on
 
-CdcAcm::CdcAcm() :
-	pending{false}
+CdcAcm::CdcAcm()
 {
+	reset();
 	rcc_periph_clock_enable(RCC_OTGFS);
 
 	device = usbd_init(
@@ -181,6 +186,7 @@ CdcAcm::CdcAcm() :
 
 CdcAcm::~CdcAcm()
 {
+	nvic_disable_irq(NVIC_OTG_FS_IRQ);
 	rcc_periph_clock_disable(RCC_OTGFS);
 }
 
@@ -194,6 +200,12 @@ void CdcAcm::vbusDisable()
 	OTG_FS_GCCFG |= OTG_GCCFG_NOVBUSSENS;
 }
 
+void CdcAcm::enableInterrupt(uint8_t aPriority)
+{
+	nvic_set_priority(NVIC_OTG_FS_IRQ, aPriority);
+	nvic_enable_irq(NVIC_OTG_FS_IRQ);
+}
+
 usbd_request_return_codes CdcAcm::handleControlRequest(usbd_device *,
 	usb_setup_data *aRequest, uint8_t **, uint16_t *aLength, void (**)(usbd_device *, usb_setup_data *))
 {
@@ -219,13 +231,33 @@ usbd_request_return_codes CdcAcm::handleControlRequest(usbd_device *,
 void CdcAcm::handleDataRxCallback(usbd_device *, uint8_t)
 {
 	auto &interface = CdcAcm::instance();
+	const auto used = static_cast<uint8_t>(interface.rxTail - interface.rxHead);
+
+	// Driver enables the endpoint again inside the read, NAK is forced before the read which fills
+	// the last buffer, so the endpoint stays enabled in the NAK state and the host is stopped
+	// until the application frees a buffer
+	if (used >= kRxPackets - 1) {
+		interface.rxBlocked = true;
+		usbd_ep_nak_set(interface.device, kDataRxEp, 1);
+	}
+
+	if (used == kRxPackets) {
+		// Packet is discarded, an empty read enables the endpoint
+		usbd_ep_read_packet(interface.device, kDataRxEp, nullptr, 0);
+		return;
+	}
+
+	Packet &packet = interface.rxPackets[interface.rxTail & (kRxPackets - 1)];
+	const auto bytesRead = usbd_ep_read_packet(interface.device, kDataRxEp, packet.data, sizeof(packet.data));
 
-	uint8_t buffer[64];
-	const auto bytesRead = usbd_ep_read_packet(interface.device, kDataRxEp, buffer, sizeof(buffer));
+	if (!bytesRead) {
+		return;
+	}
 
-	interface.rxQueue.push(buffer, bytesRead);
+	packet.length = static_cast<uint8_t>(bytesRead);
+	interface.rxTail = static_cast<uint8_t>(interface.rxTail + 1);
 
-	if (!interface.rxQueue.empty() && interface.callback != nullptr) {
+	if (interface.callback != nullptr) {
 		interface.callback();
 	}
 }
@@ -234,21 +266,18 @@ void CdcAcm::handleDataTxCallback(usbd_device *, uint8_t)
 {
 	auto &interface = CdcAcm::instance();
 
-	if (!interface.txQueue.empty()) {
-		uint8_t buffer[64];
-		const auto bytesToWrite = interface.txQueue.pop(buffer, sizeof(buffer));
-
-		usbd_ep_write_packet(interface.device, kDataTxEp, buffer, static_cast<uint16_t>(bytesToWrite));
-		interface.pending = true;
-	} else {
-		interface.pending = false;
+	if (interface.txState == TxState::Data) {
+		interface.txFull = interface.txPackets[interface.txHead & (kTxPackets - 1)].length == kPacketSize;
+		interface.txHead = static_cast<uint8_t>(interface.txHead + 1);
 	}
+
+	interface.transmit();
 }
 
 void CdcAcm::setInterfaceConfig(usbd_device *aDevice, uint16_t)
 {
-	usbd_ep_setup(aDevice, kDataRxEp, USB_ENDPOINT_ATTR_BULK, 64, handleDataRxCallback);
-	usbd_ep_setup(aDevice, kDataTxEp, USB_ENDPOINT_ATTR_BULK, 64, handleDataTxCallback);
+	usbd_ep_setup(aDevice, kDataRxEp, USB_ENDPOINT_ATTR_BULK, kPacketSize, handleDataRxCallback);
+	usbd_ep_setup(aDevice, kDataTxEp, USB_ENDPOINT_ATTR_BULK, kPacketSize, handleDataTxCallback);
 	usbd_ep_setup(aDevice, kNotificationEp, USB_ENDPOINT_ATTR_INTERRUPT, 16, nullptr);
 
 	usbd_register_control_callback(
@@ -257,21 +286,142 @@ void CdcAcm::setInterfaceConfig(usbd_device *aDevice, uint16_t)
 		USB_REQ_TYPE_TYPE | USB_REQ_TYPE_RECIPIENT,
 		handleControlRequest);
 
-	CdcAcm::instance().pending = false;
+	CdcAcm::instance().reset();
+}
+
+void CdcAcm::reset()
+{
+	rxHead = 0;
+	rxTail = 0;
+	rxBlocked = false;
+	rxOffset = 0;
+
+	txHead = 0;
+	txTail = 0;
+	txState = TxState::Idle;
+	txFull = false;
+}
+
+void CdcAcm::transmit()
+{
+	if (txHead != txTail) {
+		const Packet &packet = txPackets[txHead & (kTxPackets - 1)];
+
+		usbd_ep_write_packet(device, kDataTxEp, packet.data, packet.length);
+		txState = TxState::Data;
+	} else if (txFull) {
+		// Host waits for the end of a transfer consisting of full packets
+		usbd_ep_write_packet(device, kDataTxEp, nullptr, 0);
+		txState = TxState::ZeroLength;
+		txFull = false;
+	} else {
+		txState = TxState::Idle;
+	}
+}
+
+size_t CdcAcm::peek(const uint8_t **aData)
+{
+	if (rxHead == rxTail) {
+		return 0;
+	}
+
+	const Packet &packet = rxPackets[rxHead & (kRxPackets - 1)];
+
+	*aData = packet.data + rxOffset;
+	return packet.length - rxOffset;
+}
+
+void CdcAcm::release()
+{
+	assert(rxHead != rxTail);
+
+	rxOffset = 0;
+	rxHead = static_cast<uint8_t>(rxHead + 1);
+
+	if (rxBlocked) {
+		const IrqState state = irqSave();
+
+		rxBlocked = false;
+		usbd_ep_nak_set(device, kDataRxEp, 0);
+		irqRestore(state);
+	}
 }
 
 size_t CdcAcm::read(void *aBuffer, size_t aLength)
 {
-	return rxQueue.pop(static_cast<uint8_t *>(aBuffer), aLength);
+	uint8_t * const buffer = static_cast<uint8_t *>(aBuffer);
+	size_t bytesRead = 0;
+
+	while (bytesRead < aLength) {
+		const uint8_t *data;
+		const size_t available = peek(&data);
+
+		if (!available) {
+			break;
+		}
+
+		const size_t chunk = std::min(available, aLength - bytesRead);
+
+		memcpy(buffer + bytesRead, data, chunk);
+		bytesRead += chunk;
+
+		if (chunk == available) {
+			release();
+		} else {
+			rxOffset = static_cast<uint8_t>(rxOffset + chunk);
+		}
+	}
+
+	return bytesRead;
 }
 
 size_t CdcAcm::write(const void *aBuffer, size_t aLength)
 {
-	const auto bytesWritten = txQueue.push(static_cast<const uint8_t *>(aBuffer), aLength);
+	const uint8_t * const buffer = static_cast<const uint8_t *>(aBuffer);
+	size_t bytesWritten = 0;
+	const IrqState state = irqSave();
+
+	while (bytesWritten < aLength) {
+		const uint8_t used = static_cast<uint8_t>(txTail - txHead);
+		Packet *packet = nullptr;
 
-	if (bytesWritten && !pending) {
-		handleDataTxCallback(device, kDataTxEp);
+		// Data is appended to the last packet unless the packet is being transmitted
+		if (used && !(used == 1 && txState == TxState::Data)) {
+			packet = &txPackets[(txTail - 1) & (kTxPackets - 1)];
+
+			if (packet->length == kPacketSize) {
+				packet = nullptr;
+			}
+		}
+
+		if (packet == nullptr) {
+			if (used == kTxPackets) {
+				break;
+			}
+
+			packet = &txPackets[txTail & (kTxPackets - 1)];
+			packet->length = 0;
+			txTail = static_cast<uint8_t>(txTail + 1);
+		}
+
+		const size_t chunk = std::min(kPacketSize - packet->length, aLength - bytesWritten);
+
+		memcpy(packet->data + packet->length, buffer + bytesWritten, chunk);
+		packet->length = static_cast<uint8_t>(packet->length + chunk);
+		bytesWritten += chunk;
+	}
+
+	if (txState == TxState::Idle) {
+		transmit();
 	}
 
+	irqRestore(state);
 	return bytesWritten;
 }
+
+#ifdef CONFIG_CDCACM_IRQ
+void otg_fs_isr()
+{
+	CdcAcm::instance().update();
+}
+#endif
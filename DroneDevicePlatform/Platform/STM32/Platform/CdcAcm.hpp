@@ -13,7 +13,6 @@
 #include <libopencm3/stm32/rcc.h>
 #include <libopencm3/usb/usbd.h>
 #include <libopencm3/usb/cdc.h>
-#include <DroneDevice/Queue.hpp>
 
 struct CdcAcmFunctionalDescriptors {
 	usb_cdc_header_descriptor header;
@@ -28,18 +27,51 @@ class CdcAcmBase {
 
 };
 
+//!
+//! CDC ACM interface with packet buffers shared between the USB driver and the application.
+//! Received packets are handed to the application without copying and the endpoint is NAKed
+//! while all receive buffers are occupied, so the host is throttled instead of losing data.
+//! Transfers with a length multiple of the packet size are finished with a zero-length packet.
+//! The driver is either polled with update() or serviced in the USB interrupt.
+//!
 class CdcAcm: public CdcAcmBase {
 public:
 	~CdcAcm();
 
+	//!
+	//! Poll the USB device, should not be used after enableInterrupt().
+	//!
 	void update();
 	void vbusDisable();
 
+	//!
+	//! Service the USB device in the interrupt, callbacks are called from the interrupt too.
+	//! The interrupt handler is defined only when the platform is built with USE_CDCACM_IRQ,
+	//! otherwise the application should define otg_fs_isr() which calls update().
+	//! \param priority Interrupt priority.
+	//!
+	void enableInterrupt(uint8_t aPriority);
+
+	//!
+	//! Set a function called when a packet is received.
+	//!
 	void setCallback(std::function<void ()> aCallback)
 	{
 		callback = aCallback;
 	}
 
+	//!
+	//! Get the oldest received packet without copying, the data is valid until release() is called.
+	//! \param data Pointer to the data of the packet.
+	//! \return Length of the packet or zero when there are no packets.
+	//!
+	size_t peek(const uint8_t **aData);
+
+	//!
+	//! Free the packet returned by peek().
+	//!
+	void release();
+
 	size_t read(void *aBuffer, size_t aLength);
 	size_t write(const void *aBuffer, size_t aLength);
 
@@ -51,8 +83,23 @@ public:
 
 private:
 	static constexpr size_t kControlBufferSize{128};
-	static constexpr size_t rxQueueSize{384};
-	static constexpr size_t txQueueSize{384};
+	static constexpr size_t kPacketSize{64};
+	static constexpr uint8_t kRxPackets{4};
+	static constexpr uint8_t kTxPackets{4};
+
+	static_assert((kRxPackets & (kRxPackets - 1)) == 0 && (kTxPackets & (kTxPackets - 1)) == 0,
+		"Packet count should be a power of two");
+
+	struct Packet {
+		uint8_t data[kPacketSize];
+		uint8_t length;
+	};
+
+	enum class TxState : uint8_t {
+		Idle,
+		Data,
+		ZeroLength
+	};
 
 	static constexpr uint8_t kDataRxEp{0x01};
 	static constexpr uint8_t kDataTxEp{0x82};
@@ -64,10 +111,19 @@ private:
 
 	uint8_t arena[kControlBufferSize];
 	usbd_device *device;
-	bool pending;
 
-	Queue<uint8_t, rxQueueSize> rxQueue;
-	Queue<uint8_t, txQueueSize> txQueue;
+	// Indices are free-running counters, the producer and the consumer change their own indices only
+	Packet rxPackets[kRxPackets];
+	volatile uint8_t rxHead;
+	volatile uint8_t rxTail;
+	volatile bool rxBlocked;
+	uint8_t rxOffset;
+
+	Packet txPackets[kTxPackets];
+	uint8_t txHead;
+	uint8_t txTail;
+	TxState txState;
+	bool txFull;
 
 	std::function<void ()> callback;
 
@@ -77,6 +133,9 @@ private:
 	static void handleDataTxCallback(usbd_device *, uint8_t);
 	static void setInterfaceConfig(usbd_device *, uint16_t);
 
+	void reset();
+	void transmit();
+
 	static const usb_device_descriptor kDeviceDescriptor;
 	static const std::array<usb_endpoint_descriptor, 1> kNotificationEndpoints;
 	static const std::array<usb_endpoint_descriptor, 2> kDataEndpoints;
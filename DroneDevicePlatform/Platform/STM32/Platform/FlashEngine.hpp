@@ -0,0 +1,188 @@
+//
+// FlashEngine.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_STM32_PLATFORM_FLASHENGINE_HPP_
+#define PLATFORM_STM32_PLATFORM_FLASHENGINE_HPP_
+
+#include <DroneDevice/InplaceFunction.hpp>
+#include <DroneDevice/Queue.hpp>
+#include <libopencm3/cm3/nvic.h>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+class FlashEngineBase {
+public:
+	virtual ~FlashEngineBase() = default;
+
+	static void handleIrq()
+	{
+		instance->handler();
+	}
+
+protected:
+	virtual void handler() = 0;
+
+	static void setHandler(FlashEngineBase *aInstance)
+	{
+		instance = aInstance;
+	}
+
+private:
+	static FlashEngineBase *instance;
+};
+
+//!
+//! Non-blocking erase and program engine. Each operation is started from the
+//! end-of-operation interrupt of the previous one, so the main loop is not stalled
+//! while the flash controller is busy. Flash is unlocked while jobs are pending,
+//! synchronous Flash calls must not be mixed with queued jobs.
+//!
+template<typename Flash, size_t capacity = 4>
+class FlashEngine : public FlashEngineBase {
+public:
+	//! Completion callback, called from the interrupt handler with the job status, never uses the heap
+	using Callback = InplaceFunction<void (bool)>;
+
+	FlashEngine() :
+		jobs{},
+		active{false}
+	{
+		FlashEngineBase::setHandler(this);
+
+		nvic_clear_pending_irq(NVIC_FLASH_IRQ);
+		nvic_enable_irq(NVIC_FLASH_IRQ);
+	}
+
+	~FlashEngine() override
+	{
+		nvic_disable_irq(NVIC_FLASH_IRQ);
+		FlashEngineBase::setHandler(nullptr);
+	}
+
+	//!
+	//! Queue erase of pages or sectors.
+	//! \param offset Absolute address of the first page or sector.
+	//! \param length Length of the region.
+	//! \param callback Completion callback.
+	//! \return False when the queue is full.
+	//!
+	bool erase(uintptr_t aOffset, size_t aLength, Callback aCallback = nullptr)
+	{
+		return enqueue(Job{aOffset, aOffset + aLength, nullptr, aCallback});
+	}
+
+	//!
+	//! Queue programming of the buffer. The buffer must stay valid until the callback is called.
+	//! \param offset Absolute address aligned to the programming unit.
+	//! \param buffer Pointer to buffer with at least @b length characters of data.
+	//! \param length Buffer length, the last unit is padded with ones.
+	//! \param callback Completion callback.
+	//! \return False when the queue is full.
+	//!
+	bool write(uintptr_t aOffset, const void *aBuffer, size_t aLength, Callback aCallback = nullptr)
+	{
+		assert(aOffset % Flash::kProgramUnit == 0);
+		return enqueue(Job{aOffset, aOffset + aLength, static_cast<const uint8_t *>(aBuffer), aCallback});
+	}
+
+	bool isBusy() const
+	{
+		return active;
+	}
+
+protected:
+	void handler() override
+	{
+		// Interrupt of the operation rejected at start may be still pending
+		if (!active || Flash::isBusy()) {
+			return;
+		}
+
+		advance(Flash::finishOperation());
+	}
+
+private:
+	struct Job {
+		uintptr_t address;
+		uintptr_t end;
+		const uint8_t *buffer;
+		Callback callback;
+	};
+
+	Queue<Job, capacity> jobs;
+	volatile bool active;
+
+	bool enqueue(const Job &aJob)
+	{
+		bool result = false;
+
+		nvic_disable_irq(NVIC_FLASH_IRQ);
+
+		if (!jobs.full()) {
+			jobs.push(aJob);
+			result = true;
+
+			if (!active) {
+				active = true;
+				Flash::unlock();
+				Flash::enableIrq();
+				advance(true);
+			}
+		}
+
+		nvic_enable_irq(NVIC_FLASH_IRQ);
+		return result;
+	}
+
+	bool issue(Job &aJob)
+	{
+		if (aJob.buffer != nullptr) {
+			const bool result = Flash::startProgram(aJob.address, aJob.buffer, aJob.end - aJob.address);
+
+			aJob.address += Flash::kProgramUnit;
+			aJob.buffer += Flash::kProgramUnit;
+			return result;
+		} else {
+			return Flash::startErase(aJob.address);
+		}
+	}
+
+	void advance(bool aStatus)
+	{
+		while (!jobs.empty()) {
+			Job &job = jobs.front();
+
+			if (aStatus && job.address < job.end) {
+				if (issue(job)) {
+					// Wait for the end of the operation
+					return;
+				}
+
+				Flash::finishOperation();
+				aStatus = false;
+			}
+
+			// Callback may queue the next job, so the slot is released before the call
+			const Callback callback{std::move(jobs.front().callback)};
+
+			jobs.pop();
+
+			if (callback != nullptr) {
+				callback(aStatus);
+			}
+			aStatus = true;
+		}
+
+		Flash::disableIrq();
+		Flash::lock();
+		active = false;
+	}
+};
+
+#endif // PLATFORM_STM32_PLATFORM_FLASHENGINE_HPP_
@@ -8,7 +8,8 @@
 #ifndef PLATFORM_STM32_PWM_HPP_
 #define PLATFORM_STM32_PWM_HPP_
 
-#include "Platform/TimerBase.hpp"
+#include "Platform/Timer.hpp"
+#include <algorithm>
 #include <cassert>
 
 template<unsigned int number>
@@ -18,6 +19,14 @@ class Pwm : public TimerBase<number> {
 	static constexpr auto kIrq{BaseType::numberToIrq()};
 
 public:
+	enum class Alignment : uint8_t {
+		Edge,
+		//! Counter counts up and down, pulses of all channels are centred on the counter underflow
+		Centre
+	};
+
+	using MasterMode = typename Timer<number, true>::MasterMode;
+
 	template<unsigned int channel, bool inversion = false, bool complementary = false>
 	class Channel {
 		using ParentType = Pwm<number>;
@@ -106,14 +115,21 @@ public:
 		ParentType &parent;
 	};
 
-	Pwm(uint32_t aFrequency, uint32_t aPeriod)
+	//!
+	//! Configure the timer.
+	//! \param frequency Counter clock frequency.
+	//! \param period Counter period, PWM period is twice as long with centre alignment.
+	//! \param alignment Alignment of pulses.
+	//!
+	Pwm(uint32_t aFrequency, uint32_t aPeriod, Alignment aAlignment = Alignment::Edge)
 	{
 		assert(aFrequency > 0);
 
 		rcc_periph_clock_enable(BaseType::numberToClockBranch());
 		rcc_periph_reset_pulse(BaseType::numberToResetSignal());
 
-		timer_set_mode(kPeriph, TIM_CR1_CKD_CK_INT, TIM_CR1_CMS_EDGE, TIM_CR1_DIR_UP);
+		timer_set_mode(kPeriph, TIM_CR1_CKD_CK_INT,
+			aAlignment == Alignment::Centre ? TIM_CR1_CMS_CENTER_1 : TIM_CR1_CMS_EDGE, TIM_CR1_DIR_UP);
 		timer_set_prescaler(kPeriph, BaseType::clock() / aFrequency - 1);
 		timer_set_period(kPeriph, aPeriod - 1);
 
@@ -139,6 +155,34 @@ public:
 		timer_clear_flag(kPeriph, TIM_SR_UIF);
 	}
 
+	void setMasterMode(MasterMode aMode)
+	{
+		timer_set_master_mode(kPeriph, static_cast<uint32_t>(aMode) << 4);
+	}
+
+	//!
+	//! Use the fourth channel as an internal trigger source, the channel should not drive an output.
+	//! The reference signal rises when the counter reaches the value, so with the master mode
+	//! CompareOC4Ref the trigger output produces a single edge per PWM period.
+	//! \param value Counter value of the trigger event in the range from 1 to the period minus one, values
+	//! outside the range are limited to it. With zero value the reference signal stays active, so there are
+	//! no edges. A stopped timer loads the value immediately, a running timer applies it at the next update
+	//! event, because a forced update would restart the period of all channels.
+	//!
+	void setTriggerPoint(uint32_t aValue)
+	{
+		const uint32_t top = TIM_ARR(kPeriph);
+
+		timer_set_oc_mode(kPeriph, TIM_OC4, TIM_OCM_PWM2);
+		timer_enable_oc_preload(kPeriph, TIM_OC4);
+		timer_set_oc_value(kPeriph, TIM_OC4, std::max<uint32_t>(1, std::min(aValue, top)));
+
+		if (!(TIM_CR1(kPeriph) & TIM_CR1_CEN)) {
+			timer_generate_event(kPeriph, TIM_EGR_UG);
+			timer_clear_flag(kPeriph, TIM_SR_UIF);
+		}
+	}
+
 protected:
 	void handler() override
 	{
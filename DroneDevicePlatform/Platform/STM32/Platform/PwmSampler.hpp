@@ -0,0 +1,76 @@
+//
+// PwmSampler.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_STM32_PWMSAMPLER_HPP_
+#define PLATFORM_STM32_PWMSAMPLER_HPP_
+
+#include "Platform/Pwm.hpp"
+#include <cstdint>
+
+//!
+//! ADC sampling synchronized with PWM. The fourth channel of the PWM timer drives the trigger output,
+//! each trigger starts a conversion of the channel sequence and DMA stores results into the circular
+//! buffer of the ADC, so the processor is involved only in the buffer callbacks. A buffer with two
+//! sequences produces a callback in every PWM period.
+//! \tparam number PWM timer number, the fourth channel of the timer is reserved for the trigger.
+//! \tparam Adc Buffered ADC configured with the trigger from TRGO of the timer.
+//!
+template<unsigned int number, typename Adc>
+class PwmSampler {
+public:
+	using PwmType = Pwm<number>;
+
+	//!
+	//! Configure the trigger.
+	//! \param pwm Timer configured with centre alignment, so the sampling point is placed symmetrically
+	//! relative to the pulses. Edge alignment is supported too.
+	//! \param adc Buffered ADC.
+	//! \param point Counter value of the sampling point in the range from 1 to period minus one,
+	//! values outside the range are limited to it. With centre alignment the value equal to
+	//! the period minus one places the point at the top of the counter, in the middle of the inactive state
+	//! of PWM1 outputs, where switching noise is minimal and low-side shunts carry the phase current.
+	//!
+	PwmSampler(PwmType &aPwm, Adc &aAdc, uint32_t aPoint) :
+		pwm{aPwm},
+		adc{aAdc}
+	{
+		pwm.setTriggerPoint(aPoint);
+		pwm.setMasterMode(PwmType::MasterMode::CompareOC4Ref);
+	}
+
+	PwmSampler(const PwmSampler &) = delete;
+	PwmSampler &operator=(const PwmSampler &) = delete;
+
+	//!
+	//! Move the sampling point, the change is applied in the next PWM period.
+	//! \param point Counter value of the sampling point, limited to the range from 1 to period minus one.
+	//!
+	void setPoint(uint32_t aPoint)
+	{
+		pwm.setTriggerPoint(aPoint);
+	}
+
+	//!
+	//! Start the ADC first, so that it waits for the first trigger, then the timer.
+	//!
+	void start()
+	{
+		adc.start();
+		pwm.enable();
+	}
+
+	void stop()
+	{
+		pwm.disable();
+		adc.stop();
+	}
+
+private:
+	PwmType &pwm;
+	Adc &adc;
+};
+
+#endif // PLATFORM_STM32_PWMSAMPLER_HPP_
@@ -9,10 +9,35 @@
 #define PLATFORM_STM32_SPIDMA_HPP_
 
 #include "Platform/Dma.hpp"
+#include "Platform/Irq.hpp"
 #include "Platform/SpiBase.hpp"
+#include <DroneDevice/Queue.hpp>
 
-template<unsigned int number, unsigned int dma = 0, SpiDmaRemap remap = SpiDmaRemap::Default>
+//!
+//! SPI with DMA transfers. Besides direct transfers the driver has a queue of transactions
+//! for devices sharing the bus: the next transaction is started from the DMA interrupt
+//! right after the previous one, chip select lines are driven by the driver.
+//! \tparam queueSize Capacity of the transaction queue.
+//!
+template<unsigned int number, unsigned int dma = 0, SpiDmaRemap remap = SpiDmaRemap::Default, size_t queueSize = 4>
 class SpiDma : public SpiBase<number, dma, remap> {
+public:
+	//!
+	//! Transaction descriptor, buffers must stay valid until the completion callback is called.
+	//!
+	struct Transaction {
+		//! Chip select control, for example Gpio<...>::write, the line is active low
+		void (*select)(bool);
+		//! Data to be sent, the bus is driven by the placeholder when the buffer is not set
+		const void *txBuffer;
+		//! Buffer for received data, received data is discarded when the buffer is not set
+		void *rxBuffer;
+		size_t length;
+		//! Completion callback, called from the interrupt handler
+		std::function<void ()> callback;
+	};
+
+private:
 	using BaseType = SpiBase<number, dma, remap>;
 	static constexpr auto kPeriph{BaseType::numberToPeriph()};
 
@@ -21,8 +46,10 @@ class SpiDma : public SpiBase<number, dma, remap> {
 	DmaChannel<BaseType::numberToDmaController(), BaseType::numberToDmaTxChannel()> txDma;
 	DmaChannel<BaseType::numberToDmaController(), BaseType::numberToDmaTxChannel()> txDmaStub;
 	std::function<void ()> callback;
+	Queue<Transaction, queueSize> transactions;
 	uint32_t stub;
 	uint8_t invoked;
+	volatile bool queued;
 
 public:
 	SpiDma(uint8_t aMode, uint32_t aRate = 0, std::function<void ()> aCallback = nullptr) :
@@ -60,8 +87,10 @@ public:
 			BaseType::numberToDmaTxEvent(),
 			[this](uint32_t aFlags){ handler(aFlags); }},
 		callback{aCallback},
+		transactions{},
 		stub{},
-		invoked{0}
+		invoked{2},
+		queued{false}
 	{
 		rcc_periph_clock_enable(BaseType::numberToClockBranch());
 		rcc_periph_reset_pulse(BaseType::numberToResetSignal());
@@ -86,7 +115,10 @@ public:
 
 	void read(void *aBuffer, size_t aLength, bool aBlocking = true)
 	{
-		invoked = 0;
+		if (!claim(aLength)) {
+			return;
+		}
+
 		rxDma.start(aBuffer, BaseType::dataRegAddress(), aLength);
 		txDmaStub.start(BaseType::dataRegAddress(), &stub, aLength);
 
@@ -105,7 +137,10 @@ public:
 
 	void write(const void *aBuffer, size_t aLength, bool aBlocking = true)
 	{
-		invoked = 0;
+		if (!claim(aLength)) {
+			return;
+		}
+
 		rxDmaStub.start(&stub, BaseType::dataRegAddress(), aLength);
 		txDma.start(BaseType::dataRegAddress(), aBuffer, aLength);
 
@@ -124,7 +159,10 @@ public:
 
 	void exchange(void *aRxBuffer, const void *aTxBuffer, size_t aLength, bool aBlocking = true)
 	{
-		invoked = 0;
+		if (!claim(aLength)) {
+			return;
+		}
+
 		rxDma.start(aRxBuffer, BaseType::dataRegAddress(), aLength);
 		txDma.start(BaseType::dataRegAddress(), aTxBuffer, aLength);
 
@@ -140,15 +178,133 @@ public:
 		callback = aCallback;
 	}
 
+	//!
+	//! Add the transaction to the queue, the transaction is started immediately when the bus is idle.
+	//! \param transaction Transaction descriptor.
+	//! \return False when the queue is full or the transaction is empty.
+	//!
+	bool submit(const Transaction &aTransaction)
+	{
+		// Empty transfer is never completed by the DMA
+		if (!aTransaction.length) {
+			return false;
+		}
+
+		bool result = false;
+		const IrqState state = irqSave();
+
+		if (!transactions.full()) {
+			transactions.push(aTransaction);
+			result = true;
+
+			// Transaction submitted during a direct transfer is started from the interrupt handler
+			if (!queued && invoked == 2) {
+				queued = true;
+				startTransaction(transactions.front());
+			}
+		}
+
+		irqRestore(state);
+		return result;
+	}
+
+	bool isIdle() const
+	{
+		return !queued && invoked == 2;
+	}
+
 private:
 	void handler(uint32_t aFlags)
 	{
 		if (aFlags & Dma::Flags::TransferComplete) {
-			if (callback && invoked == 1) {
+			// Transfer is finished after completion of both channels
+			if (++invoked != 2) {
+				return;
+			}
+
+			if (queued) {
+				finishTransaction();
+			} else {
+				if (callback) {
+					callback();
+				}
+
+				if (!transactions.empty() && invoked == 2) {
+					queued = true;
+					startTransaction(transactions.front());
+				}
+			}
+		}
+	}
+
+	void startTransaction(const Transaction &aTransaction)
+	{
+		if (aTransaction.select != nullptr) {
+			aTransaction.select(false);
+		}
+
+		invoked = 0;
+
+		if (aTransaction.rxBuffer != nullptr) {
+			rxDma.start(aTransaction.rxBuffer, BaseType::dataRegAddress(), aTransaction.length);
+		} else {
+			rxDmaStub.start(&stub, BaseType::dataRegAddress(), aTransaction.length);
+		}
+
+		if (aTransaction.txBuffer != nullptr) {
+			txDma.start(BaseType::dataRegAddress(), aTransaction.txBuffer, aTransaction.length);
+		} else {
+			txDmaStub.start(BaseType::dataRegAddress(), &stub, aTransaction.length);
+		}
+	}
+
+	void finishTransaction()
+	{
+		const Transaction completed = transactions.pop();
+
+		if (completed.select != nullptr) {
+			completed.select(true);
+		}
+
+		// Next transaction is started before the callback to keep the bus busy
+		if (!transactions.empty()) {
+			startTransaction(transactions.front());
+		} else {
+			queued = false;
+		}
+
+		if (completed.callback) {
+			completed.callback();
+		}
+	}
+
+	//!
+	//! Wait until the bus is idle and reserve it for a direct transfer.
+	//! \param length Length of the transfer.
+	//! \return False when the transfer is empty and was completed immediately.
+	//!
+	bool claim(size_t aLength)
+	{
+		if (!aLength) {
+			if (callback) {
 				callback();
 			}
+			return false;
+		}
+
+		// Check and reservation are atomic, otherwise a transaction submitted from an interrupt
+		// may be started on the bus at the same time
+		while (true) {
+			const IrqState state = irqSave();
+
+			if (isIdle()) {
+				invoked = 0;
+				irqRestore(state);
+				return true;
+			}
 
-			++invoked;
+			irqRestore(state);
+			barrier();
 		}
 	}
 
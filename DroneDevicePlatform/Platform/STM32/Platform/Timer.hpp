@@ -9,6 +9,8 @@
 #define PLATFORM_STM32_TIMER_HPP_
 
 #include "Platform/TimerBase.hpp"
+#include <algorithm>
+#include <cassert>
 #include <functional>
 
 template<unsigned int number, bool continuous>
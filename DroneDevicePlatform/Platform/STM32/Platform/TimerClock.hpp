@@ -0,0 +1,213 @@
+//
+// TimerClock.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_STM32_TIMERCLOCK_HPP_
+#define PLATFORM_STM32_TIMERCLOCK_HPP_
+
+#include "Platform/TimerBase.hpp"
+#include <Platform/AsmHelpers.hpp>
+#include <Platform/Irq.hpp>
+#include <chrono>
+#include <cstdint>
+
+//!
+//! Monotonic clock with microsecond resolution based on a free-running timer.
+//! The counter of the timer is extended with the number of overflows counted in the interrupt,
+//! so the time is read without locking: 64 bits with 32-bit timers and 48 bits with 16-bit timers.
+//! The interface is compatible with LocalTime, delays put the core into the sleep mode.
+//! \tparam number Timer number.
+//!
+template<unsigned int number>
+class TimerClock : public TimerBase<number> {
+	using BaseType = TimerBase<number>;
+	static constexpr auto kPeriph{BaseType::numberToPeriph()};
+	static constexpr auto kIrq{BaseType::numberToIrq()};
+	static constexpr uint32_t kResolution{BaseType::numberToResolution()};
+	static constexpr unsigned int kCounterBits{kResolution == 0xFFFFFFFFUL ? 32 : 16};
+	static constexpr uint32_t kHalfPeriod{kResolution / 2 + 1};
+
+public:
+	TimerClock(const TimerClock &) = delete;
+	TimerClock &operator=(const TimerClock &) = delete;
+
+	static void init()
+	{
+		BaseType::setHandler(&instance());
+		rcc_periph_clock_enable(BaseType::numberToClockBranch());
+		rcc_periph_reset_pulse(BaseType::numberToResetSignal());
+
+		timer_set_mode(kPeriph, TIM_CR1_CKD_CK_INT, TIM_CR1_CMS_EDGE, TIM_CR1_DIR_UP);
+		timer_set_prescaler(kPeriph, BaseType::clock() / 1000000 - 1);
+		timer_set_period(kPeriph, kResolution);
+		timer_continuous_mode(kPeriph);
+
+		// Load the prescaler without setting the update flag
+		timer_update_on_overflow(kPeriph);
+		timer_generate_event(kPeriph, TIM_EGR_UG);
+		timer_clear_flag(kPeriph, TIM_SR_UIF | TIM_SR_CC1IF);
+		overflows() = 0;
+
+		// Overflows should be counted before any other interrupt reads the time
+		timer_enable_irq(kPeriph, TIM_DIER_UIE);
+		nvic_set_priority(kIrq, 0);
+		nvic_clear_pending_irq(kIrq);
+		nvic_enable_irq(kIrq);
+
+		timer_enable_counter(kPeriph);
+	}
+
+	static void deinit()
+	{
+		timer_disable_counter(kPeriph);
+		nvic_disable_irq(kIrq);
+		timer_disable_irq(kPeriph, TIM_DIER_UIE | TIM_DIER_CC1IE);
+
+		rcc_periph_clock_disable(BaseType::numberToClockBranch());
+		BaseType::setHandler(nullptr);
+	}
+
+	//!
+	//! Read the time, the function may be called from any context including critical sections.
+	//! \return Time since the initialization.
+	//!
+	static std::chrono::microseconds now()
+	{
+		return std::chrono::microseconds{static_cast<int64_t>(ticks())};
+	}
+
+	static std::chrono::microseconds microseconds()
+	{
+		return now();
+	}
+
+	static std::chrono::milliseconds milliseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(now());
+	}
+
+	static std::chrono::seconds seconds()
+	{
+		return std::chrono::duration_cast<std::chrono::seconds>(now());
+	}
+
+	//!
+	//! Sleep until the deadline. The compare interrupt wakes the core up when the deadline
+	//! is within the current period of the counter, otherwise the overflow interrupt does.
+	//! Other interrupts are serviced during the sleep.
+	//! \param deadline Time since the initialization.
+	//!
+	static void sleepUntil(std::chrono::microseconds aDeadline)
+	{
+		const uint64_t deadline = toTicks(aDeadline);
+
+		for (;;) {
+			// Pending interrupts end the sleep even when they are masked
+			const IrqState state = irqSave();
+
+			if (ticks() >= deadline) {
+				timer_disable_irq(kPeriph, TIM_DIER_CC1IE);
+				irqRestore(state);
+				break;
+			}
+
+			wakeAt(aDeadline);
+			sleep();
+			irqRestore(state);
+		}
+	}
+
+	//!
+	//! Request an interrupt at the deadline, the interrupt is pended immediately
+	//! when the deadline has passed. Should be called with interrupts disabled.
+	//! \param deadline Time since the initialization.
+	//!
+	static void wakeAt(std::chrono::microseconds aDeadline)
+	{
+		const uint64_t deadline = toTicks(aDeadline);
+		uint64_t current = ticks();
+
+		if (current < deadline && deadline - current <= kResolution) {
+			timer_set_oc_value(kPeriph, TIM_OC1, static_cast<uint32_t>(deadline) & kResolution);
+			timer_clear_flag(kPeriph, TIM_SR_CC1IF);
+			timer_enable_irq(kPeriph, TIM_DIER_CC1IE);
+
+			// Counter could pass the compare value while it was being programmed
+			current = ticks();
+		}
+
+		if (current >= deadline) {
+			nvic_set_pending_irq(kIrq);
+		}
+	}
+
+	static void delay(std::chrono::microseconds aValue)
+	{
+		sleepUntil(now() + aValue);
+	}
+
+protected:
+	void handler() override
+	{
+		const uint32_t flags = TIM_SR(kPeriph);
+
+		if (flags & TIM_SR_UIF) {
+			// Interrupts of higher priority should see both changes at once
+			const IrqState state = irqSave();
+
+			overflows() = overflows() + 1;
+			timer_clear_flag(kPeriph, TIM_SR_UIF);
+			irqRestore(state);
+		}
+
+		if (flags & TIM_SR_CC1IF) {
+			timer_clear_flag(kPeriph, TIM_SR_CC1IF);
+			timer_disable_irq(kPeriph, TIM_DIER_CC1IE);
+		}
+	}
+
+private:
+	TimerClock() = default;
+
+	static TimerClock &instance()
+	{
+		static TimerClock object;
+		return object;
+	}
+
+	static volatile uint32_t &overflows()
+	{
+		static volatile uint32_t value{0};
+		return value;
+	}
+
+	static uint64_t toTicks(std::chrono::microseconds aValue)
+	{
+		return aValue.count() > 0 ? static_cast<uint64_t>(aValue.count()) : 0;
+	}
+
+	static uint64_t ticks()
+	{
+		uint32_t high = overflows();
+		const uint32_t low = timer_get_counter(kPeriph);
+
+		if (low < kHalfPeriod) {
+			// Counter has wrapped recently, the overflow may be still unhandled
+			high = overflows();
+			const bool pending = (TIM_SR(kPeriph) & TIM_SR_UIF) != 0;
+			const uint32_t recent = overflows();
+
+			if (recent != high) {
+				high = recent;
+			} else if (pending) {
+				++high;
+			}
+		}
+
+		return (static_cast<uint64_t>(high) << kCounterBits) | low;
+	}
+};
+
+#endif // PLATFORM_STM32_TIMERCLOCK_HPP_
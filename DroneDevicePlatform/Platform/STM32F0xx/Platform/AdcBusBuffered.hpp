@@ -0,0 +1,162 @@
+//
+// AdcBusBuffered.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_STM32F0XX_ADCBUSBUFFERED_HPP_
+#define PLATFORM_STM32F0XX_ADCBUSBUFFERED_HPP_
+
+#include "Platform/AdcBase.hpp"
+#include "Platform/Dma.hpp"
+#include <DroneDevice/Oversampling.hpp>
+#include <array>
+#include <cassert>
+#include <chrono>
+
+//!
+//! Continuous acquisition of a channel sequence into a circular buffer. The buffer is split into
+//! two halves, a callback is called when DMA finishes a half, the other half is filled meanwhile.
+//! Samples passed to the callback stay unchanged until the next callback.
+//! \tparam oversampling Number of consecutive sequences averaged in the buffer before the callback.
+//!
+template<unsigned int number, size_t channels, typename Time, unsigned kSampleRate = ADC_SMPR_SMP_013DOT5,
+	size_t oversampling = 1>
+class AdcBusBuffered : public AdcBase<number> {
+	using BaseType = AdcBase<number>;
+	using Averaging = Oversampling<channels, oversampling>;
+	static constexpr auto kPeriph{BaseType::numberToPeriph()};
+
+public:
+	using Channel = typename BaseType::Channel;
+	using Trigger = typename BaseType::Trigger;
+
+	AdcBusBuffered(std::array<Channel, channels> aChannels, uint16_t *aBuffer, size_t aSampleCount,
+		Trigger aTrigger = Trigger::NONE, std::function<void (const uint16_t *, size_t)> aCallback = nullptr) :
+		BaseType{},
+		dma{
+			Dma::Dir::PeriphToMem,
+			Dma::Width::HalfWord,
+			false,
+			Dma::Width::HalfWord,
+			true,
+			BaseType::numberToDmaEvent(),
+			[this](uint32_t aFlags){ handler(aFlags); },
+			true},
+		callback{aCallback},
+		buffer{aBuffer},
+		samples{aSampleCount},
+		continuous{aTrigger == Trigger::NONE}
+	{
+		assert(aSampleCount > 0 && aSampleCount % (channels * oversampling * 2) == 0);
+
+		dma.enableHalfTransferInterrupt();
+
+		rcc_periph_clock_enable(BaseType::numberToClockBranch());
+		rcc_periph_reset_pulse(BaseType::numberToResetSignal());
+
+		// Make sure the ADC doesn't run during configuration
+		adc_power_off(kPeriph);
+
+		adc_set_clk_source(kPeriph, ADC_CLKSOURCE_PCLK_DIV4);
+		adc_calibrate_async(kPeriph);
+		adc_disable_discontinuous_mode(kPeriph);
+		adc_set_single_conversion_mode(kPeriph);
+		adc_disable_analog_watchdog(kPeriph);
+		adc_set_sample_time_on_all_channels(kPeriph, kSampleRate);
+
+		uint8_t channelArray[channels];
+
+		for (size_t i = 0; i < channels; ++i) {
+			channelArray[i] = static_cast<uint8_t>(aChannels[i]);
+		}
+		adc_set_regular_sequence(kPeriph, channels, channelArray);
+
+		if (aTrigger == Trigger::NONE) {
+			adc_disable_external_trigger_regular(kPeriph);
+		} else {
+			adc_enable_external_trigger_regular(kPeriph,
+				ADC_CFGR1_EXTSEL_VAL(static_cast<uint32_t>(aTrigger)),
+				ADC_CFGR1_EXTEN_RISING_EDGE);
+		}
+
+		// Calibration can only be initiated when the ADC is disabled
+		adc_calibrate(kPeriph);
+
+		do {
+			// Enable converter
+			adc_power_on_async(kPeriph);
+			// Wait for ADC power-up
+			Time::delay(std::chrono::microseconds{10});
+		} while (!adc_is_power_on(kPeriph));
+
+		adc_enable_dma(kPeriph);
+		adc_enable_dma_circular_mode(kPeriph);
+	}
+
+	~AdcBusBuffered() override
+	{
+		adc_power_off(kPeriph);
+		rcc_periph_clock_disable(BaseType::numberToClockBranch());
+	}
+
+	void setCallback(std::function<void (const uint16_t *, size_t)> aCallback)
+	{
+		callback = aCallback;
+	}
+
+	void start()
+	{
+		auto dst = reinterpret_cast<void *>(const_cast<uint32_t *>(&ADC_DR(kPeriph)));
+		dma.start(buffer, dst, samples);
+
+		// Sequences are converted back to back when there is no trigger
+		if (continuous) {
+			adc_set_continuous_conversion_mode(kPeriph);
+		}
+		adc_start_conversion_regular(kPeriph);
+	}
+
+	void stop()
+	{
+		// Configuration register can only be written when conversions are stopped,
+		// stop request is allowed only while conversions are enabled
+		if (ADC_CR(kPeriph) & ADC_CR_ADSTART) {
+			ADC_CR(kPeriph) |= ADC_CR_ADSTP;
+			while (ADC_CR(kPeriph) & ADC_CR_ADSTART);
+		}
+
+		adc_set_single_conversion_mode(kPeriph);
+		dma.stop();
+	}
+
+private:
+	DmaChannel<BaseType::numberToDmaController(), BaseType::numberToDmaChannel()> dma;
+	std::function<void (const uint16_t *, size_t)> callback;
+	uint16_t * const buffer;
+	const size_t samples;
+	const bool continuous;
+
+	void handler(uint32_t aFlags)
+	{
+		if (!callback) {
+			return;
+		}
+
+		// Both flags are set when the interrupt was delayed for longer than a half of the buffer
+		if (aFlags & Dma::Flags::HalfTransfer) {
+			process(buffer);
+		}
+		if (aFlags & Dma::Flags::TransferComplete) {
+			process(buffer + (samples >> 1));
+		}
+	}
+
+	void process(uint16_t *aHalf)
+	{
+		// DMA writes to the other half of the buffer, so the samples are averaged in place
+		callback(aHalf, Averaging::reduce(aHalf, samples >> 1));
+	}
+};
+
+#endif // PLATFORM_STM32F0XX_ADCBUSBUFFERED_HPP_
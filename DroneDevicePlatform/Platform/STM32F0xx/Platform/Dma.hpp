@@ -256,6 +256,16 @@ public:
 		DMA_CCR(kPeriph, kChannel) &= ~DMA_CCR_EN;
 	}
 
+	void disableHalfTransferInterrupt()
+	{
+		config &= ~DMA_CCR_HTIE;
+	}
+
+	void enableHalfTransferInterrupt()
+	{
+		config |= DMA_CCR_HTIE;
+	}
+
 protected:
 	void handler(uint32_t aFlags) override
 	{
@@ -73,6 +73,21 @@ public:
 		pwr_enable_backup_domain_write_protect();
 	}
 
+	//!
+	//! Checksum of the firmware trailer verified during the last cold start.
+	//!
+	static uint32_t getImageDigest()
+	{
+		return RTC_BKPXR(3);
+	}
+
+	static void setImageDigest(uint32_t aDigest)
+	{
+		pwr_disable_backup_domain_write_protect();
+		RTC_BKPXR(3) = aDigest;
+		pwr_enable_backup_domain_write_protect();
+	}
+
 	static void clearBootSignature()
 	{
 		RCC_CSR |= RCC_CSR_RMVF;
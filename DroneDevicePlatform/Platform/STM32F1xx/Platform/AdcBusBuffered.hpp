@@ -10,12 +10,21 @@
 
 #include "Platform/AdcBase.hpp"
 #include "Platform/Dma.hpp"
+#include <DroneDevice/Oversampling.hpp>
 #include <array>
 #include <cassert>
 
-template<unsigned int number, size_t channels, typename Time, unsigned kSampleRate = ADC_SMPR_SMP_13DOT5CYC>
+//!
+//! Continuous acquisition of a channel sequence into a circular buffer. The buffer is split into
+//! two halves, a callback is called when DMA finishes a half, the other half is filled meanwhile.
+//! Samples passed to the callback stay unchanged until the next callback.
+//! \tparam oversampling Number of consecutive sequences averaged in the buffer before the callback.
+//!
+template<unsigned int number, size_t channels, typename Time, unsigned kSampleRate = ADC_SMPR_SMP_13DOT5CYC,
+	size_t oversampling = 1>
 class AdcBusBuffered : public AdcBase<number> {
 	using BaseType = AdcBase<number>;
+	using Averaging = Oversampling<channels, oversampling>;
 	static constexpr auto kPeriph{BaseType::numberToPeriph()};
 
 public:
@@ -36,9 +45,10 @@ public:
 			true},
 		callback{aCallback},
 		buffer{aBuffer},
-		samples{aSampleCount}
+		samples{aSampleCount},
+		continuous{aTrigger == Trigger::NONE}
 	{
-		assert(aSampleCount >= channels * 2);
+		assert(aSampleCount > 0 && aSampleCount % (channels * oversampling * 2) == 0);
 
 		dma.enableHalfTransferInterrupt();
 
@@ -96,14 +106,26 @@ public:
 	{
 		auto dst = reinterpret_cast<void *>(const_cast<uint32_t *>(&ADC_DR(kPeriph)));
 		dma.start(buffer, dst, samples);
+
+		// Sequences are converted back to back when there is no trigger
+		if (continuous) {
+			adc_set_continuous_conversion_mode(kPeriph);
+		}
 		adc_start_conversion_regular(kPeriph);
 	}
 
+	void stop()
+	{
+		adc_set_single_conversion_mode(kPeriph);
+		dma.stop();
+	}
+
 private:
 	DmaChannel<BaseType::numberToDmaController(), BaseType::numberToDmaChannel()> dma;
 	std::function<void (const uint16_t *, size_t)> callback;
 	uint16_t * const buffer;
 	const size_t samples;
+	const bool continuous;
 
 	void handler(uint32_t aFlags)
 	{
@@ -111,12 +133,20 @@ private:
 			return;
 		}
 
+		// Both flags are set when the interrupt was delayed for longer than a half of the buffer
 		if (aFlags & Dma::Flags::HalfTransfer) {
-			callback(buffer, samples >> 1);
-		} else if (aFlags & Dma::Flags::TransferComplete) {
-			callback(buffer + (samples >> 1), samples - (samples >> 1));
+			process(buffer);
+		}
+		if (aFlags & Dma::Flags::TransferComplete) {
+			process(buffer + (samples >> 1));
 		}
 	}
+
+	void process(uint16_t *aHalf)
+	{
+		// DMA writes to the other half of the buffer, so the samples are averaged in place
+		callback(aHalf, Averaging::reduce(aHalf, samples >> 1));
+	}
 };
 
 #endif // PLATFORM_STM32F1XX_ADCBUSBUFFERED_HPP_
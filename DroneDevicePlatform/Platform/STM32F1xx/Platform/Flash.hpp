@@ -8,8 +8,11 @@
 #ifndef PLATFORM_STM32F1XX_FLASH_HPP_
 #define PLATFORM_STM32F1XX_FLASH_HPP_
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstring>
+#include <limits>
 #include <libopencm3/stm32/flash.h>
 
 template<size_t PAGE_SIZE>
@@ -90,6 +93,75 @@ public:
 
 		return true;
 	}
+
+	// Non-blocking primitives used by FlashEngine
+
+	static constexpr size_t kProgramUnit = sizeof(uint16_t);
+
+	static void enableIrq()
+	{
+		FLASH_CR |= FLASH_CR_EOPIE | FLASH_CR_ERRIE;
+	}
+
+	static void disableIrq()
+	{
+		FLASH_CR &= ~(FLASH_CR_EOPIE | FLASH_CR_ERRIE);
+	}
+
+	static bool isBusy()
+	{
+		return (FLASH_SR & FLASH_SR_BSY) != 0;
+	}
+
+	//!
+	//! Start erase of the page.
+	//! \param address Page address, advanced to the next page.
+	//! \return False when the operation was rejected.
+	//!
+	static bool startErase(uintptr_t &aAddress)
+	{
+		assert(aAddress % PAGE_SIZE == 0);
+
+		FLASH_CR |= FLASH_CR_PER;
+		FLASH_AR = aAddress;
+		FLASH_CR |= FLASH_CR_STRT;
+		aAddress += PAGE_SIZE;
+
+		return (FLASH_SR & kErrorFlags) == 0;
+	}
+
+	//!
+	//! Start programming of the half-word, missing bytes are filled with ones.
+	//! \return False when the operation was rejected.
+	//!
+	static bool startProgram(uintptr_t aAddress, const uint8_t *aBuffer, size_t aLength)
+	{
+		uint16_t value = std::numeric_limits<uint16_t>::max();
+
+		memcpy(&value, aBuffer, std::min(aLength, sizeof(value)));
+
+		FLASH_CR |= FLASH_CR_PG;
+		MMIO16(aAddress) = value;
+
+		return (FLASH_SR & kErrorFlags) == 0;
+	}
+
+	//!
+	//! Clear status flags of the completed operation.
+	//! \return True when the operation completed without errors.
+	//!
+	static bool finishOperation()
+	{
+		const uint32_t status = FLASH_SR;
+
+		FLASH_SR = FLASH_SR_EOP | kErrorFlags;
+		FLASH_CR &= ~(FLASH_CR_PG | FLASH_CR_PER);
+
+		return (status & kErrorFlags) == 0;
+	}
+
+private:
+	static constexpr uint32_t kErrorFlags = FLASH_SR_PGERR | FLASH_SR_WRPRTERR;
 };
 
 #endif // PLATFORM_STM32F1XX_FLASH_HPP_
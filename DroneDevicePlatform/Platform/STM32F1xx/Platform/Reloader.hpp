@@ -78,6 +78,23 @@ public:
 		pwr_enable_backup_domain_write_protect();
 	}
 
+	//!
+	//! Checksum of the firmware trailer verified during the last cold start.
+	//!
+	static uint32_t getImageDigest()
+	{
+		// Backup registers are 16 bits wide
+		return (BKP_DR5 & 0xFFFF) << 16 | (BKP_DR4 & 0xFFFF);
+	}
+
+	static void setImageDigest(uint32_t aDigest)
+	{
+		pwr_disable_backup_domain_write_protect();
+		BKP_DR4 = aDigest & 0xFFFF;
+		BKP_DR5 = aDigest >> 16;
+		pwr_enable_backup_domain_write_protect();
+	}
+
 	static void clearBootSignature()
 	{
 		RCC_CSR |= RCC_CSR_RMVF;
@@ -8,6 +8,7 @@
 #ifndef PLATFORM_STM32F4XX_FLASH_HPP_
 #define PLATFORM_STM32F4XX_FLASH_HPP_
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstddef>
@@ -22,9 +23,18 @@ enum class BorLevel: uint8_t {
 	VBOR3 = 0x00
 };
 
-template<BorLevel LEVEL = BorLevel::NONE>
+enum class FlashParallelism: uint8_t {
+	X8  = 0x00,
+	X16 = 0x01,
+	X32 = 0x02,
+	X64 = 0x03 // External Vpp is required
+};
+
+template<BorLevel LEVEL = BorLevel::NONE, FlashParallelism PARALLELISM = FlashParallelism::X32>
 class Flash {
 public:
+	static constexpr size_t kProgramUnit = 1 << static_cast<size_t>(PARALLELISM);
+
 	Flash() = delete;
 	Flash(const Flash &) = delete;
 	Flash &operator=(const Flash &) = delete;
@@ -56,15 +66,12 @@ public:
 
 	static bool erase(uintptr_t offset, size_t length)
 	{
-		const size_t begin = addressToSector(offset);
-		const size_t end = addressToSector(offset + length);
+		const uintptr_t end = offset + length;
 
 		flash_clear_status_flags();
 
-		for (size_t i = begin; i < end; ++i) {
-			flash_erase_sector(static_cast<uint8_t>(i), FLASH_CR_PROGRAM_X32);
-
-			if (FLASH_SR & (FLASH_SR_PGSERR | FLASH_SR_PGAERR | FLASH_SR_WRPERR)) {
+		while (offset < end) {
+			if (!startErase(offset) || !waitForOperation()) {
 				flash_lock();
 				return false;
 			}
@@ -82,19 +89,14 @@ public:
 	static bool write(uintptr_t offset, const void *bufferPtr, size_t length)
 	{
 		assert(length % 4 == 0);
-		assert(offset % 4 == 0);
+		assert(offset % kProgramUnit == 0);
 
 		const uint8_t * const buffer = static_cast<const uint8_t *>(bufferPtr);
 
 		flash_clear_status_flags();
 
-		for (size_t i = 0; i < length; i += 4) {
-			uint32_t word;
-
-			memcpy(&word, buffer + i, sizeof(word));
-			flash_program_word(offset + i, word); // TODO Add parallelism configuration
-
-			if (FLASH_SR & (FLASH_SR_PGSERR | FLASH_SR_PGAERR | FLASH_SR_WRPERR)) {
+		for (size_t i = 0; i < length; i += kProgramUnit) {
+			if (!startProgram(offset + i, buffer + i, length - i) || !waitForOperation()) {
 				flash_lock();
 				return false;
 			}
@@ -103,15 +105,108 @@ public:
 		return true;
 	}
 
+	// Non-blocking primitives used by FlashEngine
+
+	static void enableIrq()
+	{
+		FLASH_CR |= FLASH_CR_EOPIE | FLASH_CR_ERRIE;
+	}
+
+	static void disableIrq()
+	{
+		FLASH_CR &= ~(FLASH_CR_EOPIE | FLASH_CR_ERRIE);
+	}
+
+	static bool isBusy()
+	{
+		return (FLASH_SR & FLASH_SR_BSY) != 0;
+	}
+
+	//!
+	//! Start erase of the sector.
+	//! \param address Sector address, advanced to the next sector.
+	//! \return False when the operation was rejected.
+	//!
+	static bool startErase(uintptr_t &aAddress)
+	{
+		const size_t sector = addressToSector(aAddress);
+
+		const auto &entry = indexToEntry(sector);
+
+		// Unknown or misaligned address, the address would not advance
+		if (entry.size == 0) {
+			return false;
+		}
+
+		setMode(FLASH_CR_SER | (sectorToSnb(sector) << FLASH_CR_SNB_SHIFT));
+		FLASH_CR |= FLASH_CR_STRT;
+		aAddress += entry.size;
+
+		return (FLASH_SR & kErrorFlags) == 0;
+	}
+
+	//!
+	//! Start programming of the unit with configured parallelism,
+	//! missing bytes are filled with ones.
+	//! \return False when the operation was rejected.
+	//!
+	static bool startProgram(uintptr_t aAddress, const uint8_t *aBuffer, size_t aLength)
+	{
+		uint32_t unit[2] = {0xFFFFFFFFUL, 0xFFFFFFFFUL};
+
+		memcpy(unit, aBuffer, std::min(aLength, kProgramUnit));
+
+		setMode(FLASH_CR_PG);
+
+		switch (PARALLELISM) {
+			case FlashParallelism::X8:
+				MMIO8(aAddress) = static_cast<uint8_t>(unit[0]);
+				break;
+
+			case FlashParallelism::X16:
+				MMIO16(aAddress) = static_cast<uint16_t>(unit[0]);
+				break;
+
+			case FlashParallelism::X32:
+				MMIO32(aAddress) = unit[0];
+				break;
+
+			case FlashParallelism::X64:
+				// Two consecutive word accesses are merged into a double word
+				MMIO32(aAddress) = unit[0];
+				MMIO32(aAddress + sizeof(uint32_t)) = unit[1];
+				break;
+		}
+
+		return (FLASH_SR & kErrorFlags) == 0;
+	}
+
+	//!
+	//! Clear status flags of the completed operation.
+	//! \return True when the operation completed without errors.
+	//!
+	static bool finishOperation()
+	{
+		const uint32_t status = FLASH_SR;
+
+		FLASH_SR = FLASH_SR_EOP | kErrorFlags;
+		FLASH_CR &= ~(FLASH_CR_PG | FLASH_CR_SER);
+
+		return (status & kErrorFlags) == 0;
+	}
+
 private:
 	struct Entry {
 		uintptr_t address;
 		size_t size;
 	};
 
-	static size_t addressToSector(uintptr_t address)
+	static constexpr uint32_t kErrorFlags = FLASH_SR_OPERR | FLASH_SR_WRPERR | FLASH_SR_PGAERR
+		| FLASH_SR_PGPERR | FLASH_SR_PGSERR;
+
+	static const Entry &indexToEntry(size_t aIndex)
 	{
-		static const std::array<Entry, 26> kSectors = {{
+		static const std::array<Entry, 25> kSectors = {{
 			{0x08000000, 1024 * 16},
 			{0x08004000, 1024 * 16},
 			{0x08008000, 1024 * 16},
@@ -138,17 +233,40 @@ private:
 			{0x081E0000, 1024 * 128},
 			{0x08200000, 0}}}; // Mock sector
 
-		ssize_t result = -1;
+		assert(aIndex < kSectors.size());
+		return kSectors[aIndex];
+	}
 
-		for (size_t i = 0; i < kSectors.size(); ++i) {
-			if (kSectors[i].address == address) {
-				result = static_cast<ssize_t>(i);
-				break;
-			}
+	static size_t addressToSector(uintptr_t address)
+	{
+		size_t i = 0;
+
+		while (indexToEntry(i).address != address && indexToEntry(i).size != 0) {
+			++i;
 		}
 
-		assert(result != -1);
-		return static_cast<size_t>(result);
+		assert(indexToEntry(i).address == address);
+		return i;
+	}
+
+	static uint32_t sectorToSnb(size_t aSector)
+	{
+		// Sectors of the second bank are numbered from 16
+		return static_cast<uint32_t>(aSector < 12 ? aSector : aSector + 4);
+	}
+
+	static void setMode(uint32_t aMode)
+	{
+		static constexpr uint32_t kModeMask = (FLASH_CR_PROGRAM_MASK << FLASH_CR_PROGRAM_SHIFT)
+			| (FLASH_CR_SNB_MASK << FLASH_CR_SNB_SHIFT) | FLASH_CR_PG | FLASH_CR_SER;
+
+		FLASH_CR = (FLASH_CR & ~kModeMask) | (static_cast<uint32_t>(PARALLELISM) << FLASH_CR_PROGRAM_SHIFT) | aMode;
+	}
+
+	static bool waitForOperation()
+	{
+		while (isBusy());
+		return finishOperation();
 	}
 };
 
@@ -8,20 +8,21 @@
 #ifndef PLATFORM_STM32F4XX_HWCRC32_HPP_
 #define PLATFORM_STM32F4XX_HWCRC32_HPP_
 
+#include <DroneDevice/AcceleratedCrc32.hpp>
 #include <Platform/AsmHelpers.hpp>
 #include <libopencm3/stm32/crc.h>
 #include <libopencm3/stm32/rcc.h>
-#include <cassert>
 #include <cstdint>
 
-class HwCrc32 {
+//!
+//! CRC unit without bit reversal support, input and output words are reversed by the core.
+//! Because of that the unit could not be fed by the DMA.
+//!
+class HwCrc32Unit {
 public:
-	using Type = uint32_t;
-	static constexpr size_t size{sizeof(uint32_t)};
-
-	HwCrc32() = delete;
-	HwCrc32(const HwCrc32 &) = delete;
-	HwCrc32 &operator=(const HwCrc32 &) = delete;
+	HwCrc32Unit() = delete;
+	HwCrc32Unit(const HwCrc32Unit &) = delete;
+	HwCrc32Unit &operator=(const HwCrc32Unit &) = delete;
 
 	static void init()
 	{
@@ -34,23 +35,46 @@ public:
 		rcc_periph_clock_disable(RCC_CRC);
 	}
 
-	static uint32_t update(uint32_t aChecksum, const void *aBuffer, size_t aLength)
+	static void reset()
 	{
-		// Buffer address and size should be aligned along 4-byte boundary
-		assert((aLength & 0x03) == 0);
-		assert((reinterpret_cast<uintptr_t>(aBuffer) & 0x03) == 0);
+		CRC_CR = CRC_CR_RESET;
+	}
 
-		const uint32_t *data = static_cast<const uint32_t *>(aBuffer);
-		size_t wordLength = aLength >> 2;
+	static uint32_t state()
+	{
+		return reverseBits32(CRC_DR);
+	}
 
-		if (!aChecksum)
-			CRC_CR = CRC_CR_RESET;
+	static void feed(const uint32_t *aData, size_t aCount)
+	{
+		while (aCount--)
+			CRC_DR = reverseBits32(*aData++);
+	}
+};
 
-		while (wordLength--)
-			CRC_DR = reverseBits32(*data++);
+//!
+//! CRC32 with the same results as FastCrc32, buffers of any alignment and size are supported.
+//!
+class HwCrc32 : public AcceleratedCrc32<HwCrc32Unit> {
+public:
+	HwCrc32() = delete;
+	HwCrc32(const HwCrc32 &) = delete;
+	HwCrc32 &operator=(const HwCrc32 &) = delete;
+
+	static void init()
+	{
+		HwCrc32Unit::init();
+	}
 
-		return ~reverseBits32(CRC_DR);
+	static void deinit()
+	{
+		HwCrc32Unit::deinit();
 	}
 };
 
+//!
+//! Default CRC32 of the library, the unit is enabled on the first use.
+//!
+using PlatformCrc32 = AutoInitCrc32<HwCrc32>;
+
 #endif // PLATFORM_STM32F4XX_HWCRC32_HPP_
@@ -76,6 +76,21 @@ public:
 		lock();
 	}
 
+	//!
+	//! Checksum of the firmware trailer verified during the last cold start.
+	//!
+	static uint32_t getImageDigest()
+	{
+		return RTC_BKPXR(4);
+	}
+
+	static void setImageDigest(uint32_t aDigest)
+	{
+		unlock();
+		RTC_BKPXR(4) = aDigest;
+		lock();
+	}
+
 	static void setBootSignature()
 	{
 		RCC_CSR |= RCC_CSR_RMVF;
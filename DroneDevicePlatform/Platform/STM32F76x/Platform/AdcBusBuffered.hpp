@@ -0,0 +1,155 @@
+//
+// AdcBusBuffered.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_STM32F76X_ADCBUSBUFFERED_HPP_
+#define PLATFORM_STM32F76X_ADCBUSBUFFERED_HPP_
+
+#include "Platform/AdcBase.hpp"
+#include "Platform/Dma.hpp"
+#include <DroneDevice/Oversampling.hpp>
+#include <array>
+#include <cassert>
+#include <chrono>
+
+//!
+//! Continuous acquisition of a channel sequence into a circular buffer. The buffer is split into
+//! two halves, a callback is called when DMA finishes a half, the other half is filled meanwhile.
+//! Samples passed to the callback stay unchanged until the next callback.
+//! \tparam oversampling Number of consecutive sequences averaged in the buffer before the callback.
+//!
+template<unsigned int number, size_t channels, typename Time,
+	AdcPrescaler prescaler = AdcPrescaler::NonConfigured, AdcDmaStreamRemap stream = AdcDmaStreamRemap::NonConfigured,
+	uint32_t kSampleRate = ADC_SMPR_SMP_480CYC, size_t oversampling = 1>
+class AdcBusBuffered : public AdcBase<number, stream> {
+	static_assert(prescaler != AdcPrescaler::NonConfigured, "Prescaler not configured");
+
+	using BaseType = AdcBase<number, stream>;
+	using Averaging = Oversampling<channels, oversampling>;
+	static constexpr auto kPeriph{BaseType::numberToPeriph()};
+
+public:
+	using Channel = typename BaseType::Channel;
+	using Trigger = typename BaseType::Trigger;
+
+	AdcBusBuffered(std::array<Channel, channels> aChannels, uint16_t *aBuffer, size_t aSampleCount,
+		Trigger aTrigger = Trigger::None, std::function<void (const uint16_t *, size_t)> aCallback = nullptr) :
+		BaseType{},
+		dma{
+			Dma::Dir::PeriphToMem,
+			Dma::Width::HalfWord,
+			false,
+			Dma::Width::HalfWord,
+			true,
+			BaseType::numberToDmaEvent(),
+			[this](uint32_t aFlags) { handler(aFlags); },
+			true},
+		callback{aCallback},
+		buffer{aBuffer},
+		samples{aSampleCount},
+		continuous{aTrigger == Trigger::None}
+	{
+		assert(aSampleCount > 0 && aSampleCount % (channels * oversampling * 2) == 0);
+
+		dma.enableHalfTransferInterrupt();
+
+		// Reset Control and Status registers in case of previous use this ADC periphery
+		ADC_CR2(kPeriph) = 0u;
+		ADC_CR1(kPeriph) = 0u;
+		ADC_SR(kPeriph) = 0u;
+
+		Time::delay(std::chrono::microseconds{3});
+
+		rcc_periph_clock_enable(BaseType::numberToClockBranch());
+		adc_set_clk_prescale(static_cast<uint32_t>(prescaler));
+
+		adc_enable_scan_mode(kPeriph);
+		adc_eoc_after_group(kPeriph);
+		adc_set_sample_time_on_all_channels(kPeriph, static_cast<uint8_t>(kSampleRate));
+
+		uint8_t channelArray[channels];
+
+		for (size_t i = 0; i < channels; ++i) {
+			channelArray[i] = static_cast<uint8_t>(aChannels[i]);
+		}
+		adc_set_regular_sequence(kPeriph, channels, channelArray);
+
+		adc_set_single_conversion_mode(kPeriph);
+
+		if (aTrigger == Trigger::None) {
+			adc_disable_external_trigger_regular(kPeriph);
+		} else {
+			const uint32_t trigger = static_cast<uint32_t>(aTrigger);
+			adc_enable_external_trigger_regular(kPeriph, trigger << ADC_CR2_EXTSEL_SHIFT, ADC_CR2_EXTEN_RISING_EDGE);
+		}
+
+		// DMA requests are issued after the last transfer of the buffer too, so circular mode works
+		adc_enable_dma(kPeriph);
+		adc_set_dma_continue(kPeriph);
+
+		adc_power_on(kPeriph);
+		// Wait 10 us for ADC power-up
+		Time::delay(std::chrono::microseconds{10});
+	}
+
+	~AdcBusBuffered() override
+	{
+		adc_power_off(kPeriph);
+		rcc_periph_clock_disable(BaseType::numberToClockBranch());
+	}
+
+	void setCallback(std::function<void (const uint16_t *, size_t)> aCallback)
+	{
+		callback = aCallback;
+	}
+
+	void start()
+	{
+		auto dst = reinterpret_cast<void *>(const_cast<uint32_t *>(&ADC_DR(kPeriph)));
+		dma.start(buffer, dst, samples);
+
+		// Sequences are converted back to back when there is no trigger
+		if (continuous) {
+			adc_set_continuous_conversion_mode(kPeriph);
+		}
+		adc_start_conversion_regular(kPeriph);
+	}
+
+	void stop()
+	{
+		adc_set_single_conversion_mode(kPeriph);
+		dma.stop();
+	}
+
+private:
+	DmaChannel<BaseType::numberToDmaController(), BaseType::numberToDmaStream()> dma;
+	std::function<void (const uint16_t *, size_t)> callback;
+	uint16_t * const buffer;
+	const size_t samples;
+	const bool continuous;
+
+	void handler(uint32_t aFlags)
+	{
+		if (!callback) {
+			return;
+		}
+
+		// Both flags are set when the interrupt was delayed for longer than a half of the buffer
+		if (aFlags & Dma::Flags::HalfTransfer) {
+			process(buffer);
+		}
+		if (aFlags & Dma::Flags::TransferComplete) {
+			process(buffer + (samples >> 1));
+		}
+	}
+
+	void process(uint16_t *aHalf)
+	{
+		// DMA writes to the other half of the buffer, so the samples are averaged in place
+		callback(aHalf, Averaging::reduce(aHalf, samples >> 1));
+	}
+};
+
+#endif // PLATFORM_STM32F76X_ADCBUSBUFFERED_HPP_
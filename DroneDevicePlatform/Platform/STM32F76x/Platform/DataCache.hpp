@@ -0,0 +1,67 @@
+//
+// DataCache.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_STM32F76X_DATACACHE_HPP_
+#define PLATFORM_STM32F76X_DATACACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+//!
+//! Maintenance of the data cache of Cortex-M7 by address, used around DMA transfers.
+//! Operations are harmless when the cache is disabled.
+//!
+class DataCache {
+public:
+	static constexpr size_t kLineSize{32};
+
+	DataCache() = delete;
+	DataCache(const DataCache &) = delete;
+	DataCache &operator=(const DataCache &) = delete;
+
+	//!
+	//! Write dirty lines of the buffer back to the memory and invalidate them. Called before
+	//! the DMA writes to the buffer, so evicted lines do not overwrite the data written by the DMA.
+	//!
+	static void cleanInvalidate(const void *aBuffer, size_t aLength)
+	{
+		maintain(kDccimvac, aBuffer, aLength);
+	}
+
+	//!
+	//! Discard cached lines of the buffer, called after the DMA wrote to the buffer.
+	//! Partially covered lines are discarded too, changes of neighbouring data made by the CPU
+	//! during the transfer are lost, so such buffers should be aligned to the cache line.
+	//!
+	static void invalidate(const void *aBuffer, size_t aLength)
+	{
+		maintain(kDcimvac, aBuffer, aLength);
+	}
+
+private:
+	static constexpr uintptr_t kDcimvac{0xE000EF5CUL};
+	static constexpr uintptr_t kDccimvac{0xE000EF70UL};
+
+	static void maintain(uintptr_t aRegister, const void *aBuffer, size_t aLength)
+	{
+		if (!aLength) {
+			return;
+		}
+
+		const uintptr_t end = reinterpret_cast<uintptr_t>(aBuffer) + aLength;
+		uintptr_t address = reinterpret_cast<uintptr_t>(aBuffer) & ~(kLineSize - 1);
+
+		__asm__ volatile ("dsb" : : : "memory");
+
+		for (; address < end; address += kLineSize) {
+			*reinterpret_cast<volatile uint32_t *>(aRegister) = static_cast<uint32_t>(address);
+		}
+
+		__asm__ volatile ("dsb\n\tisb" : : : "memory");
+	}
+};
+
+#endif // PLATFORM_STM32F76X_DATACACHE_HPP_
@@ -28,16 +28,20 @@ template<> DmaBase<2, 7> *DmaBase<2, 7>::instance = nullptr;
 template<unsigned int number, unsigned int channel>
 static void genericDmaHandler()
 {
+	// Flags of streams are placed at offsets 0, 6, 16 and 22 of the status registers
+	static constexpr unsigned int kShift{(channel & 1) * 6 + (channel & 2) * 8};
+	static constexpr uint32_t kMask{0x3DUL << kShift};
+
 	if (channel < 4) {
-		const uint32_t status = DMA_LISR(number == 1 ? DMA1 : DMA2);
+		const uint32_t status = DMA_LISR(number == 1 ? DMA1 : DMA2) & kMask;
 		DMA_LIFCR(number == 1 ? DMA1 : DMA2) = status;
 
-		DmaBase<number, channel>::handleIrq(status >> (channel * 8));
+		DmaBase<number, channel>::handleIrq(status >> kShift);
 	} else {
-		const uint32_t status = DMA_HISR(number == 1 ? DMA1 : DMA2);
+		const uint32_t status = DMA_HISR(number == 1 ? DMA1 : DMA2) & kMask;
 		DMA_HIFCR(number == 1 ? DMA1 : DMA2) = status;
 
-		DmaBase<number, channel>::handleIrq(status >> ((channel - 4) * 8));
+		DmaBase<number, channel>::handleIrq(status >> kShift);
 	}
 }
 
@@ -271,6 +271,16 @@ public:
 		DMA_SCR(kPeriph, kStream) &= ~DMA_SxCR_EN;
 	}
 
+	void disableHalfTransferInterrupt()
+	{
+		config &= ~DMA_SxCR_HTIE;
+	}
+
+	void enableHalfTransferInterrupt()
+	{
+		config |= DMA_SxCR_HTIE;
+	}
+
 private:
 	uint32_t config;
 	bool dir;
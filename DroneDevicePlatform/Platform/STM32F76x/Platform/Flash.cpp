@@ -0,0 +1,14 @@
+//
+// Flash.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "Platform/FlashEngine.hpp"
+
+FlashEngineBase *FlashEngineBase::instance = nullptr;
+
+void flash_isr()
+{
+	FlashEngineBase::handleIrq();
+}
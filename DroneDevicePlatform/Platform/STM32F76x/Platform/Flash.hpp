@@ -8,10 +8,12 @@
 #ifndef PLATFORM_STM32F76X_FLASH_HPP_
 #define PLATFORM_STM32F76X_FLASH_HPP_
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
+#include <limits>
 #include <libopencm3/stm32/flash.h>
 #include "Helpers.hpp"
 
@@ -22,9 +24,18 @@ enum class BorLevel: uint8_t {
 	VBOR3 = 0x00
 };
 
-template<BorLevel LEVEL = BorLevel::NONE>
+enum class FlashParallelism: uint8_t {
+	X8  = 0x00,
+	X16 = 0x01,
+	X32 = 0x02,
+	X64 = 0x03 // External Vpp is required
+};
+
+template<BorLevel LEVEL = BorLevel::NONE, FlashParallelism PARALLELISM = FlashParallelism::X32>
 class Flash {
 public:
+	static constexpr size_t kProgramUnit = 1 << static_cast<size_t>(PARALLELISM);
+
 	Flash() = delete;
 	Flash(const Flash &) = delete;
 	Flash &operator=(const Flash &) = delete;
@@ -56,19 +67,26 @@ public:
 
 	static bool erase(uintptr_t aOffset, size_t aLength)
 	{
-		const auto begin = addressToSector(aOffset);
-		const auto end = addressToSector(aOffset + aLength);
+		const uintptr_t end = aOffset + aLength;
 
 		flash_clear_status_flags();
 
-		for (size_t i = begin; i < end; ++i) {
-			if (!blankCheckSector(indexToEntry(i))) {
-				flash_erase_sector(static_cast<uint8_t>(i), FLASH_CR_PROGRAM_X32);
+		while (aOffset < end) {
+			const auto &entry = indexToEntry(addressToSector(aOffset));
+
+			if (entry.size == 0) {
+				flash_lock();
+				return false;
+			}
+
+			if (blankCheckSector(entry)) {
+				aOffset += entry.size;
+				continue;
+			}
 
-				if (FLASH_SR & (FLASH_SR_ERSERR | FLASH_SR_PGAERR | FLASH_SR_WRPERR)) {
-					flash_lock();
-					return false;
-				}
+			if (!startErase(aOffset) || !waitForOperation()) {
+				flash_lock();
+				return false;
 			}
 		}
 
@@ -83,19 +101,14 @@ public:
 
 	static bool write(uintptr_t aOffset, const void *aBuffer, size_t aLength)
 	{
-		assert(aOffset % 4 == 0);
+		assert(aOffset % kProgramUnit == 0);
 
 		const auto buffer = static_cast<const uint8_t *>(aBuffer);
 
 		flash_clear_status_flags();
 
-		for (size_t i = 0; i < aLength; i += 4) {
-			uint32_t word = std::numeric_limits<uint32_t>::max();
-
-			memcpy(&word, buffer + i, std::min(aLength - i, sizeof(word)));
-			flash_program_word(aOffset + i, word);
-
-			if (FLASH_SR & (FLASH_SR_ERSERR | FLASH_SR_PGAERR | FLASH_SR_WRPERR)) {
+		for (size_t i = 0; i < aLength; i += kProgramUnit) {
+			if (!startProgram(aOffset + i, buffer + i, aLength - i) || !waitForOperation()) {
 				flash_lock();
 				return false;
 			}
@@ -104,12 +117,108 @@ public:
 		return true;
 	}
 
+	// Non-blocking primitives used by FlashEngine
+
+	static void enableIrq()
+	{
+		FLASH_CR |= FLASH_CR_EOPIE | FLASH_CR_ERRIE;
+	}
+
+	static void disableIrq()
+	{
+		FLASH_CR &= ~(FLASH_CR_EOPIE | FLASH_CR_ERRIE);
+	}
+
+	static bool isBusy()
+	{
+		return (FLASH_SR & FLASH_SR_BSY) != 0;
+	}
+
+	//!
+	//! Start erase of the sector. Blank check is skipped to keep interrupt latency low.
+	//! \param address Sector address, advanced to the next sector.
+	//! \return False when the operation was rejected.
+	//!
+	static bool startErase(uintptr_t &aAddress)
+	{
+		const auto sector = addressToSector(aAddress);
+
+		const auto &entry = indexToEntry(sector);
+
+		// Unknown or misaligned address, the address would not advance
+		if (entry.size == 0) {
+			return false;
+		}
+
+		setMode(FLASH_CR_SER | (static_cast<uint32_t>(sector) << FLASH_CR_SNB_SHIFT));
+		FLASH_CR |= FLASH_CR_STRT;
+		aAddress += entry.size;
+
+		return (FLASH_SR & kErrorFlags) == 0;
+	}
+
+	//!
+	//! Start programming of the unit with configured parallelism,
+	//! missing bytes are filled with ones.
+	//! \return False when the operation was rejected.
+	//!
+	static bool startProgram(uintptr_t aAddress, const uint8_t *aBuffer, size_t aLength)
+	{
+		uint32_t unit[2] = {std::numeric_limits<uint32_t>::max(), std::numeric_limits<uint32_t>::max()};
+
+		memcpy(unit, aBuffer, std::min(aLength, kProgramUnit));
+
+		setMode(FLASH_CR_PG);
+
+		switch (PARALLELISM) {
+			case FlashParallelism::X8:
+				MMIO8(aAddress) = static_cast<uint8_t>(unit[0]);
+				break;
+
+			case FlashParallelism::X16:
+				MMIO16(aAddress) = static_cast<uint16_t>(unit[0]);
+				break;
+
+			case FlashParallelism::X32:
+				MMIO32(aAddress) = unit[0];
+				break;
+
+			case FlashParallelism::X64:
+				// Two consecutive word accesses are merged into a double word
+				MMIO32(aAddress) = unit[0];
+				MMIO32(aAddress + sizeof(uint32_t)) = unit[1];
+				break;
+		}
+
+		// Write buffer of the core should be drained before checking the status
+		__asm__ volatile ("dsb" : : : "memory");
+
+		return (FLASH_SR & kErrorFlags) == 0;
+	}
+
+	//!
+	//! Clear status flags of the completed operation.
+	//! \return True when the operation completed without errors.
+	//!
+	static bool finishOperation()
+	{
+		const uint32_t status = FLASH_SR;
+
+		FLASH_SR = FLASH_SR_EOP | kErrorFlags;
+		FLASH_CR &= ~(FLASH_CR_PG | FLASH_CR_SER);
+
+		return (status & kErrorFlags) == 0;
+	}
+
 private:
 	struct Entry {
 		uintptr_t address;
 		size_t size;
 	};
 
+	static constexpr uint32_t kErrorFlags = FLASH_SR_OPERR | FLASH_SR_WRPERR | FLASH_SR_PGAERR
+		| FLASH_SR_PGPERR | FLASH_SR_ERSERR;
+
 	static const Entry &indexToEntry(size_t aIndex)
 	{
 		static const std::array<Entry, 13> kSectors = {{
@@ -152,6 +261,20 @@ private:
 
 		return true;
 	}
+
+	static void setMode(uint32_t aMode)
+	{
+		static constexpr uint32_t kModeMask = (FLASH_CR_PROGRAM_MASK << FLASH_CR_PROGRAM_SHIFT)
+			| (FLASH_CR_SNB_MASK << FLASH_CR_SNB_SHIFT) | FLASH_CR_PG | FLASH_CR_SER;
+
+		FLASH_CR = (FLASH_CR & ~kModeMask) | (static_cast<uint32_t>(PARALLELISM) << FLASH_CR_PROGRAM_SHIFT) | aMode;
+	}
+
+	static bool waitForOperation()
+	{
+		while (isBusy());
+		return finishOperation();
+	}
 };
 
 #endif // PLATFORM_STM32F76X_FLASH_HPP_
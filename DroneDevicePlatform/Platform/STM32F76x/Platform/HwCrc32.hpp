@@ -8,25 +8,24 @@
 #ifndef PLATFORM_STM32F76X_HWCRC32_HPP_
 #define PLATFORM_STM32F76X_HWCRC32_HPP_
 
-#include <Platform/AsmHelpers.hpp>
+#include <DroneDevice/AcceleratedCrc32.hpp>
 #include <libopencm3/stm32/crc.h>
 #include <libopencm3/stm32/rcc.h>
-#include <cassert>
 #include <cstdint>
 
-class HwCrc32 {
+class HwCrc32Unit {
 public:
-	using Type = uint32_t;
-	static constexpr size_t size{sizeof(uint32_t)};
-
-	HwCrc32() = delete;
-	HwCrc32(const HwCrc32 &) = delete;
-	HwCrc32 &operator=(const HwCrc32 &) = delete;
+	HwCrc32Unit() = delete;
+	HwCrc32Unit(const HwCrc32Unit &) = delete;
+	HwCrc32Unit &operator=(const HwCrc32Unit &) = delete;
 
 	static void init()
 	{
 		rcc_periph_clock_enable(RCC_CRC);
 		rcc_periph_reset_pulse(RST_CRC);
+
+		CRC_CR = CRC_CR_REV_OUT | CRC_CR_REV_IN_WORD;
+		CRC_INIT = 0xFFFFFFFFUL;
 	}
 
 	static void deinit()
@@ -34,23 +33,46 @@ public:
 		rcc_periph_clock_disable(RCC_CRC);
 	}
 
-	static uint32_t update(uint32_t aChecksum, const void *aBuffer, size_t aLength)
+	static void reset()
 	{
-		// Buffer address and size should be aligned along 4-byte boundary
-		assert((aLength & 0x03) == 0);
-		assert((reinterpret_cast<uintptr_t>(aBuffer) & 0x03) == 0);
+		CRC_CR |= CRC_CR_RESET;
+	}
 
-		const uint32_t *data = static_cast<const uint32_t *>(aBuffer);
-		size_t wordLength = aLength >> 2;
+	static uint32_t state()
+	{
+		return CRC_DR;
+	}
+
+	static void feed(const uint32_t *aData, size_t aCount)
+	{
+		while (aCount--)
+			CRC_DR = *aData++;
+	}
+};
 
-		if (!aChecksum)
-			CRC_CR = CRC_CR_RESET;
+//!
+//! CRC32 with the same results as FastCrc32, buffers of any alignment and size are supported.
+//!
+class HwCrc32 : public AcceleratedCrc32<HwCrc32Unit> {
+public:
+	HwCrc32() = delete;
+	HwCrc32(const HwCrc32 &) = delete;
+	HwCrc32 &operator=(const HwCrc32 &) = delete;
 
-		while (wordLength--)
-			CRC_DR = reverseBits32(*data++);
+	static void init()
+	{
+		HwCrc32Unit::init();
+	}
 
-		return ~reverseBits32(CRC_DR);
+	static void deinit()
+	{
+		HwCrc32Unit::deinit();
 	}
 };
 
+//!
+//! Default CRC32 of the library, the unit is enabled on the first use.
+//!
+using PlatformCrc32 = AutoInitCrc32<HwCrc32>;
+
 #endif // PLATFORM_STM32F76X_HWCRC32_HPP_
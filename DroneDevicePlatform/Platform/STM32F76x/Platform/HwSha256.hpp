@@ -0,0 +1,145 @@
+//
+// HwSha256.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_STM32F76X_HWSHA256_HPP_
+#define PLATFORM_STM32F76X_HWSHA256_HPP_
+
+#include <libopencm3/cm3/common.h>
+#include <libopencm3/stm32/rcc.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+//!
+//! SHA-256 calculated by the HASH processor, the interface is the same as of the Sha256 class.
+//! The processor is available only on STM32F756, STM32F777 and STM32F779 devices,
+//! the software implementation should be used on other parts of the family.
+//! There is a single processor in the system, so only one calculation may be active at a time.
+//!
+class HwSha256 {
+public:
+	HwSha256()
+	{
+		reset();
+	}
+
+	static void init()
+	{
+		rcc_periph_clock_enable(RCC_HASH);
+		rcc_periph_reset_pulse(RST_HASH);
+	}
+
+	static void deinit()
+	{
+		rcc_periph_clock_disable(RCC_HASH);
+	}
+
+	void reset()
+	{
+		pending = 0;
+
+		// Bytes are swapped by the processor, so words can be loaded from memory without reordering
+		hashCr() = kCrAlgoSha256 | kCrDatatype8Bit | kCrInit;
+	}
+
+	void update(const uint8_t *aData, size_t aLength)
+	{
+		// Complete the word collected by previous calls
+		while (pending > 0 && pending < sizeof(uint32_t) && aLength > 0) {
+			word[pending++] = *aData++;
+			--aLength;
+		}
+
+		if (pending == sizeof(uint32_t)) {
+			push(word);
+			pending = 0;
+		}
+
+		// Writes are stalled by the processor when the input FIFO is full
+		while (aLength >= sizeof(uint32_t)) {
+			push(aData);
+			aData += sizeof(uint32_t);
+			aLength -= sizeof(uint32_t);
+		}
+
+		while (aLength--) {
+			word[pending++] = *aData++;
+		}
+	}
+
+	std::array<uint8_t, 32> finalize()
+	{
+		std::array<uint8_t, 32> hash;
+
+		if (pending > 0) {
+			memset(word + pending, 0, sizeof(word) - pending);
+			push(word);
+		}
+
+		// Number of valid bits in the last word, zero when the word is complete
+		hashStr() = static_cast<uint32_t>(pending * 8);
+		hashStr() = static_cast<uint32_t>(pending * 8) | kStrDcal;
+
+		while (!(hashSr() & kSrDcis)) {
+		}
+
+		for (size_t i = 0; i < 8; ++i) {
+			const uint32_t value = MMIO32(kBase + kHrOffset + i * sizeof(uint32_t));
+
+			hash[i * 4 + 0] = static_cast<uint8_t>(value >> 24);
+			hash[i * 4 + 1] = static_cast<uint8_t>(value >> 16);
+			hash[i * 4 + 2] = static_cast<uint8_t>(value >> 8);
+			hash[i * 4 + 3] = static_cast<uint8_t>(value);
+		}
+
+		pending = 0;
+		return hash;
+	}
+
+private:
+	static constexpr uint32_t kBase{0x50060400UL};
+	static constexpr uint32_t kHrOffset{0x310};
+
+	static constexpr uint32_t kCrInit{1UL << 2};
+	static constexpr uint32_t kCrDatatype8Bit{2UL << 4};
+	static constexpr uint32_t kCrAlgoSha256{(1UL << 18) | (1UL << 7)};
+	static constexpr uint32_t kStrDcal{1UL << 8};
+	static constexpr uint32_t kSrDcis{1UL << 1};
+
+	uint8_t word[sizeof(uint32_t)];
+	size_t pending;
+
+	static volatile uint32_t &hashCr()
+	{
+		return MMIO32(kBase + 0x00);
+	}
+
+	static volatile uint32_t &hashDin()
+	{
+		return MMIO32(kBase + 0x04);
+	}
+
+	static volatile uint32_t &hashStr()
+	{
+		return MMIO32(kBase + 0x08);
+	}
+
+	static volatile uint32_t &hashSr()
+	{
+		return MMIO32(kBase + 0x24);
+	}
+
+	static void push(const uint8_t *aData)
+	{
+		uint32_t value;
+
+		memcpy(&value, aData, sizeof(value));
+		hashDin() = value;
+	}
+};
+
+#endif // PLATFORM_STM32F76X_HWSHA256_HPP_
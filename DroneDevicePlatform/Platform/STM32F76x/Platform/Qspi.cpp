@@ -0,0 +1,14 @@
+//
+// Qspi.cpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#include "Platform/QspiEngine.hpp"
+
+QspiEngineBase *QspiEngineBase::instance = nullptr;
+
+void quadspi_isr()
+{
+	QspiEngineBase::handleIrq();
+}
@@ -0,0 +1,227 @@
+//
+// QspiEngine.hpp
+//
+//  Created on: Oct 19, 2026
+//
+
+#ifndef PLATFORM_STM32F76X_QSPIENGINE_HPP_
+#define PLATFORM_STM32F76X_QSPIENGINE_HPP_
+
+#include <DroneDevice/InplaceFunction.hpp>
+#include <DroneDevice/InternalDevice/FlashFile.hpp>
+#include <DroneDevice/Queue.hpp>
+#include <Platform/QspiFlash.hpp>
+#include <libopencm3/cm3/nvic.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+class QspiEngineBase {
+public:
+	virtual ~QspiEngineBase() = default;
+
+	static void handleIrq()
+	{
+		instance->handler();
+	}
+
+protected:
+	virtual void handler() = 0;
+
+	static void setHandler(QspiEngineBase *aInstance)
+	{
+		instance = aInstance;
+	}
+
+private:
+	static QspiEngineBase *instance;
+};
+
+//!
+//! Non-blocking erase and program engine for the external memory. The end of each
+//! operation is detected by the status polling of the QUADSPI, the next operation is
+//! started from the status match interrupt. Synchronous QspiFlash calls must not be
+//! mixed with queued jobs, memory-mapped mode is restored when the queue becomes empty.
+//!
+template<size_t capacity = 4>
+class QspiEngine : public QspiEngineBase {
+public:
+	//! Completion callback, called from the interrupt handler with the job status, never uses the heap
+	using Callback = InplaceFunction<void (bool)>;
+
+	QspiEngine() :
+		jobs{},
+		active{false},
+		mapped{false}
+	{
+		QspiEngineBase::setHandler(this);
+
+		nvic_clear_pending_irq(NVIC_QUADSPI_IRQ);
+		nvic_enable_irq(NVIC_QUADSPI_IRQ);
+	}
+
+	~QspiEngine() override
+	{
+		nvic_disable_irq(NVIC_QUADSPI_IRQ);
+		QspiEngineBase::setHandler(nullptr);
+	}
+
+	//!
+	//! Queue erase of blocks, 64 Kb blocks are used where possible and 32 Kb blocks otherwise.
+	//! \param offset Offset of the region aligned along 32 Kb boundary.
+	//! \param length Length of the region.
+	//! \param callback Completion callback.
+	//! \return False when the region is not aligned along 32 Kb boundary, is out of the memory or the queue is full.
+	//!
+	bool erase(uintptr_t aOffset, size_t aLength, Callback aCallback = nullptr)
+	{
+		// Erase of the last block would wipe data after the region otherwise
+		if (aOffset % W25Defs::kBlock32kbSize != 0 || aLength % W25Defs::kBlock32kbSize != 0
+			|| aOffset + aLength > W25Defs::kSizeLimit) {
+			return false;
+		}
+
+		return enqueue(Job{aOffset, aOffset + aLength, nullptr, aCallback});
+	}
+
+	//!
+	//! Queue programming of the buffer, the buffer is split into pages.
+	//! The buffer must stay valid until the callback is called.
+	//! \param offset Offset in the memory.
+	//! \param buffer Pointer to buffer with at least @b length characters of data.
+	//! \param length Buffer length.
+	//! \param callback Completion callback.
+	//! \return False when the queue is full.
+	//!
+	bool write(uintptr_t aOffset, const void *aBuffer, size_t aLength, Callback aCallback = nullptr)
+	{
+		return enqueue(Job{aOffset, aOffset + aLength, static_cast<const uint8_t *>(aBuffer), aCallback});
+	}
+
+	bool isBusy() const
+	{
+		return active;
+	}
+
+protected:
+	void handler() override
+	{
+		if (!active || !QspiFlash::finishPolling()) {
+			return;
+		}
+
+		advance(true);
+	}
+
+private:
+	struct Job {
+		uintptr_t address;
+		uintptr_t end;
+		const uint8_t *buffer;
+		Callback callback;
+	};
+
+	Queue<Job, capacity> jobs;
+	volatile bool active;
+	bool mapped;
+
+	bool enqueue(const Job &aJob)
+	{
+		bool result = false;
+
+		nvic_disable_irq(NVIC_QUADSPI_IRQ);
+
+		if (!jobs.full()) {
+			jobs.push(aJob);
+			result = true;
+
+			if (!active) {
+				active = true;
+				mapped = QspiFlash::isMemoryMapped();
+				QspiFlash::disableMemoryMapped();
+
+				if (QspiFlash::ready()) {
+					advance(true);
+				} else {
+					// Memory is still busy, the first job is started from the status match interrupt
+					QspiFlash::startPolling();
+				}
+			}
+		}
+
+		nvic_enable_irq(NVIC_QUADSPI_IRQ);
+		return result;
+	}
+
+	bool issue(Job &aJob)
+	{
+		if (aJob.buffer != nullptr) {
+			// Page program is limited by the page boundary
+			const size_t length = std::min<size_t>(aJob.end - aJob.address,
+				W25Defs::kPageSize - aJob.address % W25Defs::kPageSize);
+			const bool result = QspiFlash::startProgram(aJob.address, aJob.buffer, length);
+
+			aJob.address += length;
+			aJob.buffer += length;
+			return result;
+		} else {
+			return QspiFlash::startErase(aJob.address, aJob.end);
+		}
+	}
+
+	void advance(bool aStatus)
+	{
+		while (!jobs.empty()) {
+			Job &job = jobs.front();
+
+			if (aStatus && job.address < job.end) {
+				if (issue(job)) {
+					// Wait for the status match interrupt
+					QspiFlash::startPolling();
+					return;
+				}
+
+				aStatus = false;
+			}
+
+			// Callback may queue the next job, so the slot is released before the call
+			const Callback callback{std::move(jobs.front().callback)};
+
+			jobs.pop();
+
+			if (callback != nullptr) {
+				callback(aStatus);
+			}
+			aStatus = true;
+		}
+
+		if (mapped) {
+			QspiFlash::enableMemoryMapped();
+		}
+		active = false;
+	}
+};
+
+//!
+//! File stored in the external memory, programming may be delegated to QspiEngine with setEngine().
+//! \tparam offset Offset of the region in the memory.
+//!
+template<uintptr_t offset, size_t capacity, size_t bufferSize = W25Defs::kPageSize>
+class QspiFile : public Device::FlashFile<QspiFlash, offset, capacity, bufferSize> {
+	static_assert(offset % W25Defs::kBlock32kbSize == 0 && capacity % W25Defs::kBlock32kbSize == 0,
+		"Region should be aligned along erase blocks");
+
+public:
+	using Device::FlashFile<QspiFlash, offset, capacity, bufferSize>::FlashFile;
+
+	//!
+	//! Pointer to the content of the file, the memory should be in memory-mapped mode.
+	//!
+	const void *data() const
+	{
+		return static_cast<const uint8_t *>(QspiFlash::data()) + offset;
+	}
+};
+
+#endif // PLATFORM_STM32F76X_QSPIENGINE_HPP_
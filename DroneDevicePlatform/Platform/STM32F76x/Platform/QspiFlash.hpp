@@ -8,14 +8,20 @@
 #ifndef PLATFORM_STM32F76X_QSPI_FLASH_HPP_
 #define PLATFORM_STM32F76X_QSPI_FLASH_HPP_
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <limits>
 #include <libopencm3/stm32/rcc.h>
 #include <libopencm3/stm32/gpio.h>
 #include <libopencm3/stm32/quadspi.h>
+#include <Platform/DataCache.hpp>
+#include <Platform/Dma.hpp>
 
 namespace W25Defs {
 
 static constexpr uint8_t BLOCK_64KB_ERASE = 0xD8;
+static constexpr uint8_t BLOCK_32KB_ERASE = 0x52;
 static constexpr uint8_t QUAD_READ = 0x6B;
 static constexpr uint8_t READ_STATUS_REG_1 = 0x05;
 static constexpr uint8_t READ_STATUS_REG_2 = 0x35;
@@ -26,6 +32,7 @@ static constexpr uint8_t REGISTER_QUAD_ENABLE = 0x02;
 static constexpr size_t kPageSize{0x100};
 static constexpr size_t kSizeLimit{0x1000000};
 static constexpr size_t kBlock64kbSize{0x010000};
+static constexpr size_t kBlock32kbSize{0x008000};
 
 } // namespace W25Defs
 
@@ -93,108 +100,329 @@ public:
 		if (aLength == 0) {
 			return true;
 		}
-		if (readStatusReg1() == 0xFF) {
-			return false;
+
+		if (*memoryMapped()) {
+			memcpy(aBuffer, reinterpret_cast<const void *>(kMappedAddress + aOffset), aLength);
+			return true;
 		}
 
-		uint32_t ccr;
-		uint32_t sr;
-		uint8_t flashReg;
+		if (!waitForReady()) {
+			return false;
+		}
 
 		auto buffer = static_cast<uint8_t *>(aBuffer);
-		// Data buf length
-		QUADSPI_DLR = aLength - 1;
-		// 1-1-4 reading; 8 dummy clock
-		ccr = ((QUADSPI_CCR_FMODE_IREAD & QUADSPI_CCR_FMODE_MASK) << QUADSPI_CCR_FMODE_SHIFT);
-		ccr |= ((QUADSPI_CCR_MODE_4LINE & QUADSPI_CCR_DMODE_MASK) << QUADSPI_CCR_DMODE_SHIFT);
-		ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_IMODE_MASK) << QUADSPI_CCR_IMODE_SHIFT);
-		ccr |= ((2 & QUADSPI_CCR_ADSIZE_MASK) << QUADSPI_CCR_ADSIZE_SHIFT);
-		ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_ADMODE_MASK) << QUADSPI_CCR_ADMODE_SHIFT);
-		ccr |= ((W25Defs::QUAD_READ & QUADSPI_CCR_INST_MASK) << QUADSPI_CCR_INST_SHIFT);
-		ccr |= ((8 & QUADSPI_CCR_DCYC_MASK) << QUADSPI_CCR_DCYC_SHIFT);
-		QUADSPI_CCR = ccr;
-		QUADSPI_AR = aOffset;
 
-		// Reading process
-		do {
-			sr = QUADSPI_SR;
-			if (sr & QUADSPI_SR_FTF) {
+		startRead(aOffset, aLength);
+
+		// Reading process, the FIFO is drained with word accesses while possible
+		while (aLength >= sizeof(uint32_t)) {
+			if (fifoLevel() >= sizeof(uint32_t)) {
+				const uint32_t word = QUADSPI_DR;
+
+				memcpy(buffer, &word, sizeof(word));
+				buffer += sizeof(word);
+				aLength -= sizeof(word);
+			}
+		}
+		while (aLength) {
+			if (fifoLevel() > 0) {
 				*buffer = QUADSPI_BYTE_DR;
 				++buffer;
+				--aLength;
 			}
-		} while (sr & QUADSPI_SR_BUSY);
-		QUADSPI_FCR = 0x1F;
+		}
 
-		// Waiting for completion
-		do {
-			flashReg = readStatusReg1();
-			if (flashReg == 0xFF) {
-				return false;
-			}
-		} while (flashReg & 0x01);
+		waitForCompletion();
+		return true;
+	}
+
+	//!
+	//! Read data using the DMA, the CPU is only used to read the unaligned tail of the buffer.
+	//! \tparam stream DMA2 stream connected to the QUADSPI request, stream 2 or 7.
+	//! \tparam channel Channel of the stream, 11 for stream 2 and 3 for stream 7.
+	//! \param offset Offset in the memory.
+	//! \param buffer Destination buffer, should be aligned along 4-byte boundary to be filled by the DMA.
+	//! Cached lines of the buffer are invalidated after the transfer, data sharing the first or the last
+	//! line with the buffer must not be modified by interrupts during the read, so buffers aligned
+	//! to DataCache::kLineSize are preferred.
+	//! \param length Buffer length.
+	//! \return True on success.
+	//!
+	template<unsigned int stream = 7, unsigned int channel = 3>
+	static bool readDma(uintptr_t aOffset, void *aBuffer, size_t aLength)
+	{
+		static_assert((stream == 7 && channel == 3) || (stream == 2 && channel == 11), "Incorrect DMA stream");
+
+		if (aOffset + aLength > W25Defs::kSizeLimit) {
+			return false;
+		}
+		if (*memoryMapped() || (reinterpret_cast<uintptr_t>(aBuffer) & 0x03) != 0) {
+			return read(aOffset, aBuffer, aLength);
+		}
+		if (!waitForReady()) {
+			return false;
+		}
+
+		static volatile bool done;
+		static DmaChannel<2, stream> dma{Dma::Dir::PeriphToMem, Dma::Width::Word, false, Dma::Width::Word, true,
+			channel, [](uint32_t) { done = true; }, false, Dma::Priority::High};
+
+		auto buffer = static_cast<uint8_t *>(aBuffer);
+		size_t words = aLength / sizeof(uint32_t);
+
+		// Dirty lines evicted during the transfer would overwrite the data written by the DMA
+		DataCache::cleanInvalidate(buffer, words * sizeof(uint32_t));
+
+		// DMA requests are generated when at least one word is available in the FIFO
+		QUADSPI_CR = (QUADSPI_CR & ~(QUADSPI_CR_FTHRES_MASK << QUADSPI_CR_FTHRES_SHIFT))
+			| ((3 & QUADSPI_CR_FTHRES_MASK) << QUADSPI_CR_FTHRES_SHIFT) | QUADSPI_CR_DMAEN;
+
+		while (words) {
+			const size_t count = std::min<size_t>(words, std::numeric_limits<uint16_t>::max());
+
+			done = false;
+			dma.start(buffer, reinterpret_cast<const void *>(const_cast<uint32_t *>(&QUADSPI_DR)), count);
+			startRead(aOffset, count * sizeof(uint32_t));
+
+			while (!done);
+			waitForCompletion();
+
+			buffer += count * sizeof(uint32_t);
+			aOffset += count * sizeof(uint32_t);
+			aLength -= count * sizeof(uint32_t);
+			words -= count;
+		}
+
+		QUADSPI_CR &= ~(QUADSPI_CR_DMAEN | (QUADSPI_CR_FTHRES_MASK << QUADSPI_CR_FTHRES_SHIFT));
+		DataCache::invalidate(aBuffer, static_cast<size_t>(buffer - static_cast<uint8_t *>(aBuffer)));
+
+		return read(aOffset, buffer, aLength);
+	}
+
+	//!
+	//! Map the memory to the address space of the processor, indirect reads become memory copies.
+	//! Erase and write operations temporarily leave memory-mapped mode.
+	//! \return True on success.
+	//!
+	static bool enableMemoryMapped()
+	{
+		if (*memoryMapped()) {
+			return true;
+		}
+		if (!waitForReady()) {
+			return false;
+		}
+
+		QUADSPI_CCR = makeReadCommand(QUADSPI_CCR_FMODE_MEMMAP);
+		*memoryMapped() = true;
 
 		return true;
 	}
 
+	static void disableMemoryMapped()
+	{
+		if (*memoryMapped()) {
+			abort();
+			*memoryMapped() = false;
+		}
+	}
+
+	//!
+	//! Pointer to the memory in memory-mapped mode.
+	//!
+	static const void *data()
+	{
+		return reinterpret_cast<const void *>(kMappedAddress);
+	}
+
 	static bool ready()
 	{
+		// Operations with memory are not started in memory-mapped mode
+		if (*memoryMapped()) {
+			return true;
+		}
+
 		const auto reg = readStatusReg1();
 		return (reg != 0xFF) && ((reg & 0x01) == 0);
 	}
 
-	// Erase block 64 Kb
+	// Erase blocks of 32 Kb or 64 Kb
 	static bool erase(uintptr_t aOffset, size_t aLength)
 	{
-		// Adress + buf length are inside nor flash limits
-		if (aLength < W25Defs::kBlock64kbSize || aOffset > W25Defs::kSizeLimit - W25Defs::kBlock64kbSize) {
-			return false;
+		const bool mapped = *memoryMapped();
+
+		disableMemoryMapped();
+		const bool result = eraseBlocks(aOffset, aLength);
+
+		if (mapped) {
+			enableMemoryMapped();
 		}
-		if (aOffset % W25Defs::kBlock64kbSize != 0 || aLength % W25Defs::kBlock64kbSize != 0) {
+
+		return result;
+	}
+
+	static bool write(uintptr_t aOffset, const void *aBuffer, size_t aLength)
+	{
+		const bool mapped = *memoryMapped();
+
+		disableMemoryMapped();
+		const bool result = writePages(aOffset, aBuffer, aLength);
+
+		if (mapped) {
+			enableMemoryMapped();
+		}
+
+		return result;
+	}
+
+	static bool isMemoryMapped()
+	{
+		return *memoryMapped();
+	}
+
+	//!
+	//! Start erase of the largest block which fits into the region, memory-mapped mode should be disabled.
+	//! \param address Address of the block, advanced to the next block.
+	//! \param end End of the region.
+	//! \return True when the operation was started.
+	//!
+	static bool startErase(uintptr_t &aAddress, uintptr_t aEnd)
+	{
+		if (aAddress % W25Defs::kBlock32kbSize != 0 || aEnd > W25Defs::kSizeLimit) {
 			return false;
 		}
-		if (aOffset + aLength > W25Defs::kSizeLimit) {
+
+		const bool large = aAddress % W25Defs::kBlock64kbSize == 0 && aEnd - aAddress >= W25Defs::kBlock64kbSize;
+		const uint8_t command = large ? W25Defs::BLOCK_64KB_ERASE : W25Defs::BLOCK_32KB_ERASE;
+		uint32_t ccr;
+
+		writeEnable();
+		// 1-1 write mode; no data
+		ccr = ((QUADSPI_CCR_FMODE_IWRITE & QUADSPI_CCR_FMODE_MASK) << QUADSPI_CCR_FMODE_SHIFT);
+		ccr |= ((2 & QUADSPI_CCR_ADSIZE_MASK) << QUADSPI_CCR_ADSIZE_SHIFT);
+		ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_ADMODE_MASK) << QUADSPI_CCR_ADMODE_SHIFT);
+		ccr |= ((command & QUADSPI_CCR_INST_MASK) << QUADSPI_CCR_INST_SHIFT);
+		ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_IMODE_MASK) << QUADSPI_CCR_IMODE_SHIFT);
+		QUADSPI_CCR = ccr;
+		QUADSPI_AR = aAddress;
+		waitForCompletion();
+
+		aAddress += large ? W25Defs::kBlock64kbSize : W25Defs::kBlock32kbSize;
+		return true;
+	}
+
+	//!
+	//! Start quad input programming of the data within a page, memory-mapped mode should be disabled.
+	//! \param offset Offset in the memory.
+	//! \param buffer Pointer to buffer with at least @b length characters of data.
+	//! \param length Buffer length, the data should not cross the page boundary.
+	//! \return True when the operation was started.
+	//!
+	static bool startProgram(uintptr_t aOffset, const uint8_t *aBuffer, size_t aLength)
+	{
+		if (aLength == 0 || aOffset % W25Defs::kPageSize + aLength > W25Defs::kPageSize
+			|| aOffset + aLength > W25Defs::kSizeLimit) {
 			return false;
 		}
 
 		uint32_t ccr;
-		uint32_t sr;
-		uint8_t flashReg;
-		uintptr_t currentOffset = aOffset;
 
-		do {
-			writeEnable();
-			// 1-1 write mode; no data
-			ccr = ((QUADSPI_CCR_FMODE_IWRITE & QUADSPI_CCR_FMODE_MASK) << QUADSPI_CCR_FMODE_SHIFT);
-			ccr |= ((2 & QUADSPI_CCR_ADSIZE_MASK) << QUADSPI_CCR_ADSIZE_SHIFT);
-			ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_ADMODE_MASK) << QUADSPI_CCR_ADMODE_SHIFT);
-			ccr |= ((W25Defs::BLOCK_64KB_ERASE & QUADSPI_CCR_INST_MASK) << QUADSPI_CCR_INST_SHIFT);
-			ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_IMODE_MASK) << QUADSPI_CCR_IMODE_SHIFT);
-			QUADSPI_CCR = ccr;
-			QUADSPI_AR = currentOffset;
-			do {
-				sr = QUADSPI_SR;
-			} while (sr & QUADSPI_SR_BUSY);
-			QUADSPI_FCR = 0x1F;
-
-			// Waiting for cleaning completion
-			do {
-				flashReg = readStatusReg1();
-				if (flashReg == 0xFF) {
-					return false;
-				}
-			} while (flashReg & 0x01);
+		writeEnable();
+
+		QUADSPI_DLR = aLength - 1;
+		ccr = ((W25Defs::QUAD_PAGE_PROGRAM & QUADSPI_CCR_INST_MASK) << QUADSPI_CCR_INST_SHIFT);
+		ccr |= ((QUADSPI_CCR_FMODE_IWRITE & QUADSPI_CCR_FMODE_MASK) << QUADSPI_CCR_FMODE_SHIFT);
+		ccr |= ((QUADSPI_CCR_MODE_4LINE & QUADSPI_CCR_DMODE_MASK) << QUADSPI_CCR_DMODE_SHIFT);
+		ccr |= ((2 & QUADSPI_CCR_ADSIZE_MASK) << QUADSPI_CCR_ADSIZE_SHIFT);
+		ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_ADMODE_MASK) << QUADSPI_CCR_ADMODE_SHIFT);
+		ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_IMODE_MASK) << QUADSPI_CCR_IMODE_SHIFT);
+		QUADSPI_CCR = ccr;
+		QUADSPI_AR = aOffset;
+
+		// Writes are stalled while the FIFO is full
+		while (aLength >= sizeof(uint32_t)) {
+			uint32_t word;
+
+			memcpy(&word, aBuffer, sizeof(word));
+			QUADSPI_DR = word;
+			aBuffer += sizeof(word);
+			aLength -= sizeof(word);
+		}
+		while (aLength--) {
+			QUADSPI_BYTE_DR = *aBuffer++;
+		}
+		waitForCompletion();
+
+		return true;
+	}
+
+	//!
+	//! Start polling of the status register by the QUADSPI, status match interrupt
+	//! is generated when the memory finishes the operation.
+	//!
+	static void startPolling()
+	{
+		uint32_t ccr;
+
+		QUADSPI_PSMKR = 0x01;
+		QUADSPI_PSMAR = 0x00;
+		QUADSPI_PIR = 0x10;
+		QUADSPI_DLR = 0x00;
+		QUADSPI_CR |= QUADSPI_CR_APMS | QUADSPI_CR_SMIE;
 
-			currentOffset += W25Defs::kBlock64kbSize;
-			if (currentOffset >= aOffset + aLength) {
-				return true;
+		ccr = ((W25Defs::READ_STATUS_REG_1 & QUADSPI_CCR_INST_MASK) << QUADSPI_CCR_INST_SHIFT);
+		ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_IMODE_MASK) << QUADSPI_CCR_IMODE_SHIFT);
+		ccr |= ((QUADSPI_CCR_FMODE_APOLL & QUADSPI_CCR_FMODE_MASK) << QUADSPI_CCR_FMODE_SHIFT);
+		ccr |= ((QUADSPI_CCR_MODE_NONE & QUADSPI_CCR_ADMODE_MASK) << QUADSPI_CCR_ADMODE_SHIFT);
+		ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_DMODE_MASK) << QUADSPI_CCR_DMODE_SHIFT);
+		QUADSPI_CCR = ccr;
+	}
+
+	//!
+	//! Finish polling of the status register.
+	//! \return True when the memory is ready.
+	//!
+	static bool finishPolling()
+	{
+		if (!(QUADSPI_SR & QUADSPI_SR_SMF)) {
+			return false;
+		}
+
+		QUADSPI_CR &= ~(QUADSPI_CR_APMS | QUADSPI_CR_SMIE);
+		waitForCompletion();
+
+		return true;
+	}
+
+	static void setInterface(QspiFlash *aInterface)
+	{
+		// Singleton pattern implementation
+		*interfaceImpl() = aInterface;
+	}
+
+private:
+	// Memory bank of the QUADSPI in the address space
+	static constexpr uintptr_t kMappedAddress{0x90000000UL};
+
+	static bool eraseBlocks(uintptr_t aOffset, size_t aLength)
+	{
+		// Adress + buf length are inside nor flash limits
+		if (aLength == 0 || aLength % W25Defs::kBlock32kbSize != 0 || aOffset + aLength > W25Defs::kSizeLimit) {
+			return false;
+		}
+
+		const uintptr_t end = aOffset + aLength;
+
+		while (aOffset < end) {
+			if (!startErase(aOffset, end) || !waitForReady()) {
+				return false;
 			}
-			// Until the end of NOR flash will be reached or set value
-		} while (currentOffset < W25Defs::kSizeLimit);
+		}
 
 		return true;
 	}
 
-	static bool write(uintptr_t aOffset, const void *aBuffer, size_t aLength)
+	static bool writePages(uintptr_t aOffset, const void *aBuffer, size_t aLength)
 	{
 		// Adress + buf length are inside nor flash limits
 		if (aOffset + aLength > W25Defs::kSizeLimit) {
@@ -217,7 +445,9 @@ public:
 					return writePage(currentOffset, buffer, bytesToWrite);
 				} else {
 					// But buffer length is larger than page
-					writePage(currentOffset, buffer, W25Defs::kPageSize);
+					if (!writePage(currentOffset, buffer, W25Defs::kPageSize)) {
+						return false;
+					}
 					buffer = buffer + W25Defs::kPageSize;
 					bytesToWrite -= W25Defs::kPageSize;
 					currentOffset += W25Defs::kPageSize;
@@ -229,7 +459,9 @@ public:
 				if (bytesToWrite < bytesToNextPage) {
 					return writePage(currentOffset, buffer, bytesToWrite);
 				} else {
-					writePage(currentOffset, buffer, bytesToNextPage);
+					if (!writePage(currentOffset, buffer, bytesToNextPage)) {
+						return false;
+					}
 					buffer = buffer + bytesToNextPage;
 					bytesToWrite -= bytesToNextPage;
 					currentOffset += bytesToNextPage;
@@ -239,13 +471,12 @@ public:
 		return true;
 	}
 
-	static void setInterface(QspiFlash *aInterface)
+	static bool *memoryMapped()
 	{
-		// Singleton pattern implementation
-		*interfaceImpl() = aInterface;
+		static bool state;
+		return &state;
 	}
 
-private:
 	static QspiFlash **interfaceImpl()
 	{
 		// Singleton pattern implementation
@@ -324,6 +555,62 @@ private:
 		return reg;
 	}
 
+	static uint32_t makeReadCommand(uint32_t aMode)
+	{
+		// 1-1-4 reading; 8 dummy clock
+		uint32_t ccr;
+
+		ccr = ((aMode & QUADSPI_CCR_FMODE_MASK) << QUADSPI_CCR_FMODE_SHIFT);
+		ccr |= ((QUADSPI_CCR_MODE_4LINE & QUADSPI_CCR_DMODE_MASK) << QUADSPI_CCR_DMODE_SHIFT);
+		ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_IMODE_MASK) << QUADSPI_CCR_IMODE_SHIFT);
+		ccr |= ((2 & QUADSPI_CCR_ADSIZE_MASK) << QUADSPI_CCR_ADSIZE_SHIFT);
+		ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_ADMODE_MASK) << QUADSPI_CCR_ADMODE_SHIFT);
+		ccr |= ((W25Defs::QUAD_READ & QUADSPI_CCR_INST_MASK) << QUADSPI_CCR_INST_SHIFT);
+		ccr |= ((8 & QUADSPI_CCR_DCYC_MASK) << QUADSPI_CCR_DCYC_SHIFT);
+
+		return ccr;
+	}
+
+	static void startRead(uintptr_t aOffset, size_t aLength)
+	{
+		// Writing of the address starts the transfer
+		QUADSPI_DLR = aLength - 1;
+		QUADSPI_CCR = makeReadCommand(QUADSPI_CCR_FMODE_IREAD);
+		QUADSPI_AR = aOffset;
+	}
+
+	static size_t fifoLevel()
+	{
+		return (QUADSPI_SR >> QUADSPI_SR_FLEVEL_SHIFT) & QUADSPI_SR_FLEVEL_MASK;
+	}
+
+	static void waitForCompletion()
+	{
+		while (QUADSPI_SR & QUADSPI_SR_BUSY);
+		QUADSPI_FCR = 0x1F;
+	}
+
+	static bool waitForReady()
+	{
+		uint8_t flashReg;
+
+		do {
+			flashReg = readStatusReg1();
+			if (flashReg == 0xFF) {
+				return false;
+			}
+		} while (flashReg & 0x01);
+
+		return true;
+	}
+
+	static void abort()
+	{
+		QUADSPI_CR |= QUADSPI_CR_ABORT;
+		while (QUADSPI_CR & QUADSPI_CR_ABORT);
+		waitForCompletion();
+	}
+
 	static void setCrDcrRegister()
 	{
 		// STM32 control register: frequency prescaler, fifo threshold level, sample shift
@@ -344,41 +631,7 @@ private:
 	static bool writePage(uintptr_t aOffset, const uint8_t *aBuffer, size_t aLength)
 	{
 		// Writing within page
-		uint32_t ccr;
-		uint32_t sr;
-		uint8_t flashReg;
-
-		writeEnable();
-
-		QUADSPI_DLR = aLength - 1;
-		ccr = ((W25Defs::QUAD_PAGE_PROGRAM & QUADSPI_CCR_INST_MASK) << QUADSPI_CCR_INST_SHIFT);
-		ccr |= ((QUADSPI_CCR_FMODE_IWRITE & QUADSPI_CCR_FMODE_MASK) << QUADSPI_CCR_FMODE_SHIFT);
-		ccr |= ((QUADSPI_CCR_MODE_4LINE & QUADSPI_CCR_DMODE_MASK) << QUADSPI_CCR_DMODE_SHIFT);
-		ccr |= ((2 & QUADSPI_CCR_ADSIZE_MASK) << QUADSPI_CCR_ADSIZE_SHIFT);
-		ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_ADMODE_MASK) << QUADSPI_CCR_ADMODE_SHIFT);
-		ccr |= ((QUADSPI_CCR_MODE_1LINE & QUADSPI_CCR_IMODE_MASK) << QUADSPI_CCR_IMODE_SHIFT);
-		QUADSPI_CCR = ccr;
-		QUADSPI_AR = aOffset;
-
-		do {
-			sr = QUADSPI_SR;
-			if (sr & QUADSPI_SR_TCF) {
-				break;
-			}
-			QUADSPI_BYTE_DR = *aBuffer;
-			aBuffer++;
-		} while (QUADSPI_SR & QUADSPI_SR_BUSY);
-		QUADSPI_FCR = 0x1F;
-
-		// Waiting for process completion
-		do {
-			flashReg = readStatusReg1();
-			if (flashReg == 0xFF) {
-				return false;
-			}
-		} while (flashReg & 0x01);
-
-		return true;
+		return startProgram(aOffset, aBuffer, aLength) && waitForReady();
 	}
 };
 
@@ -0,0 +1,12 @@
+include(Math)
+
+hex2dec(RAM_OFFSET 20000000)
+set(TABLE_SIZE 192)
+
+set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DCONFIG_ROM_PAGE=${ROM_PAGE} -DCONFIG_TABLE_SIZE=${TABLE_SIZE}")
+set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS}" PARENT_SCOPE)
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DCONFIG_ROM_PAGE=${ROM_PAGE} -DCONFIG_TABLE_SIZE=${TABLE_SIZE}")
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS}" PARENT_SCOPE)
+
+# Native executable, no linker script
+set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -pthread" PARENT_SCOPE)
@@ -8,13 +8,15 @@
 #ifndef SOURCES_BASEAPPLICATION_HPP_
 #define SOURCES_BASEAPPLICATION_HPP_
 
+#include <DroneDevice/FirmwareTrailer.hpp>
+#include <DroneDevice/PlatformCrc32.hpp>
 #include <cstddef>
 #include <cstdint>
 
 namespace Dfu {
 
 template<typename T>
-static bool checkFirmware()
+static bool checkVectors()
 {
 	auto contains = [](uintptr_t offset, size_t size, uint32_t address) {
 		return address >= offset && address <= offset + size;
@@ -26,6 +28,65 @@ static bool checkFirmware()
 		&& contains(T::kFirmwareOffset, T::kFirmwareSize, vectors[1]);
 }
 
+template<typename T>
+static const FirmwareTrailer &firmwareTrailer()
+{
+	return *reinterpret_cast<const FirmwareTrailer *>(T::kFirmwareOffset + T::kFirmwareSize - sizeof(FirmwareTrailer));
+}
+
+//!
+//! Check the image against the trailer at the end of the firmware region. The whole image is checked
+//! on cold starts only, the checksum of the verified trailer is cached in the backup registers,
+//! so warm restarts, including fast boot requests, take constant time.
+//! \tparam Crc CRC32 implementation used for the image.
+//!
+template<typename T, typename Crc = PlatformCrc32>
+static bool verifyFirmware()
+{
+	const FirmwareTrailer &trailer = firmwareTrailer<T>();
+
+	if (!checkVectors<T>() || !trailer.isValid(T::kFirmwareSize - sizeof(FirmwareTrailer))) {
+		return false;
+	}
+
+	if (!T::Reloader::isColdStart() && T::Reloader::getImageDigest() == trailer.checksum) {
+		return true;
+	}
+
+	if (!trailer.template verify<Crc>(reinterpret_cast<const void *>(T::kFirmwareOffset))) {
+		T::Reloader::setImageDigest(0);
+		return false;
+	}
+
+	T::Reloader::setImageDigest(trailer.checksum);
+	return true;
+}
+
+//!
+//! Check whether the firmware may be started. Images built with FIRMWARE_TRAILER are verified
+//! against the trailer, otherwise only the vector table is checked.
+//!
+template<typename T, typename Crc = PlatformCrc32>
+static bool checkFirmware()
+{
+#ifdef CONFIG_FIRMWARE_TRAILER
+	return verifyFirmware<T, Crc>();
+#else
+	return checkVectors<T>();
+#endif
+}
+
+//!
+//! Invalidate the cached verification result, should be called before the first write of a new image.
+//! The trailer of the previous image stays valid until the end of the region is erased, a warm restart
+//! in the middle of the update would start a partially written image without the scan otherwise.
+//!
+template<typename T>
+static void beginFirmwareUpdate()
+{
+	T::Reloader::setImageDigest(0);
+}
+
 template<typename T>
 static void startFirmware()
 {
@@ -33,6 +94,7 @@ static void startFirmware()
 	T::Reloader::relocateAndStart(T::kFirmwareOffset, vectors[0], vectors[1]);
 }
 
+// Pool of libcanard, peak usage for a workload is reported by the ArenaSizing host tool
 static constexpr size_t kArenaSize = 2048;
 extern uint8_t arena[kArenaSize];
 
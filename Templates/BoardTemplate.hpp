@@ -8,6 +8,7 @@
 #ifndef BOARD_HPP_
 #define BOARD_HPP_
 
+#include <DroneDevice/InternalDevice/CompressedFile.hpp>
 #include <DroneDevice/MemoryRegion.hpp>
 #include <DroneDevice/Stubs/MockMemoryInterface.hpp>
 
@@ -29,6 +30,9 @@ struct Board {
 	using FirmwareRegion = Device::MemoryRegion<Flash, kFirmwareOffset, kFirmwareSize, true, false>;
 	using SpecRegion = Device::MemoryRegion<Flash, kSpecOffset, kSpecSize, true, false>;
 	using EepromRegion = Device::MemoryRegion<Eeprom, kEepromOffset, kEepromSize, true, true>;
+
+	// Compressed firmware updates, constructed with Dfu::arena as the window
+	using FirmwareFile = Device::CompressedFile<FirmwareRegion>;
 };
 
 #endif // BOARD_HPP_
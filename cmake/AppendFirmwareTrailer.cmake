@@ -0,0 +1,119 @@
+# Fill the .trailer section reserved by the linker script at the end of the firmware region.
+# Layout of the trailer is described in DroneDevice/FirmwareTrailer.hpp.
+#
+# Usage:
+#   cmake -DOBJCOPY=<objcopy> -DFIRMWARE=<file.elf> -DFIRMWARE_SIZE=<dec> -DBUILD_ID=<hex>
+#         -P AppendFirmwareTrailer.cmake
+
+set(TRAILER_SIZE 64)
+set(TRAILER_MAGIC 0x4C525446)
+
+# Convert a number to 8 hexadecimal digits in little-endian byte order
+function(to_le32 _var _value)
+    math(EXPR _padded "(${_value}) + 0x100000000" OUTPUT_FORMAT HEXADECIMAL)
+    string(SUBSTRING "${_padded}" 3 8 _digits)
+    string(REGEX REPLACE "(..)(..)(..)(..)" "\\4\\3\\2\\1" _digits "${_digits}")
+    set(${_var} "${_digits}" PARENT_SCOPE)
+endfunction()
+
+# Same CRC32 as FastCrc32::update() with zero initial value
+function(crc32 _var _data)
+    set(_table)
+    foreach(_index RANGE 255)
+        set(_entry ${_index})
+        foreach(_bit RANGE 7)
+            math(EXPR _entry "(${_entry} >> 1) ^ ((0 - (${_entry} & 1)) & 0xEDB88320)")
+        endforeach()
+        list(APPEND _table ${_entry})
+    endforeach()
+
+    string(REGEX MATCHALL ".." _bytes "${_data}")
+    set(_crc 0xFFFFFFFF)
+
+    foreach(_byte IN LISTS _bytes)
+        math(EXPR _index "(${_crc} ^ 0x${_byte}) & 0xFF")
+        list(GET _table ${_index} _entry)
+        math(EXPR _crc "(${_crc} >> 8) ^ ${_entry}")
+    endforeach()
+
+    math(EXPR _crc "${_crc} ^ 0xFFFFFFFF")
+    set(${_var} ${_crc} PARENT_SCOPE)
+endfunction()
+
+foreach(_required OBJCOPY FIRMWARE FIRMWARE_SIZE BUILD_ID)
+    if(NOT DEFINED ${_required})
+        message(FATAL_ERROR "${_required} is not defined")
+    endif()
+endforeach()
+
+get_filename_component(_directory "${FIRMWARE}" DIRECTORY)
+set(_image "${_directory}/trailer-image.bin")
+set(_record "${_directory}/trailer.hex")
+set(_trailer "${_directory}/trailer.bin")
+
+# Gaps are filled the same way as in the erased flash
+execute_process(COMMAND ${OBJCOPY} -Obinary --gap-fill 0xFF -R .trailer "${FIRMWARE}" "${_image}" RESULT_VARIABLE _result)
+if(NOT _result EQUAL 0)
+    message(FATAL_ERROR "Failed to extract the image from ${FIRMWARE}")
+endif()
+
+file(READ "${_image}" _data HEX)
+file(SHA256 "${_image}" _digest)
+string(LENGTH "${_data}" _length)
+math(EXPR _length "${_length} / 2")
+math(EXPR _capacity "${FIRMWARE_SIZE} - ${TRAILER_SIZE}")
+
+if(_length GREATER _capacity)
+    message(FATAL_ERROR "Image of ${_length} bytes leaves no space for the firmware trailer")
+endif()
+
+crc32(_crc "${_data}")
+
+to_le32(_magic ${TRAILER_MAGIC})
+to_le32(_size ${_length})
+to_le32(_build 0x${BUILD_ID})
+to_le32(_image_crc ${_crc})
+set(_fields "${_magic}${_size}${_build}${_image_crc}${_digest}FFFFFFFFFFFFFFFFFFFFFFFF")
+
+crc32(_checksum "${_fields}")
+to_le32(_checksum ${_checksum})
+string(TOUPPER "${_fields}${_checksum}" _fields)
+
+# Trailer bytes are passed to objcopy as an Intel HEX file of 16-byte records
+set(_text "")
+foreach(_position RANGE 0 48 16)
+    math(EXPR _offset "${_position} * 2")
+    string(SUBSTRING "${_fields}" ${_offset} 32 _line)
+    math(EXPR _address "${_position} + 0x10000" OUTPUT_FORMAT HEXADECIMAL)
+    string(SUBSTRING "${_address}" 3 4 _address)
+    string(REGEX MATCHALL ".." _bytes "10${_address}00${_line}")
+    set(_sum 0)
+    foreach(_byte IN LISTS _bytes)
+        math(EXPR _sum "${_sum} + 0x${_byte}")
+    endforeach()
+    math(EXPR _sum "((0x100 - (${_sum} & 0xFF)) & 0xFF) + 0x100" OUTPUT_FORMAT HEXADECIMAL)
+    string(SUBSTRING "${_sum}" 3 2 _sum)
+    string(TOUPPER "${_sum}" _sum)
+    string(APPEND _text ":10${_address}00${_line}${_sum}\n")
+endforeach()
+string(APPEND _text ":00000001FF\n")
+file(WRITE "${_record}" "${_text}")
+
+execute_process(COMMAND ${OBJCOPY} -Iihex -Obinary "${_record}" "${_trailer}" RESULT_VARIABLE _result)
+if(_result EQUAL 0)
+    # The section is empty in the linker output, it gets contents and stays in its segment
+    execute_process(
+        COMMAND ${OBJCOPY}
+            --set-section-flags .trailer=alloc,contents,load,readonly,data
+            --update-section .trailer=${_trailer}
+            "${FIRMWARE}"
+        RESULT_VARIABLE _result
+    )
+endif()
+if(NOT _result EQUAL 0)
+    message(FATAL_ERROR "Failed to fill the .trailer section of ${FIRMWARE}")
+endif()
+
+file(REMOVE "${_image}" "${_record}" "${_trailer}")
+math(EXPR _crc "${_crc}" OUTPUT_FORMAT HEXADECIMAL)
+message(STATUS "Firmware trailer: ${_length} bytes, CRC32 ${_crc}, build ${BUILD_ID}")